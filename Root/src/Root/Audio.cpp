@@ -9,10 +9,50 @@ namespace Audio
 		AudioEngine::loadSound(path, name);
 	}
 
+	void loadStreamedSound(const std::string& path, const std::string& name)
+	{
+		AudioEngine::loadStreamedSound(path, name);
+	}
+
+	void loadSoundBank(const std::string& path)
+	{
+		AudioEngine::loadSoundBank(path);
+	}
+
+	bool cookSoundBank(const std::vector<SoundBankClip>& clips, const std::string& bankPath)
+	{
+		return AudioEngine::cookSoundBank(clips, bankPath);
+	}
+
 	void playSound(const std::string& name)
+	{
+		AudioEngine::playSound(StringInterner::intern(name));
+	}
+
+	void playSound(StringID name)
 	{
 		AudioEngine::playSound(name);
 	}
+
+	void setSoundPriority(const std::string& name, int priority)
+	{
+		AudioEngine::setSoundPriority(StringInterner::intern(name), priority);
+	}
+
+	void setSoundInstanceLimit(const std::string& name, unsigned int maxInstances)
+	{
+		AudioEngine::setSoundInstanceLimit(StringInterner::intern(name), maxInstances);
+	}
+
+	void setSoundCooldown(const std::string& name, float cooldown)
+	{
+		AudioEngine::setSoundCooldown(StringInterner::intern(name), cooldown);
+	}
+
+	void setEmitterGainThreshold(float threshold)
+	{
+		AudioEngine::setEmitterGainThreshold(threshold);
+	}
 };
 
 
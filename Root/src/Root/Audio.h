@@ -2,6 +2,10 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+
+#include <Root/StringID.h>
+#include <Root/SoundBank.h>
 
 namespace Audio
 {
@@ -11,9 +15,67 @@ namespace Audio
 	 */
 	void loadSound(const std::string& path, const std::string& name);
 
+	/**
+	 * Load a sound that is streamed from its file while it plays.
+	 * Use this for long sounds like music: only a fraction of a second of it is kept in memory.
+	 * Only WAV files can be streamed.
+	 * The sound will be saved under the given name, which it can be identified by later.
+	 */
+	void loadStreamedSound(const std::string& path, const std::string& name);
+
+	/**
+	 * Load all sounds in a sound bank, which is much faster than loading them one by one.
+	 * The sounds are uploaded on a background thread and can be played a few frames later.
+	 * Calling loadSound() with the name of a sound in the bank waits for the bank instead of decoding the file.
+	 */
+	void loadSoundBank(const std::string& path);
+
+	/**
+	 * Pack sounds into a sound bank file, which can be loaded with loadSoundBank().
+	 * Only needs to be done again when the sounds change.
+	 *
+	 * \param clips: the paths of the sounds and the names to load them under.
+	 * \param bankPath: the path of the sound bank file to write.
+	 * \returns whether the bank was written.
+	 */
+	bool cookSoundBank(const std::vector<SoundBankClip>& clips, const std::string& bankPath);
+
 	/**
 	 * Play a specific loaded sound.
 	 * The sound must already be loaded.
 	 */
 	void playSound(const std::string& name);
+
+	/**
+	 * Play a specific loaded sound by its interned name.
+	 * The sound must already be loaded.
+	 */
+	void playSound(StringID name);
+
+	/**
+	 * Set how important a loaded sound is, 0 by default.
+	 * Sounds are played on a fixed number of voices. When all of them are playing,
+	 * playSound() takes over the oldest voice playing the least important sound,
+	 * unless every voice plays a more important sound, in which case the new sound is not played.
+	 */
+	void setSoundPriority(const std::string& name, int priority);
+
+	/**
+	 * Set how many instances of a loaded sound can play at the same time, 0 (no limit) by default.
+	 * When the limit is reached, playSound() restarts the oldest instance of the sound.
+	 */
+	void setSoundInstanceLimit(const std::string& name, unsigned int maxInstances);
+
+	/**
+	 * Set the number of seconds after a loaded sound is played in which playSound() ignores it, 0 by default.
+	 */
+	void setSoundCooldown(const std::string& name, float cooldown);
+
+	/**
+	 * Set the gain below which audio emitters are virtual: they keep track of their sound without playing it.
+	 * Raising it frees up voices, lowering it lets quieter emitters be heard.
+	 *
+	 * \param threshold: the gain, 0.01 by default.
+	 */
+	void setEmitterGainThreshold(float threshold);
 };
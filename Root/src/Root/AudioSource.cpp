@@ -1,11 +1,12 @@
 #include "AudioSource.h"
 
+#include <Root/AudioStream.h>
 #include <Root/engine/AudioEngine.h>
 
 AudioSource::AudioSource()
 {
 	alGenSources(1, &sourceID);
-	alSource3f(sourceID, AL_POSITION, 1.f, 0.f, 0.f);
+	alSource3f(sourceID, AL_POSITION, 0.f, 0.f, 0.f);
 	alSource3f(sourceID, AL_VELOCITY, 0.f, 0.f, 0.f);
 	alSourcef(sourceID, AL_PITCH, 1.f);
 	alSourcef(sourceID, AL_GAIN, 1.f);
@@ -13,6 +14,11 @@ AudioSource::AudioSource()
 }
 
 AudioSource::AudioSource(const std::string& name)
+	: AudioSource(StringInterner::intern(name))
+{
+}
+
+AudioSource::AudioSource(StringID name)
 {
 	alGenSources(1, &sourceID);
 	alSource3f(sourceID, AL_POSITION, 0.f, 0.f, 0.f);
@@ -27,28 +33,63 @@ AudioSource::AudioSource(const std::string& name)
 AudioSource::~AudioSource()
 {
 	Logger::destructorMessage("Audio source");
+
+	// The stream uses the source, so it must be deleted first
+	stream.reset();
 	alDeleteSources(1, &sourceID);
 }
 
 void AudioSource::play()
 {
-	alSourcePlay(sourceID);
+	if (stream)
+		stream->play();
+	else
+		alSourcePlay(sourceID);
 }
 
 void AudioSource::pause()
 {
-	alSourcePause(sourceID);
+	if (stream)
+		stream->pause();
+	else
+		alSourcePause(sourceID);
 }
 
 void AudioSource::stop()
 {
-	alSourceStop(sourceID);
+	if (stream)
+		stream->stop();
+	else
+		alSourceStop(sourceID);
 }
 
 void AudioSource::setAudioClip(const std::string& name)
 {
+	setAudioClip(StringInterner::intern(name));
+}
+
+void AudioSource::setAudioClip(StringID name)
+{
+	// Removing the previous clip, which also removes the buffers of a previous stream
+	stream.reset();
+	alSourceStop(sourceID);
+
+	const std::string* streamedPath{ AudioEngine::findStreamedSoundPath(name) };
+	if (streamedPath != nullptr)
+	{
+		alSourcei(sourceID, AL_BUFFER, 0);
+		// The stream loops by queueing the start after the end, the source itself must not loop
+		alSourcei(sourceID, AL_LOOPING, AL_FALSE);
+
+		stream = AudioStream::create(*streamedPath, sourceID);
+		if (stream)
+			stream->setLooping(onFinishAudio == OnFinishAudio::LOOP);
+		return;
+	}
+
 	unsigned int buffer{ AudioEngine::findBufferByName(name) };
 	alSourcei(sourceID, AL_BUFFER, buffer);
+	alSourcei(sourceID, AL_LOOPING, onFinishAudio == OnFinishAudio::LOOP);
 }
 
 void AudioSource::setGain(float gain)
@@ -61,8 +102,35 @@ void AudioSource::setPitch(float pitch)
 	alSourcef(sourceID, AL_PITCH, pitch);
 }
 
+void AudioSource::setPlaybackPosition(float seconds)
+{
+	if (stream)
+		stream->setPlaybackPosition(seconds);
+	else
+		alSourcef(sourceID, AL_SEC_OFFSET, seconds);
+}
+
+float AudioSource::getPlaybackPosition()
+{
+	if (stream)
+		return stream->getPlaybackPosition();
+
+	ALfloat seconds;
+	alGetSourcef(sourceID, AL_SEC_OFFSET, &seconds);
+	return seconds;
+}
+
+bool AudioSource::isStreamed() const
+{
+	return stream != nullptr;
+}
+
 bool AudioSource::isDone()
 {
+	// A stream also stops when it runs out of buffers for a moment, so only the stream knows whether it ended
+	if (stream)
+		return onFinishAudio == OnFinishAudio::DESTROY_SELF && stream->isFinished();
+
 	ALint sourceState;
 	alGetSourcei(sourceID, AL_SOURCE_STATE, &sourceState);
 	return onFinishAudio == OnFinishAudio::DESTROY_SELF && sourceState == AL_STOPPED;
@@ -72,5 +140,8 @@ void AudioSource::setOnFinishAudio(OnFinishAudio onFinishAudio)
 {
 	this->onFinishAudio = onFinishAudio;
 
-	alSourcei(sourceID, AL_LOOPING, onFinishAudio == OnFinishAudio::LOOP);
+	if (stream)
+		stream->setLooping(onFinishAudio == OnFinishAudio::LOOP);
+	else
+		alSourcei(sourceID, AL_LOOPING, onFinishAudio == OnFinishAudio::LOOP);
 }
@@ -3,7 +3,12 @@
 #include <AL/al.h>
 #include <AL/alc.h>
 
+#include <Root/StringID.h>
+
 #include <string>
+#include <memory>
+
+class AudioStream;
 
 enum class OnFinishAudio
 {
@@ -23,6 +28,13 @@ public:
 	 * \param name: the name of the audio clip that this audio source will play.
 	 */
 	AudioSource(const std::string& name);
+
+	/**
+	 * Create a new audio source.
+	 *
+	 * \param name: the interned name of the audio clip that this audio source will play.
+	 */
+	AudioSource(StringID name);
 	~AudioSource();
 
 	/**
@@ -42,11 +54,19 @@ public:
 
 	/**
 	 * Set the audio clip that this source plays.
+	 * Clips loaded with Audio::loadStreamedSound() are streamed from their file while they play.
 	 * 
 	 * \param name: the name of the audio clip that this audio source will play.
 	 */
 	void setAudioClip(const std::string& name);
 
+	/**
+	 * Set the audio clip that this source plays.
+	 *
+	 * \param name: the interned name of the audio clip that this audio source will play.
+	 */
+	void setAudioClip(StringID name);
+
 	/**
 	 * Set the gain of this audio source.
 	 * 
@@ -61,6 +81,27 @@ public:
 	 */
 	void setPitch(float pitch);
 
+	/**
+	 * Continue playing the audio clip from the given time.
+	 *
+	 * \param seconds: the time since the start of the audio clip.
+	 */
+	void setPlaybackPosition(float seconds);
+
+	/**
+	 * Get the time in the audio clip that is currently playing.
+	 *
+	 * \return the time since the start of the audio clip, in seconds.
+	 */
+	float getPlaybackPosition();
+
+	/**
+	 * Get whether the audio clip is streamed from its file.
+	 *
+	 * \return whether the audio clip is streamed.
+	 */
+	bool isStreamed() const;
+
 	/**
 	 * Get whether this audio source is done.
 	 * Only happens when the audio clip has finished playing
@@ -82,4 +123,7 @@ private:
 	OnFinishAudio onFinishAudio{ OnFinishAudio::PAUSE };
 
 	unsigned int sourceID{ 0 };
+
+	// Only set when playing a streamed audio clip
+	std::unique_ptr<AudioStream> stream;
 };
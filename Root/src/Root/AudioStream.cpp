@@ -0,0 +1,401 @@
+#include "AudioStream.h"
+
+#include <Root/engine/AudioEngine.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	// About a third of a second at 44.1kHz, so four buffers cover more than a second of hiccups
+	const std::uint64_t framesPerBuffer{ 16384 };
+
+	const std::uint16_t WAVE_FORMAT_PCM{ 1 };
+	const std::uint16_t WAVE_FORMAT_IEEE_FLOAT{ 3 };
+	const std::uint16_t WAVE_FORMAT_EXTENSIBLE{ 0xFFFE };
+
+	template<typename T>
+	T readLittleEndian(const char* data)
+	{
+		T value;
+		std::memcpy(&value, data, sizeof(T));
+		return value;
+	}
+
+	bool readChunkHeader(std::ifstream& file, char id[4], std::uint32_t& size)
+	{
+		char header[8];
+		if (!file.read(header, sizeof(header)))
+			return false;
+
+		std::memcpy(id, header, 4);
+		size = readLittleEndian<std::uint32_t>(header + 4);
+		return true;
+	}
+
+	std::int16_t convertSample(const char* sample, std::uint16_t formatTag, std::uint16_t bitsPerSample)
+	{
+		if (formatTag == WAVE_FORMAT_IEEE_FLOAT)
+		{
+			float value{ std::clamp(readLittleEndian<float>(sample), -1.0f, 1.0f) };
+			return static_cast<std::int16_t>(value * 32767.0f);
+		}
+
+		// Only keeping the most significant 16 bits of larger integer samples
+		return readLittleEndian<std::int16_t>(sample + bitsPerSample / 8 - 2);
+	}
+}
+
+std::unique_ptr<AudioStream> AudioStream::create(const std::string& path, unsigned int sourceID)
+{
+	std::unique_ptr<AudioStream> stream{ new AudioStream(sourceID) };
+
+	if (!stream->open(path))
+		return nullptr;
+
+	alGenBuffers(bufferCount, stream->buffers);
+	stream->freeBuffers.assign(stream->buffers, stream->buffers + bufferCount);
+
+	AudioEngine::registerStream(stream.get());
+
+	return stream;
+}
+
+bool AudioStream::canStream(const std::string& path)
+{
+	AudioStream stream{ 0 };
+	return stream.open(path);
+}
+
+AudioStream::AudioStream(unsigned int sourceID)
+	: sourceID(sourceID)
+{
+}
+
+AudioStream::~AudioStream()
+{
+	// Streams that were only opened to check the file have no buffers
+	if (buffers[0] == 0)
+		return;
+
+	// Making sure the streaming thread is not using this stream
+	AudioEngine::unregisterStream(this);
+
+	alSourceStop(sourceID);
+	clearQueue();
+	alDeleteBuffers(bufferCount, buffers);
+}
+
+bool AudioStream::open(const std::string& path)
+{
+	file.open(path, std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		Logger::logError("AudioStream: Failed to open sound at " + path);
+		return false;
+	}
+
+	char id[4];
+	std::uint32_t size;
+	char wave[4];
+	if (!readChunkHeader(file, id, size) || std::memcmp(id, "RIFF", 4) != 0
+		|| !file.read(wave, 4) || std::memcmp(wave, "WAVE", 4) != 0)
+	{
+		Logger::logError("AudioStream: Only WAV files can be streamed, which " + path + " is not.");
+		return false;
+	}
+
+	bool foundFormat{ false };
+
+	while (readChunkHeader(file, id, size))
+	{
+		if (std::memcmp(id, "fmt ", 4) == 0 && size >= 16)
+		{
+			std::vector<char> chunk(size);
+			if (!file.read(chunk.data(), size))
+				break;
+
+			formatTag = readLittleEndian<std::uint16_t>(chunk.data());
+			channelCount = readLittleEndian<std::uint16_t>(chunk.data() + 2);
+			sampleRate = readLittleEndian<std::uint32_t>(chunk.data() + 4);
+			blockAlign = readLittleEndian<std::uint16_t>(chunk.data() + 12);
+			bitsPerSample = readLittleEndian<std::uint16_t>(chunk.data() + 14);
+
+			// The actual format is at the start of the sub format GUID
+			if (formatTag == WAVE_FORMAT_EXTENSIBLE && size >= 26)
+				formatTag = readLittleEndian<std::uint16_t>(chunk.data() + 24);
+
+			foundFormat = true;
+
+			// Chunks are padded to an even size
+			if (size % 2 == 1)
+				file.seekg(1, std::ios::cur);
+		}
+		else if (std::memcmp(id, "data", 4) == 0)
+		{
+			if (!foundFormat)
+				break;
+
+			dataStart = file.tellg();
+			frameCount = blockAlign == 0 ? 0 : size / blockAlign;
+			break;
+		}
+		else
+		{
+			file.seekg(size + size % 2, std::ios::cur);
+		}
+	}
+
+	if (!foundFormat || frameCount == 0)
+	{
+		Logger::logError("AudioStream: Could not find the samples in " + path);
+		return false;
+	}
+
+	bool supportedFormat{
+		(formatTag == WAVE_FORMAT_PCM && (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32))
+		|| (formatTag == WAVE_FORMAT_IEEE_FLOAT && bitsPerSample == 32) };
+
+	if (!supportedFormat || (channelCount != 1 && channelCount != 2) || blockAlign != channelCount * bitsPerSample / 8)
+	{
+		Logger::logError("AudioStream: The sample format of " + path + " is not supported.");
+		return false;
+	}
+
+	// 8 and 16 bit samples are given to OpenAL as they are, the rest is converted to 16 bit
+	if (bitsPerSample == 8)
+		format = channelCount == 2 ? AL_FORMAT_STEREO8 : AL_FORMAT_MONO8;
+	else
+		format = channelCount == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+
+	fileData.resize(framesPerBuffer * blockAlign);
+	if (bitsPerSample > 16)
+		convertedData.resize(framesPerBuffer * channelCount);
+
+	return true;
+}
+
+void AudioStream::play()
+{
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+
+		if (finished)
+		{
+			seekFrame(0);
+			finished = false;
+		}
+
+		// Only decoding one chunk here, the streaming thread decodes the rest
+		if (queuedCount == 0 && !freeBuffers.empty())
+		{
+			ALuint buffer{ freeBuffers.back() };
+			if (queueNextChunk(buffer))
+				freeBuffers.pop_back();
+		}
+
+		playing = true;
+		alSourcePlay(sourceID);
+	}
+
+	AudioEngine::wakeStreamingThread();
+}
+
+void AudioStream::pause()
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+
+	playing = false;
+	alSourcePause(sourceID);
+}
+
+void AudioStream::stop()
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+
+	playing = false;
+	finished = false;
+	alSourceStop(sourceID);
+	clearQueue();
+	seekFrame(0);
+}
+
+void AudioStream::setLooping(bool looping)
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+
+	this->looping = looping;
+}
+
+void AudioStream::setPlaybackPosition(float seconds)
+{
+	bool wasPlaying;
+
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+
+		std::uint64_t frame{ static_cast<std::uint64_t>(std::max(seconds, 0.0f) * sampleRate) };
+
+		alSourceStop(sourceID);
+		clearQueue();
+		seekFrame(std::min(frame, frameCount - 1));
+		finished = false;
+		wasPlaying = playing;
+	}
+
+	// Decoding on the streaming thread, which starts the stopped source again once its buffers are queued
+	if (wasPlaying)
+		AudioEngine::wakeStreamingThread();
+}
+
+float AudioStream::getPlaybackPosition()
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+
+	if (queuedCount == 0)
+		return static_cast<float>(nextFrame) / sampleRate;
+
+	// The offset is from the start of the first buffer that is still queued
+	ALint sampleOffset;
+	alGetSourcei(sourceID, AL_SAMPLE_OFFSET, &sampleOffset);
+
+	std::uint64_t frame{ (queuedStartFrames[firstQueued] + static_cast<std::uint64_t>(sampleOffset)) % frameCount };
+	return static_cast<float>(frame) / sampleRate;
+}
+
+float AudioStream::getLength() const
+{
+	return static_cast<float>(frameCount) / sampleRate;
+}
+
+bool AudioStream::isFinished()
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+
+	return finished;
+}
+
+void AudioStream::update()
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+
+	if (!playing)
+		return;
+
+	// Getting the state first: if the source stops after this, the buffers it finished are still unqueued below
+	ALint state;
+	alGetSourcei(sourceID, AL_SOURCE_STATE, &state);
+
+	ALint processed;
+	alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed);
+
+	for (ALint i{ 0 }; i < processed; i++)
+	{
+		ALuint buffer;
+		alSourceUnqueueBuffers(sourceID, 1, &buffer);
+
+		firstQueued = (firstQueued + 1) % bufferCount;
+		queuedCount--;
+		freeBuffers.push_back(buffer);
+	}
+
+	fillFreeBuffers();
+
+	if (queuedCount == 0)
+	{
+		// Everything was played
+		playing = false;
+		finished = true;
+		return;
+	}
+
+	// The source stops by itself when it runs out of buffers before they were refilled
+	if (state != AL_PLAYING)
+		alSourcePlay(sourceID);
+}
+
+bool AudioStream::queueNextChunk(ALuint buffer)
+{
+	std::uint64_t startFrame{ nextFrame };
+	std::uint64_t decodedFrames{ 0 };
+
+	while (decodedFrames < framesPerBuffer)
+	{
+		if (nextFrame >= frameCount)
+		{
+			if (!looping)
+				break;
+
+			// Continuing with the start of the file in the same buffer, so there is no gap
+			seekFrame(0);
+		}
+
+		std::uint64_t frames{ std::min(framesPerBuffer - decodedFrames, frameCount - nextFrame) };
+		if (!file.read(fileData.data() + decodedFrames * blockAlign, frames * blockAlign))
+		{
+			file.clear();
+			Logger::logError("AudioStream: Failed to read samples.");
+			break;
+		}
+
+		decodedFrames += frames;
+		nextFrame += frames;
+	}
+
+	if (decodedFrames == 0)
+		return false;
+
+	const void* data{ fileData.data() };
+	std::size_t dataSize{ decodedFrames * blockAlign };
+
+	if (bitsPerSample > 16)
+	{
+		std::size_t sampleCount{ decodedFrames * channelCount };
+		std::size_t bytesPerSample{ bitsPerSample / 8u };
+
+		for (std::size_t i{ 0 }; i < sampleCount; i++)
+		{
+			convertedData[i] = convertSample(fileData.data() + i * bytesPerSample, formatTag, bitsPerSample);
+		}
+
+		data = convertedData.data();
+		dataSize = sampleCount * sizeof(std::int16_t);
+	}
+
+	alBufferData(buffer, format, data, static_cast<ALsizei>(dataSize), static_cast<ALsizei>(sampleRate));
+	alSourceQueueBuffers(sourceID, 1, &buffer);
+
+	queuedStartFrames[(firstQueued + queuedCount) % bufferCount] = startFrame;
+	queuedCount++;
+
+	return true;
+}
+
+void AudioStream::fillFreeBuffers()
+{
+	while (!freeBuffers.empty())
+	{
+		if (!queueNextChunk(freeBuffers.back()))
+			return;
+
+		freeBuffers.pop_back();
+	}
+}
+
+void AudioStream::clearQueue()
+{
+	// Removes all buffers from a stopped source
+	alSourcei(sourceID, AL_BUFFER, 0);
+
+	freeBuffers.assign(buffers, buffers + bufferCount);
+
+	firstQueued = 0;
+	queuedCount = 0;
+}
+
+void AudioStream::seekFrame(std::uint64_t frame)
+{
+	nextFrame = frame;
+	file.clear();
+	file.seekg(dataStart + static_cast<std::streamoff>(frame * blockAlign));
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <AL/al.h>
+
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * Plays a WAV file on an OpenAL source without loading all of it.
+ * The file is decoded a chunk at a time into a few buffers that are queued on the source,
+ * and buffers that finished playing are refilled by the audio streaming thread.
+ * This keeps the memory used by a stream the same no matter how long the file is.
+ */
+class AudioStream
+{
+public:
+	/**
+	 * Open a stream of a WAV file.
+	 * Supports 8, 16, 24 and 32 bit PCM and 32 bit float samples, in mono or stereo.
+	 *
+	 * \param path: the path of the WAV file.
+	 * \param sourceID: the OpenAL source to play the stream on. Must not be deleted before the stream.
+	 * \returns the stream, or nullptr if the file could not be opened.
+	 */
+	static std::unique_ptr<AudioStream> create(const std::string& path, unsigned int sourceID);
+
+	/**
+	 * Check whether a file can be streamed.
+	 *
+	 * \param path: the path of the file.
+	 * \returns whether the file is a WAV file that can be streamed.
+	 */
+	static bool canStream(const std::string& path);
+
+	~AudioStream();
+
+	AudioStream(const AudioStream&) = delete;
+	AudioStream& operator=(const AudioStream&) = delete;
+
+	void play();
+	void pause();
+
+	/**
+	 * Stop the stream and go back to the start.
+	 */
+	void stop();
+
+	/**
+	 * Set whether the stream starts over when it ends.
+	 * The start is queued right after the end, so there is no gap between them.
+	 */
+	void setLooping(bool looping);
+
+	/**
+	 * Continue playing from the given time.
+	 *
+	 * \param seconds: the time since the start of the file.
+	 */
+	void setPlaybackPosition(float seconds);
+
+	/**
+	 * Get the time that is currently playing.
+	 *
+	 * \returns the time since the start of the file, in seconds.
+	 */
+	float getPlaybackPosition();
+
+	/**
+	 * Get the length of the file.
+	 *
+	 * \returns the length in seconds.
+	 */
+	float getLength() const;
+
+	/**
+	 * Get whether the stream played until the end, without looping.
+	 *
+	 * \returns whether the stream finished.
+	 */
+	bool isFinished();
+
+	/**
+	 * Refill the buffers that finished playing.
+	 * Called regularly by the audio streaming thread.
+	 */
+	void update();
+
+private:
+	AudioStream(unsigned int sourceID);
+
+	// Reads the WAV header and finds the sample data
+	bool open(const std::string& path);
+
+	// Decodes the next chunk into the given buffer and queues it, returns false if the file ended
+	bool queueNextChunk(ALuint buffer);
+	// Queues chunks into all buffers that are not queued
+	void fillFreeBuffers();
+	// Removes all buffers from the source, which must be stopped
+	void clearQueue();
+	void seekFrame(std::uint64_t frame);
+
+	// Locked by the functions above that are called from other threads
+	std::mutex mutex;
+
+	unsigned int sourceID;
+
+	std::ifstream file;
+	std::streampos dataStart;
+	std::uint16_t formatTag{ 0 };
+	std::uint16_t channelCount{ 0 };
+	std::uint16_t bitsPerSample{ 0 };
+	std::uint16_t blockAlign{ 0 };
+	std::uint32_t sampleRate{ 0 };
+	std::uint64_t frameCount{ 0 };
+	ALenum format{ AL_NONE };
+
+	// The next frame that will be decoded
+	std::uint64_t nextFrame{ 0 };
+
+	static const unsigned int bufferCount{ 4 };
+	ALuint buffers[bufferCount]{};
+	std::vector<ALuint> freeBuffers;
+	// The first frame of each queued buffer, in the order they were queued
+	std::uint64_t queuedStartFrames[bufferCount]{};
+	unsigned int firstQueued{ 0 };
+	unsigned int queuedCount{ 0 };
+
+	// Kept between chunks so decoding does not allocate
+	std::vector<char> fileData;
+	std::vector<std::int16_t> convertedData;
+
+	bool looping{ false };
+	bool playing{ false };
+	bool finished{ false };
+};
@@ -1,76 +1,170 @@
 #include "CollisionCallbackHandler.h"
 
 #include <Root/Transform.h>
+#include <Root/StringID.h>
 
 void CollisionCallbackHandler::BeginContact(b2Contact* contact)
 {
-	if (contactListener == nullptr)
-		return;
+	recordEvent(contact, CollisionEventType::BEGIN);
+}
+
+void CollisionCallbackHandler::EndContact(b2Contact* contact)
+{
+	recordEvent(contact, CollisionEventType::END);
+}
+
+bool CollisionCallbackHandler::recordEvent(b2Contact* contact, CollisionEventType type)
+{
+	// Nobody would receive the event
+	if (contactListener == nullptr && layerListeners.empty())
+		return false;
+
+	b2Fixture* fixture1{ contact->GetFixtureA() };
+	b2Fixture* fixture2{ contact->GetFixtureB() };
 
-	// Retrieving both rigidbodies
-	FixtureData* fixtureData1{ reinterpret_cast<FixtureData*>(contact->GetFixtureA()->GetUserData().pointer) };
-	FixtureData* fixtureData2{ reinterpret_cast<FixtureData*>(contact->GetFixtureB()->GetUserData().pointer) };
+	// Retrieving both fixture datas
+	FixtureData* fixtureData1{ reinterpret_cast<FixtureData*>(fixture1->GetUserData().pointer) };
+	FixtureData* fixtureData2{ reinterpret_cast<FixtureData*>(fixture2->GetUserData().pointer) };
 
 	// Either one of the rigidbodies is destroyed
 	if (fixtureData1 == nullptr || fixtureData2 == nullptr)
-		return;
+		return false;
 
 	Rigidbody* rb1{ fixtureData1->rigidbody };
 	Rigidbody* rb2{ fixtureData2->rigidbody };
 
 	// Either one of the rigidbodies is destroyed
 	if (rb1 == nullptr || rb2 == nullptr || rb1->getTransform() == nullptr || rb2->getTransform() == nullptr)
-		return;
+		return false;
+
+	CollisionEvent event{};
+	event.type = type;
+	event.sensor = fixture1->IsSensor() || fixture2->IsSensor();
+
+	// Only touching contacts have a meaningful contact point
+	if (type == CollisionEventType::BEGIN && contact->GetManifold()->pointCount > 0)
+	{
+		b2WorldManifold worldManifold;
+		contact->GetWorldManifold(&worldManifold);
+		event.point = glm::vec2(worldManifold.points[0].x, worldManifold.points[0].y);
+		event.normal = glm::vec2(worldManifold.normal.x, worldManifold.normal.y);
+	}
 
 	// Check for tag order:
+	// equal tags have equal IDs, so the strings only need to be compared if the IDs differ.
 	// compare() returns a negative value if the first char that doesn't match is less
-	if (rb2->getTransform()->getTag().compare(rb1->getTransform()->getTag()) < 0)
+	StringID tag1{ rb1->getTransform()->getTagID() };
+	StringID tag2{ rb2->getTransform()->getTagID() };
+	if (tag1 != tag2 && StringInterner::lookup(tag2).compare(StringInterner::lookup(tag1)) < 0)
 	{
 		// Swapping the order if the tags are 
-		Rigidbody* temp = rb2;
-		rb2 = rb1;
-		rb1 = temp;
+		std::swap(rb1, rb2);
+		std::swap(fixture1, fixture2);
+
+		// The normal points from A to B, so it must be flipped as well
+		event.normal = -event.normal;
 	}
 
-	// Call the user-defined callback
-	contactListener->BeginContact(contact, rb1, rb2);
+	event.rigidbody1 = rb1->getHandle();
+	event.rigidbody2 = rb2->getHandle();
+	event.layer1 = fixture1->GetFilterData().categoryBits;
+	event.layer2 = fixture2->GetFilterData().categoryBits;
+
+	// Only this world's thread records into its buffer
+	getWorldEvents(fixture1->GetBody()->GetWorld()).events.push_back(event);
+	return true;
 }
 
-void CollisionCallbackHandler::EndContact(b2Contact* contact)
+CollisionCallbackHandler::WorldEvents& CollisionCallbackHandler::getWorldEvents(const b2World* world)
 {
-	if (contactListener == nullptr)
-		return;
+	// There are only a few worlds, so a linear search is fastest
+	for (WorldEvents& buffer : worldEvents)
+	{
+		if (buffer.world == world)
+			return buffer;
+	}
 
-	// Retrieving both rigidbodies
-	FixtureData* fixtureData1{ reinterpret_cast<FixtureData*>(contact->GetFixtureA()->GetUserData().pointer) };
-	FixtureData* fixtureData2{ reinterpret_cast<FixtureData*>(contact->GetFixtureB()->GetUserData().pointer) };
+	Logger::logError("Collision events were recorded in a world that was not added to the collision callback handler.");
+	addWorld(world);
+	return worldEvents.back();
+}
 
-	// Either one of the rigidbodies is destroyed
-	if (fixtureData1 == nullptr || fixtureData2 == nullptr)
-		return;
+void CollisionCallbackHandler::dispatchEvents()
+{
+	// Moving the events out so that listeners can cause new events (e.g. by moving bodies) while dispatching
+	dispatchingEvents.clear();
+	for (WorldEvents& buffer : worldEvents)
+	{
+		dispatchingEvents.insert(dispatchingEvents.end(), buffer.events.begin(), buffer.events.end());
+		buffer.events.clear();
+	}
 
-	Rigidbody* rb1{ fixtureData1->rigidbody };
-	Rigidbody* rb2{ fixtureData2->rigidbody };
+	for (CollisionEvent& event : dispatchingEvents)
+	{
+		// A previous callback may have destroyed one of the rigidbodies
+		if (!event.rigidbody1.isValid() || !event.rigidbody2.isValid())
+			continue;
+
+		if (contactListener != nullptr)
+		{
+			if (event.type == CollisionEventType::BEGIN)
+				contactListener->BeginContact(event);
+			else
+				contactListener->EndContact(event);
+		}
+
+		for (unsigned int i{ 0 }; i < layerListeners.size(); i++)
+		{
+			LayerCollisionListener layerListener{ layerListeners[i] };
+
+			if (((event.layer1 | event.layer2) & layerListener.layers) == 0)
+				continue;
+
+			if (event.type == CollisionEventType::BEGIN)
+				layerListener.listener->BeginContact(event);
+			else
+				layerListener.listener->EndContact(event);
+		}
+	}
 
-	// Either one of the rigidbodies is destroyed
-	if (rb1 == nullptr || rb2 == nullptr || rb1->getTransform() == nullptr || rb2->getTransform() == nullptr)
-		return;
+	dispatchingEvents.clear();
+}
 
-	// Check for tag order:
-	// compare() returns a negative value if the first char that doesn't match is less
-	if (rb2->getTransform()->getTag().compare(rb1->getTransform()->getTag()) < 0)
+std::vector<CollisionEvent>& CollisionCallbackHandler::getEvents(const b2World* world)
+{
+	return getWorldEvents(world).events;
+}
+
+void CollisionCallbackHandler::addWorld(const b2World* world)
+{
+	for (WorldEvents& buffer : worldEvents)
 	{
-		// Swapping the order if the tags are 
-		Rigidbody* temp = rb2;
-		rb2 = rb1;
-		rb1 = temp;
+		if (buffer.world == world)
+			return;
 	}
 
-	// Call the user-defined callback
-	contactListener->EndContact(contact, rb1, rb2);
+	worldEvents.push_back(WorldEvents{ world, std::vector<CollisionEvent>{} });
 }
 
 void CollisionCallbackHandler::setCollisionListener(CollisionListener* contactListener)
 {
 	this->contactListener = contactListener;
 }
+
+void CollisionCallbackHandler::addLayerCollisionListener(LayerMask layers, CollisionListener* listener)
+{
+	layerListeners.push_back(LayerCollisionListener{ layers, listener });
+}
+
+bool CollisionCallbackHandler::removeLayerCollisionListener(CollisionListener* listener)
+{
+	for (unsigned int i{ 0 }; i < layerListeners.size(); i++)
+	{
+		if (layerListeners[i].listener == listener)
+		{
+			layerListeners.erase(layerListeners.begin() + i);
+			return true;
+		}
+	}
+	return false;
+}
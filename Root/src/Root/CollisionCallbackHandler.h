@@ -5,8 +5,13 @@
 
 #include <Root/components/Rigidbody.h>
 
+#include <vector>
+
 /**
- * Class that handles the callbacks for the CollisionListener.
+ * Class that records the contacts reported by Box2D during a step,
+ * and dispatches them to the CollisionListeners afterwards.
+ * One handler serves every physics world. Each world records into its own buffer,
+ * so that worlds can be stepped on different threads at the same time.
  */
 class CollisionCallbackHandler : public b2ContactListener
 {
@@ -21,7 +26,70 @@ public:
 	
 	void setCollisionListener(CollisionListener* contactListener);
 
+	/**
+	 * Give a world its own buffer to record events into.
+	 * Must be called before the world is stepped, and not while any world is stepping.
+	 *
+	 * \param world: the world to record events for.
+	 */
+	void addWorld(const b2World* world);
+
+	/**
+	 * Add a listener which only receives events involving the given layers.
+	 *
+	 * \param layers: the listener receives an event if either collider is on one of these layers.
+	 * \param listener: the listener to add.
+	 */
+	void addLayerCollisionListener(LayerMask layers, CollisionListener* listener);
+
+	/**
+	 * Remove a listener added with addLayerCollisionListener().
+	 *
+	 * \param listener: the listener to remove.
+	 * \returns whether the listener was found and removed.
+	 */
+	bool removeLayerCollisionListener(CollisionListener* listener);
+
+	/**
+	 * Call the listeners for every event recorded since the last dispatch, and clear the events.
+	 * The events of each world are dispatched in the order the worlds were added,
+	 * so the order does not depend on which world finished stepping first.
+	 * Must be called while no world is locked.
+	 */
+	void dispatchEvents();
+
+	/**
+	 * Get the events recorded in a world since the last dispatch.
+	 *
+	 * \param world: the world to get the events of.
+	 * \returns the recorded events, in the order they happened.
+	 */
+	std::vector<CollisionEvent>& getEvents(const b2World* world);
+
 private:
+
+	struct LayerCollisionListener
+	{
+		LayerMask layers;
+		CollisionListener* listener;
+	};
+
+	struct WorldEvents
+	{
+		const b2World* world;
+		std::vector<CollisionEvent> events;
+	};
+
+	bool recordEvent(b2Contact* contact, CollisionEventType type);
+
+	WorldEvents& getWorldEvents(const b2World* world);
+
 	CollisionListener* contactListener{ nullptr };
-};
+	std::vector<LayerCollisionListener> layerListeners;
 
+	// Kept between steps so that recording events does not allocate.
+	// The buffers are only added to between steps, so looking them up while stepping is safe.
+	std::vector<WorldEvents> worldEvents;
+	// Events being dispatched, so that listeners can trigger new events without invalidating them
+	std::vector<CollisionEvent> dispatchingEvents;
+};
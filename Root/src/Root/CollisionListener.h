@@ -1,27 +1,67 @@
 #pragma once
 
 #include <Root/components/Rigidbody.h>
+#include <Root/RigidbodyHandle.h>
 
 #include <box2d/b2_world_callbacks.h>
 #include <box2d/b2_contact.h>
 #include <box2d/b2_body.h>
 #include <box2d/b2_settings.h>
 
+#include <glm/glm.hpp>
+
+enum class CollisionEventType
+{
+	// Two colliders started touching
+	BEGIN,
+	// Two colliders stopped touching
+	END
+};
+
+/**
+ * A contact between two rigidbodies, recorded during a physics step.
+ * Events are dispatched after the step, when the physics world can be changed freely.
+ */
+struct CollisionEvent
+{
+	CollisionEventType type;
+
+	// The rigidbodies involved. Use get() to retrieve them,
+	// which returns nullptr if the rigidbody was destroyed in the meantime.
+	RigidbodyHandle rigidbody1;
+	RigidbodyHandle rigidbody2;
+
+	// The layers of the touching colliders
+	LayerMask layer1;
+	LayerMask layer2;
+
+	// Whether either collider is a sensor
+	bool sensor;
+
+	// The world position and normal (pointing from rigidbody1 to rigidbody2) of the first contact point.
+	// Only set for BEGIN events.
+	glm::vec2 point;
+	glm::vec2 normal;
+};
+
 /**
  * A class that should be the base class of your collision callback handler.
  * In order to use it:
  * - Create a subclass of this class
  * - Implement BeginContact() and EndContact() (optional)
  * - Create an instance of your new class
- * - Use Physics::setCollisionListener() with a pointer to the new instance
+ * - Use Physics::setCollisionListener() or Physics::addLayerCollisionListener() with a pointer to the new instance
  * - Make sure the instance stays alive
+ * The callbacks are called after the physics step, so rigidbodies can safely be
+ * created, destroyed, moved or disabled from within them.
+ * The two rigidbodies are always passed in the same order for a given pair of tags:
+ * rigidbody1 is the one whose tag comes first alphabetically (compared with std::string::compare()).
  */
 class CollisionListener
 {
 public:
 
-	virtual void BeginContact(b2Contact* contact, Rigidbody* rb1, Rigidbody* rb2) {}
+	virtual void BeginContact(const CollisionEvent& event) {}
 
-	virtual void EndContact(b2Contact* contact, Rigidbody* rb1, Rigidbody* rb2) {}
+	virtual void EndContact(const CollisionEvent& event) {}
 };
-
@@ -5,4 +5,5 @@
 #include "Root/rendering/SpriteRenderer.h"
 #include "Root/rendering/Camera.h"
 #include "Root/components/Script.h"
-#include "Root/components/ParticleSystem.h"
\ No newline at end of file
+#include "Root/components/ParticleSystem.h"
+#include "Root/components/AudioEmitter.h"
@@ -139,7 +139,7 @@ public:
 	 * \param point the point at which to sample.
 	 * \return the interpolated value at the given point.
 	 */
-	T sample(float samplePoint)
+	T sample(float samplePoint) const
 	{
 		// If there are no points, return the value given by the default constructor of the type.
 		if (points.size() == 0)
@@ -150,7 +150,7 @@ public:
 			return points[0].value;
 
 		unsigned int i{ 0 };
-		for (GradientPoint<T>& gradientPoint : points)
+		for (const GradientPoint<T>& gradientPoint : points)
 		{
 			// Found the right side point
 			if (samplePoint < gradientPoint.point)
@@ -52,4 +52,29 @@ namespace Input
 	{
 		return InputEngine::getMouseNormalizedScreenPosition();
 	}
+
+	bool startRecording(const std::string& path)
+	{
+		return InputEngine::startRecording(path);
+	}
+
+	void stopRecording()
+	{
+		InputEngine::stopRecording();
+	}
+
+	bool startReplay(const std::string& path)
+	{
+		return InputEngine::startReplay(path);
+	}
+
+	void stopReplay()
+	{
+		InputEngine::stopReplay();
+	}
+
+	bool isReplaying()
+	{
+		return InputEngine::isReplaying();
+	}
 };
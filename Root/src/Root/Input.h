@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include <string>
+
 /* The unknown key */
 #define KEY_UNKNOWN				GLFW_KEY_UNKNOWN
 
@@ -225,5 +227,41 @@ namespace Input
 	 * \return the normalized screen location of the mouse (x in [-1, -1], y in [-1, 1]).
 	 */
 	glm::vec2 getMouseNormalizedScreenPosition();
+
+	/**
+	 * Start writing the input of every frame to a file, which can be replayed with startReplay().
+	 * Useful to make performance captures and benchmarks repeatable.
+	 *
+	 * \param path: the path of the file to write to.
+	 * \returns whether the file could be opened.
+	 */
+	bool startRecording(const std::string& path);
+
+	/**
+	 * Stop writing input to the recording file.
+	 */
+	void stopRecording();
+
+	/**
+	 * Use the input of a recording instead of the actual input, starting next frame.
+	 * The frame times are also replayed, so the game gets the same delta time every frame as when it was recorded.
+	 * Goes back to the actual input when the recording ends.
+	 *
+	 * \param path: the path of the recording.
+	 * \returns whether the recording could be loaded.
+	 */
+	bool startReplay(const std::string& path);
+
+	/**
+	 * Stop replaying the recording and go back to the actual input.
+	 */
+	void stopReplay();
+
+	/**
+	 * Get whether a recording is being replayed.
+	 *
+	 * \returns whether a recording is being replayed.
+	 */
+	bool isReplaying();
 };
 
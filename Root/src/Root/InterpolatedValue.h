@@ -48,6 +48,15 @@ public:
 	 */
 	ValueType sample();
 
+	/**
+	 * Get whether the value is still changing.
+	 * Stays true until sample() has returned the new value itself,
+	 * so anything drawn with the sampled values is always drawn with the final one as well.
+	 *
+	 * \returns whether sampling may give a different value than last time.
+	 */
+	bool isTransitioning();
+
 	/**
 	 * Set the transition duration for scale and color transition.
 	 *
@@ -64,6 +73,9 @@ private:
 	TagType activeTag;
 	ValueType previousValue;
 
+	// Whether sample() has returned the active value since it was set
+	bool settled{ true };
+
 	float timeOfValueChange;
 
 	float transitionDuration;
@@ -114,6 +126,7 @@ void InterpolatedValue<TagType, ValueType>::setActiveValue(TagType tag)
 
 		// And marking the time for interpolation
 		timeOfValueChange = Time::getTime();
+		settled = false;
 	}
 
 	// Did not find the character
@@ -133,13 +146,22 @@ ValueType InterpolatedValue<TagType, ValueType>::sample()
 
 	// Already past the transition
 	if (timeSinceValueChange >= transitionDuration)
+	{
+		settled = true;
 		return activeValue;
+	}
 
 	// Otherwise interpolate
 	float t{ timeSinceValueChange / transitionDuration };
 	return Math::cerp<ValueType>(previousValue, activeValue, t);
 }
 
+template <typename TagType, typename ValueType>
+bool InterpolatedValue<TagType, ValueType>::isTransitioning()
+{
+	return !settled;
+}
+
 template <typename TagType, typename ValueType>
 void InterpolatedValue<TagType, ValueType>::setTransitionDuration(float transitionDuration)
 {
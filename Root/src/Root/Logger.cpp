@@ -1,60 +1,502 @@
 #include "Logger.h"
 
-void Logger::log(std::string message)
-{
-    log(message.c_str());
-}
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <fstream>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
 
-void Logger::log(const char* message)
-{
-    // White text on black background
-    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 15);
-    write((std::string("[LOG]       ") + message).c_str());
-}
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#endif
 
-void Logger::logWarning(std::string message)
+namespace Logger
 {
-    logWarning(message.c_str());
-}
+    namespace
+    {
+        // The number of messages that can wait to be written, must be a power of two
+        const std::uint64_t queueCapacity{ 1024 };
+        const std::size_t maxMessageLength{ 255 };
 
-void Logger::logWarning(const char* message)
-{
-    // Yellow text on black background
-    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 6);
-    write((std::string("[WARNING]   ") + message).c_str());
+        /**
+         * One message in the queue.
+         * The sequence says whose turn it is, for the message at position p in turn t = p / queueCapacity:
+         * 2t means the slot is free for a producer, 2t + 1 means the message is ready to be written.
+         */
+        struct Slot
+        {
+            std::atomic<std::uint64_t> sequence;
+            int level;
+            bool prefixed;
+            unsigned char length;
+            char text[maxMessageLength];
+        };
+
+        // Zero initialised before any code runs, so messages can be logged from static constructors too
+        Slot slots[queueCapacity];
+        std::atomic<std::uint64_t> enqueuePosition{ 0 };
+        // Messages that did not fit in the queue
+        std::atomic<std::uint64_t> droppedMessages{ 0 };
+
+        enum SinkState
+        {
+            NOT_STARTED,
+            RUNNING,
+            STOPPED
+        };
+        std::atomic<int> sinkState{ NOT_STARTED };
+        std::once_flag sinkStarted;
+
+        // Identical messages are written at most this many times per rate limit window
+        const unsigned int rateLimitCount{ 10 };
+        const std::chrono::milliseconds rateLimitWindow{ 1000 };
+
+        struct RepeatedMessage
+        {
+            std::chrono::steady_clock::time_point windowStart;
+            unsigned int count;
+            unsigned int suppressed;
+            int level;
+            std::string text;
+        };
+
+        /**
+         * Everything the background thread uses to write messages.
+         * Never destroyed, so that messages logged while the program exits can still be written.
+         */
+        struct Sink
+        {
+            std::thread thread;
+
+            std::mutex wakeMutex;
+            std::condition_variable wakeCondition;
+            bool stopping{ false };
+
+            // Only used by the thread that writes messages
+            std::uint64_t dequeuePosition{ 0 };
+            std::uint64_t reportedDroppedMessages{ 0 };
+            std::unordered_map<std::uint64_t, RepeatedMessage> repeatedMessages;
+            std::chrono::steady_clock::time_point lastRateLimitCleanup;
+
+            // Used to wait for flush()
+            std::atomic<std::uint64_t> writtenPosition{ 0 };
+            std::mutex flushMutex;
+            std::condition_variable flushCondition;
+
+            // Protects everything below, which the main thread can change while messages are being written
+            std::mutex outputMutex;
+            std::ofstream file;
+            bool consoleOutput{ true };
+            int consoleLevel{ -1 };
+        };
+
+        Sink& getSink()
+        {
+            static Sink* sink{ new Sink{} };
+            return *sink;
+        }
+
+        const char* getPrefix(int level)
+        {
+            switch (level)
+            {
+            case LOG_LEVEL_DESTRUCTOR:
+                return "[DESTROYED] ";
+            case LOG_LEVEL_WARNING:
+                return "[WARNING]   ";
+            case LOG_LEVEL_ERROR:
+                return "[ERROR]     ";
+            default:
+                return "[LOG]       ";
+            }
+        }
+
+        void setConsoleColour(Sink& sink, int level)
+        {
+            if (sink.consoleLevel == level)
+                return;
+            sink.consoleLevel = level;
+
+#ifdef _WIN32
+            // The colour applies to what is written after it is set, so the earlier messages must be written first
+            std::cout.flush();
+
+            WORD colour{ 15 };              // White text on black background
+            if (level == LOG_LEVEL_WARNING)
+                colour = 6;                 // Yellow text on black background
+            else if (level == LOG_LEVEL_ERROR)
+                colour = 4;                 // Red text on black background
+            SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), colour);
+#else
+            if (level == LOG_LEVEL_WARNING)
+                std::cout << "\x1b[33m";    // Yellow text
+            else if (level == LOG_LEVEL_ERROR)
+                std::cout << "\x1b[31m";    // Red text
+            else
+                std::cout << "\x1b[0m";     // Default colours
+#endif
+        }
+
+        // Must be called with the output mutex locked
+        void writeMessage(Sink& sink, int level, bool prefixed, const char* text, std::size_t length)
+        {
+            const char* prefix{ prefixed ? getPrefix(level) : "" };
+
+            if (sink.consoleOutput)
+            {
+                setConsoleColour(sink, level);
+                std::cout << prefix;
+                std::cout.write(text, length);
+                std::cout << '\n';
+            }
+
+            if (sink.file.is_open())
+            {
+                sink.file << prefix;
+                sink.file.write(text, length);
+                sink.file << '\n';
+
+                // Making sure errors end up in the file even if the program crashes right after
+                if (level == LOG_LEVEL_ERROR)
+                    sink.file.flush();
+            }
+        }
+
+        void writeRepeatSummary(Sink& sink, const RepeatedMessage& message)
+        {
+            std::string summary{ message.text + " (repeated " + std::to_string(message.suppressed) + " more times)" };
+            writeMessage(sink, message.level, true, summary.c_str(), summary.size());
+        }
+
+        std::uint64_t hashMessage(int level, const char* text, std::size_t length)
+        {
+            // FNV-1a
+            std::uint64_t hash{ 14695981039346656037ull ^ static_cast<std::uint64_t>(level) };
+            for (std::size_t i{ 0 }; i < length; i++)
+            {
+                hash ^= static_cast<unsigned char>(text[i]);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        /**
+         * Check whether a message should be written, or left out because it was written too often recently.
+         * Must be called with the output mutex locked.
+         */
+        bool passesRateLimit(Sink& sink, int level, const char* text, std::size_t length,
+            std::chrono::steady_clock::time_point now)
+        {
+            std::uint64_t hash{ hashMessage(level, text, length) };
+
+            auto it{ sink.repeatedMessages.find(hash) };
+            if (it == sink.repeatedMessages.end())
+            {
+                sink.repeatedMessages.emplace(hash, RepeatedMessage{ now, 1, 0, level, std::string{ text, length } });
+                return true;
+            }
+
+            RepeatedMessage& message{ it->second };
+
+            if (now - message.windowStart >= rateLimitWindow)
+            {
+                if (message.suppressed > 0)
+                    writeRepeatSummary(sink, message);
+
+                message.windowStart = now;
+                message.count = 1;
+                message.suppressed = 0;
+                return true;
+            }
+
+            message.count++;
+            if (message.count <= rateLimitCount)
+                return true;
+
+            message.suppressed++;
+            return false;
+        }
+
+        // Forget messages that were not repeated recently, after saying how often they were left out
+        void cleanUpRateLimit(Sink& sink, std::chrono::steady_clock::time_point now)
+        {
+            if (now - sink.lastRateLimitCleanup < rateLimitWindow)
+                return;
+            sink.lastRateLimitCleanup = now;
+
+            for (auto it{ sink.repeatedMessages.begin() }; it != sink.repeatedMessages.end();)
+            {
+                if (now - it->second.windowStart >= rateLimitWindow)
+                {
+                    if (it->second.suppressed > 0)
+                        writeRepeatSummary(sink, it->second);
+                    it = sink.repeatedMessages.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+        }
+
+        bool isMessageReady(Sink& sink)
+        {
+            const Slot& slot{ slots[sink.dequeuePosition & (queueCapacity - 1)] };
+            std::uint64_t turn{ sink.dequeuePosition / queueCapacity };
+            return slot.sequence.load(std::memory_order_acquire) == 2 * turn + 1;
+        }
+
+        // Write every message that is ready, in the order they were queued
+        void writeQueuedMessages(Sink& sink)
+        {
+            if (!isMessageReady(sink))
+                return;
+
+            std::chrono::steady_clock::time_point now{ std::chrono::steady_clock::now() };
+
+            {
+                std::lock_guard<std::mutex> lock{ sink.outputMutex };
+
+                while (isMessageReady(sink))
+                {
+                    Slot& slot{ slots[sink.dequeuePosition & (queueCapacity - 1)] };
+                    std::uint64_t turn{ sink.dequeuePosition / queueCapacity };
+
+                    // Unprefixed messages are written as they are, since they are not really log messages
+                    if (!slot.prefixed || passesRateLimit(sink, slot.level, slot.text, slot.length, now))
+                        writeMessage(sink, slot.level, slot.prefixed, slot.text, slot.length);
+
+                    // Giving the slot to the producers of the next turn
+                    slot.sequence.store(2 * (turn + 1), std::memory_order_release);
+                    sink.dequeuePosition++;
+                }
+
+                std::uint64_t dropped{ droppedMessages.load(std::memory_order_relaxed) };
+                if (dropped != sink.reportedDroppedMessages)
+                {
+                    std::string message{ std::to_string(dropped - sink.reportedDroppedMessages)
+                        + " messages were dropped because the log queue was full." };
+                    writeMessage(sink, LOG_LEVEL_WARNING, true, message.c_str(), message.size());
+                    sink.reportedDroppedMessages = dropped;
+                }
+
+                cleanUpRateLimit(sink, now);
+
+                // Writing the whole batch at once
+                if (sink.consoleOutput)
+                    std::cout.flush();
+                if (sink.file.is_open())
+                    sink.file.flush();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock{ sink.flushMutex };
+                sink.writtenPosition.store(sink.dequeuePosition, std::memory_order_release);
+            }
+            sink.flushCondition.notify_all();
+        }
+
+        void runSink()
+        {
+            Sink& sink{ getSink() };
+
+            while (true)
+            {
+                bool stopping;
+                {
+                    std::unique_lock<std::mutex> lock{ sink.wakeMutex };
+                    // Also waking up regularly, since producers do not lock the mutex and a notification can be missed
+                    sink.wakeCondition.wait_for(lock, std::chrono::milliseconds{ 10 },
+                        [&sink]() { return sink.stopping || isMessageReady(sink); });
+                    stopping = sink.stopping;
+                }
+
+                writeQueuedMessages(sink);
+
+                if (stopping)
+                    return;
+            }
+        }
+
+        void startSink()
+        {
+            getSink().thread = std::thread{ runSink };
+            sinkState.store(RUNNING, std::memory_order_release);
+        }
+
+        /**
+         * Put a message in the queue.
+         *
+         * \returns false if the queue was full.
+         */
+        bool enqueue(int level, bool prefixed, const char* message, std::size_t length)
+        {
+            std::uint64_t position{ enqueuePosition.load(std::memory_order_relaxed) };
+            Slot* slot;
+
+            while (true)
+            {
+                slot = &slots[position & (queueCapacity - 1)];
+                std::uint64_t turn{ position / queueCapacity };
+                std::uint64_t sequence{ slot->sequence.load(std::memory_order_acquire) };
+
+                if (sequence == 2 * turn)
+                {
+                    // The slot is free, claiming it unless another producer was first
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (sequence < 2 * turn)
+                {
+                    // The message of the previous turn was not written yet, so the queue is full
+                    return false;
+                }
+                else
+                {
+                    // Another producer claimed this position already
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::size_t storedLength{ std::min(length, maxMessageLength) };
+            std::memcpy(slot->text, message, storedLength);
+            slot->length = static_cast<unsigned char>(storedLength);
+            slot->level = level;
+            slot->prefixed = prefixed;
+
+            // Handing the message to the sink
+            slot->sequence.store(2 * (position / queueCapacity) + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Stops the logger when the program exits, if it was not stopped before
+        struct StopGuard
+        {
+            ~StopGuard()
+            {
+                stop();
+            }
+        } stopGuard;
+    }
 }
 
-void Logger::logError(std::string message)
+void Logger::submit(int level, bool prefixed, const char* message, std::size_t length)
 {
-    logError(message.c_str());
+    if (sinkState.load(std::memory_order_acquire) == STOPPED)
+    {
+        // Without the background thread the message is written right away
+        Sink& sink{ getSink() };
+        std::lock_guard<std::mutex> lock{ sink.outputMutex };
+        writeMessage(sink, level, prefixed, message, std::min(length, maxMessageLength));
+        if (sink.consoleOutput)
+            std::cout.flush();
+        return;
+    }
+
+    std::call_once(sinkStarted, startSink);
+
+    if (!enqueue(level, prefixed, message, length))
+    {
+        droppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Errors are written as soon as possible, the rest is written with the next batch
+    if (level == LOG_LEVEL_ERROR)
+        getSink().wakeCondition.notify_one();
 }
 
-void Logger::logError(const char* message)
+void Logger::write(const char* message)
 {
-    // Red text on black background
-    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 4);
-    write((std::string("[ERROR]     ") + message).c_str());
+    submit(LOG_LEVEL_LOG, false, message, std::strlen(message));
 }
 
-void Logger::destructorMessage(std::string message)
+bool Logger::setLogFile(const std::string& path)
 {
-    log(message.c_str());
+    Sink& sink{ getSink() };
+
+    {
+        std::lock_guard<std::mutex> lock{ sink.outputMutex };
+
+        if (sink.file.is_open())
+            sink.file.close();
+
+        sink.file.open(path, std::ios::out | std::ios::trunc);
+        if (sink.file.is_open())
+            return true;
+    }
+
+    logError("Could not open log file " + path + ".");
+    return false;
 }
 
-void Logger::destructorMessage(const char* message)
+void Logger::setConsoleOutput(bool enabled)
 {
-    // White text on black background
-    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 15);
-    write((std::string("[DESTROYED] ") + message).c_str());
+    Sink& sink{ getSink() };
+    std::lock_guard<std::mutex> lock{ sink.outputMutex };
+    sink.consoleOutput = enabled;
 }
 
-void Logger::write(const char* message)
+void Logger::flush()
 {
-    // Actually write the message in the console
-    std::cout << message << std::endl;
+    if (sinkState.load(std::memory_order_acquire) != RUNNING)
+        return;
+
+    Sink& sink{ getSink() };
+    std::uint64_t target{ enqueuePosition.load(std::memory_order_acquire) };
+
+    sink.wakeCondition.notify_one();
+
+    std::unique_lock<std::mutex> lock{ sink.flushMutex };
+    sink.flushCondition.wait(lock,
+        [&sink, target]() { return sink.writtenPosition.load(std::memory_order_acquire) >= target; });
 }
 
 void Logger::stop()
 {
-    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 15);
+    Sink& sink{ getSink() };
+
+    if (sinkState.load(std::memory_order_acquire) == RUNNING)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ sink.wakeMutex };
+            sink.stopping = true;
+        }
+        sink.wakeCondition.notify_one();
+        sink.thread.join();
+
+        sinkState.store(STOPPED, std::memory_order_release);
+
+        // Messages that were queued while the thread was stopping
+        writeQueuedMessages(sink);
+    }
+    else
+    {
+        sinkState.store(STOPPED, std::memory_order_release);
+    }
+
+    std::lock_guard<std::mutex> lock{ sink.outputMutex };
+
+    // Saying how often the last repeated messages were left out
+    for (const auto& [hash, message] : sink.repeatedMessages)
+    {
+        if (message.suppressed > 0)
+            writeRepeatSummary(sink, message);
+    }
+    sink.repeatedMessages.clear();
+
+    if (sink.consoleOutput)
+    {
+        setConsoleColour(sink, LOG_LEVEL_LOG);
+        std::cout.flush();
+    }
+    if (sink.file.is_open())
+        sink.file.flush();
 }
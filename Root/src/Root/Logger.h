@@ -1,60 +1,185 @@
 #pragma once
 
 #include <string>
+#include <cstring>
 #include <iostream>
 
-// For colored text
-#define NOMINMAX
-#include <Windows.h>
-#include "WinCon.h"
+// The levels of log messages, from least to most important
+#define LOG_LEVEL_DESTRUCTOR	0
+#define LOG_LEVEL_LOG			1
+#define LOG_LEVEL_WARNING		2
+#define LOG_LEVEL_ERROR			3
+// Used as the minimum level to remove all logging
+#define LOG_LEVEL_NONE			4
 
+// Messages below this level are removed at compile time.
+// Define it (e.g. in the preprocessor definitions) to override the default.
+#ifndef ROOT_LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define ROOT_LOG_MIN_LEVEL LOG_LEVEL_DESTRUCTOR
+#else
+#define ROOT_LOG_MIN_LEVEL LOG_LEVEL_LOG
+#endif
+#endif
+
+/**
+ * The logger does not write messages on the calling thread.
+ * Messages are copied into a lock-free queue and written to the console
+ * (and optionally a file) by a background thread.
+ * Messages longer than 255 characters are cut off.
+ * Identical messages that are logged very often are only written a few times per second,
+ * followed by the number of times they were left out.
+ */
 namespace Logger
 {
+	/**
+	 * Put a message in the queue to be written.
+	 * Use the functions below instead, which leave out messages below the minimum level.
+	 *
+	 * \param level: the level of the message, e.g. LOG_LEVEL_WARNING.
+	 * \param prefixed: whether to write the level in front of the message.
+	 * \param message: the message, which does not need to be null terminated.
+	 * \param length: the number of characters in the message.
+	 */
+	void submit(int level, bool prefixed, const char* message, std::size_t length);
+
 	/**
 	 * Regularly log the given message.
 	 */
-	void log(std::string message);
+	inline void log(const std::string& message)
+	{
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_LOG
+		submit(LOG_LEVEL_LOG, true, message.c_str(), message.size());
+#endif
+	}
 
 	/**
 	 * Regularly log the given message.
 	 */
-	void log(const char* message);
+	inline void log(const char* message)
+	{
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_LOG
+		submit(LOG_LEVEL_LOG, true, message, std::strlen(message));
+#endif
+	}
 
 
 	/**
 	 * Log the given message as a warning.
 	 */
-	void logWarning(std::string message);
+	inline void logWarning(const std::string& message)
+	{
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_WARNING
+		submit(LOG_LEVEL_WARNING, true, message.c_str(), message.size());
+#endif
+	}
 
 	/**
 	 * Log the given message as a warning.
 	 */
-	void logWarning(const char* message);
+	inline void logWarning(const char* message)
+	{
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_WARNING
+		submit(LOG_LEVEL_WARNING, true, message, std::strlen(message));
+#endif
+	}
 
 
 	/**
 	 * Log the given message as an error.
+	 * The log file is flushed right after an error is written to it.
 	 */
-	void logError(std::string message);
+	inline void logError(const std::string& message)
+	{
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+		submit(LOG_LEVEL_ERROR, true, message.c_str(), message.size());
+#endif
+	}
 
 	/**
 	 * Log the given message as an error.
+	 * The log file is flushed right after an error is written to it.
 	 */
-	void logError(const char* message);
+	inline void logError(const char* message)
+	{
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+		submit(LOG_LEVEL_ERROR, true, message, std::strlen(message));
+#endif
+	}
 
 	/**
 	 * Log the given destructor message.
 	 */
-	void destructorMessage(std::string message);
+	inline void destructorMessage(const std::string& message)
+	{
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_DESTRUCTOR
+		submit(LOG_LEVEL_DESTRUCTOR, true, message.c_str(), message.size());
+#endif
+	}
 
 	/**
 	 * Log the given destructor message.
 	 */
-	void destructorMessage(const char* message);
+	inline void destructorMessage(const char* message)
+	{
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_DESTRUCTOR
+		submit(LOG_LEVEL_DESTRUCTOR, true, message, std::strlen(message));
+#endif
+	}
 
 
+	/**
+	 * Write the given message without a level in front of it.
+	 */
 	void write(const char* message);
 
-	// Stop this logger
+	/**
+	 * Also write all messages to a file, replacing the previous log file.
+	 *
+	 * \param path: the path of the file to write to.
+	 * \returns whether the file could be opened.
+	 */
+	bool setLogFile(const std::string& path);
+
+	/**
+	 * Set whether messages are written to the console.
+	 *
+	 * \param enabled: whether to write to the console.
+	 */
+	void setConsoleOutput(bool enabled);
+
+	/**
+	 * Wait until every message logged before this call is written.
+	 */
+	void flush();
+
+	// Write all remaining messages and stop this logger.
+	// Messages logged after this are written immediately, on the calling thread.
 	void stop();
-}
\ No newline at end of file
+}
+
+// These leave out the message entirely, including building it, if its level is below the minimum level.
+// Useful for messages that are expensive to build, e.g. ROOT_LOG("Loaded " + std::to_string(count) + " tiles").
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_DESTRUCTOR
+#define ROOT_LOG_DESTRUCTOR(message) Logger::destructorMessage(message)
+#else
+#define ROOT_LOG_DESTRUCTOR(message) ((void)0)
+#endif
+
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_LOG
+#define ROOT_LOG(message) Logger::log(message)
+#else
+#define ROOT_LOG(message) ((void)0)
+#endif
+
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_WARNING
+#define ROOT_LOG_WARNING(message) Logger::logWarning(message)
+#else
+#define ROOT_LOG_WARNING(message) ((void)0)
+#endif
+
+#if ROOT_LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+#define ROOT_LOG_ERROR(message) Logger::logError(message)
+#else
+#define ROOT_LOG_ERROR(message) ((void)0)
+#endif
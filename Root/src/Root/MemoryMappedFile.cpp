@@ -0,0 +1,134 @@
+#include "MemoryMappedFile.h"
+
+#include <Root/Logger.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MemoryMappedFile::MemoryMappedFile()
+	: fileHandle(INVALID_HANDLE_VALUE),
+	mappingHandle(nullptr),
+	data(nullptr),
+	size(0)
+{
+}
+#else
+MemoryMappedFile::MemoryMappedFile()
+	: fileDescriptor(-1),
+	data(nullptr),
+	size(0)
+{
+}
+#endif
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	close();
+}
+
+bool MemoryMappedFile::open(const std::string& path)
+{
+	close();
+
+#ifdef _WIN32
+	fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		Logger::logError("Could not open file " + path + " to map it into memory.");
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Logger::logError("Could not map empty file " + path + " into memory.");
+		close();
+		return false;
+	}
+	size = static_cast<std::size_t>(fileSize.QuadPart);
+
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle != nullptr)
+		data = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+	fileDescriptor = ::open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		Logger::logError("Could not open file " + path + " to map it into memory.");
+		return false;
+	}
+
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0)
+	{
+		Logger::logError("Could not map empty file " + path + " into memory.");
+		close();
+		return false;
+	}
+	size = static_cast<std::size_t>(fileStatus.st_size);
+
+	void* mapping{ mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) };
+	if (mapping != MAP_FAILED)
+		data = static_cast<const unsigned char*>(mapping);
+#endif
+
+	if (data == nullptr)
+	{
+		Logger::logError("Could not map file " + path + " into memory.");
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void MemoryMappedFile::close()
+{
+#ifdef _WIN32
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+	if (mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	if (fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(fileHandle);
+
+	mappingHandle = nullptr;
+	fileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (data != nullptr)
+		munmap(const_cast<unsigned char*>(data), size);
+	if (fileDescriptor >= 0)
+		::close(fileDescriptor);
+
+	fileDescriptor = -1;
+#endif
+
+	data = nullptr;
+	size = 0;
+}
+
+bool MemoryMappedFile::isOpen() const
+{
+	return data != nullptr;
+}
+
+const unsigned char* MemoryMappedFile::getData() const
+{
+	return data;
+}
+
+std::size_t MemoryMappedFile::getSize() const
+{
+	return size;
+}
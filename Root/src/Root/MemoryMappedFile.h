@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+/**
+ * A read-only file mapped into memory.
+ * Its contents are read from disk by the operating system when they are first used,
+ * without copying them into a buffer first.
+ */
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile();
+	~MemoryMappedFile();
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+	/**
+	 * Map a file into memory, closing the file that was mapped before.
+	 *
+	 * \param path: the path of the file.
+	 * \returns whether the file could be mapped.
+	 */
+	bool open(const std::string& path);
+
+	/**
+	 * Unmap the file. Pointers to its data cannot be used after this.
+	 */
+	void close();
+
+	bool isOpen() const;
+
+	/**
+	 * Get the contents of the file.
+	 *
+	 * \returns the first byte of the file, or nullptr if no file is mapped.
+	 */
+	const unsigned char* getData() const;
+
+	/**
+	 * Get the size of the file.
+	 *
+	 * \returns the number of bytes in the file.
+	 */
+	std::size_t getSize() const;
+
+private:
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#else
+	int fileDescriptor;
+#endif
+
+	const unsigned char* data;
+	std::size_t size;
+};
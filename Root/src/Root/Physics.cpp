@@ -9,6 +9,64 @@ namespace Physics
         PhysicsEngine::setCollisionListener(collisionListener);
     }
 
+    void addLayerCollisionListener(LayerMask layers, CollisionListener* collisionListener)
+    {
+        PhysicsEngine::addLayerCollisionListener(layers, collisionListener);
+    }
+
+    bool removeLayerCollisionListener(CollisionListener* collisionListener)
+    {
+        return PhysicsEngine::removeLayerCollisionListener(collisionListener);
+    }
+
+    void setLayerName(unsigned int layerIndex, const std::string& name)
+    {
+        PhysicsEngine::setLayerName(layerIndex, StringInterner::intern(name));
+    }
+
+    LayerMask getLayer(const std::string& name)
+    {
+        StringID nameID{ StringInterner::find(name) };
+        if (nameID == INVALID_STRING_ID)
+            return 0;
+
+        return PhysicsEngine::getLayerByName(nameID);
+    }
+
+    const std::string& getLayerName(unsigned int layerIndex)
+    {
+        return StringInterner::lookup(PhysicsEngine::getLayerName(layerIndex));
+    }
+
+    void setLayersCollide(LayerMask layersA, LayerMask layersB, bool collide)
+    {
+        PhysicsEngine::setLayersCollide(layersA, layersB, collide);
+    }
+
+    PhysicsWorldID createWorld(const std::string& name)
+    {
+        return PhysicsEngine::createWorld(StringInterner::intern(name));
+    }
+
+    PhysicsWorldID getWorld(const std::string& name)
+    {
+        StringID nameID{ StringInterner::find(name) };
+        if (nameID == INVALID_STRING_ID)
+            return INVALID_PHYSICS_WORLD;
+
+        return PhysicsEngine::getWorldByName(nameID);
+    }
+
+    const std::string& getWorldName(PhysicsWorldID world)
+    {
+        return StringInterner::lookup(PhysicsEngine::getWorldName(world));
+    }
+
+    unsigned int getWorldCount()
+    {
+        return PhysicsEngine::getWorldCount();
+    }
+
     void setGravity(float x, float y)
     {
         PhysicsEngine::setGravity(x, y);
@@ -23,5 +81,70 @@ namespace Physics
     {
         PhysicsEngine::disableDebugMode();
     }
+
+    void setDebugCategories(unsigned int categories)
+    {
+        PhysicsEngine::setDebugCategories(categories);
+    }
+
+    unsigned int getDebugCategories()
+    {
+        return PhysicsEngine::getDebugCategories();
+    }
+
+    void setProfilingEnabled(bool enabled)
+    {
+        PhysicsEngine::setProfilingEnabled(enabled);
+    }
+
+    std::vector<PhysicsStepProfile> getProfileHistory()
+    {
+        return PhysicsEngine::getProfileHistory();
+    }
+
+    bool writeProfileHistory(const std::string& path)
+    {
+        return PhysicsEngine::writeProfileHistory(path);
+    }
+
+    bool raycast(glm::vec2 origin, glm::vec2 end, RaycastHit& hit, LayerMask layerMask)
+    {
+        return PhysicsEngine::raycast(origin, end, hit, layerMask);
+    }
+
+    std::vector<RaycastHit> raycastAll(glm::vec2 origin, glm::vec2 end, LayerMask layerMask)
+    {
+        return PhysicsEngine::raycastAll(origin, end, layerMask);
+    }
+
+    std::vector<Rigidbody*> overlapAABB(glm::vec2 min, glm::vec2 max, LayerMask layerMask)
+    {
+        return PhysicsEngine::overlapAABB(min, max, layerMask);
+    }
+
+    std::vector<Rigidbody*> overlapCircle(glm::vec2 center, float radius, LayerMask layerMask)
+    {
+        return PhysicsEngine::overlapCircle(center, radius, layerMask);
+    }
+
+    bool shapeCast(const b2Shape& shape,
+        glm::vec2 position,
+        float rotation,
+        glm::vec2 translation,
+        ShapeCastHit& hit,
+        LayerMask layerMask)
+    {
+        return PhysicsEngine::shapeCast(shape, position, rotation, translation, hit, layerMask);
+    }
+
+    void raycastBatch(const std::vector<RaycastQuery>& queries, std::vector<RaycastResult>& results)
+    {
+        PhysicsEngine::raycastBatch(queries, results);
+    }
+
+    void overlapCircleBatch(const std::vector<OverlapCircleQuery>& queries, std::vector<OverlapResult>& results)
+    {
+        PhysicsEngine::overlapCircleBatch(queries, results);
+    }
 };
 
@@ -2,16 +2,116 @@
 
 #include <box2d/box2d.h>
 #include <Root/CollisionListener.h>
+#include <Root/PhysicsQuery.h>
+#include <Root/PhysicsProfile.h>
+#include <Root/PhysicsWorldID.h>
+#include <Root/rendering/PhysicsDebugRenderer.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <string>
 
 namespace Physics
 {
 	/**
 	 * Set a new collision listener as the active collision listener.
+	 * It receives the events of all layers, after each physics step.
 	 */
 	void setCollisionListener(CollisionListener* collisionListener);
 
 	/**
-	 * Set the general gravity.
+	 * Add a collision listener which only receives events where either collider is on one of the given layers.
+	 * Any number of layer listeners can be active, next to the main collision listener.
+	 *
+	 * \param layers: the layer(s) to receive events for, e.g. Physics::getLayer("Player").
+	 * \param collisionListener: the listener to add. Must stay alive until it is removed.
+	 */
+	void addLayerCollisionListener(LayerMask layers, CollisionListener* collisionListener);
+
+	/**
+	 * Remove a collision listener added with addLayerCollisionListener().
+	 *
+	 * \param collisionListener: the listener to remove.
+	 * \returns whether the listener was found and removed.
+	 */
+	bool removeLayerCollisionListener(CollisionListener* collisionListener);
+
+	/**
+	 * Give one of the 16 collision layers a name, so it can be retrieved with getLayer().
+	 *
+	 * \param layerIndex: the index of the layer, 0 for LAYER_0 up to 15 for LAYER_15.
+	 * \param name: the name of the layer.
+	 */
+	void setLayerName(unsigned int layerIndex, const std::string& name);
+
+	/**
+	 * Get a collision layer by its name.
+	 *
+	 * \param name: the name given to the layer with setLayerName().
+	 * \returns the layer mask of the layer, or 0 if no layer has the given name.
+	 */
+	LayerMask getLayer(const std::string& name);
+
+	/**
+	 * Get the name of a collision layer.
+	 *
+	 * \param layerIndex: the index of the layer, 0 for LAYER_0 up to 15 for LAYER_15.
+	 * \returns the name of the layer, or the empty string if it has no name.
+	 */
+	const std::string& getLayerName(unsigned int layerIndex);
+
+	/**
+	 * Set whether colliders on the given layers can collide, in the layer collision matrix.
+	 * By default all layers collide with each other.
+	 * Colliders that cannot collide are filtered out before any contact is computed.
+	 * The matrix is applied on top of each collider's own interaction layer mask.
+	 *
+	 * \param layersA: the first layer(s).
+	 * \param layersB: the second layer(s).
+	 * \param collide: whether the layers collide.
+	 */
+	void setLayersCollide(LayerMask layersA, LayerMask layersB, bool collide);
+
+	/**
+	 * Create a new, empty physics world.
+	 * Rigidbodies in different worlds never collide, so that levels split into zones which never
+	 * interact (e.g. separate rooms) can give each zone its own world.
+	 * All worlds are stepped in parallel on the worker threads.
+	 * Queries (raycasts, overlaps and shape casts) search every world.
+	 *
+	 * \param name: the name of the world.
+	 * \returns the ID of the new world, to pass to Rigidbody::create() or Rigidbody::setWorld(),
+	 * or INVALID_PHYSICS_WORLD if a world with the name already exists.
+	 */
+	PhysicsWorldID createWorld(const std::string& name);
+
+	/**
+	 * Get a physics world by its name.
+	 * The default world is called "default".
+	 *
+	 * \param name: the name given to the world with createWorld().
+	 * \returns the ID of the world, or INVALID_PHYSICS_WORLD if no world has the given name.
+	 */
+	PhysicsWorldID getWorld(const std::string& name);
+
+	/**
+	 * Get the name of a physics world.
+	 *
+	 * \param world: the ID of the world.
+	 * \returns the name of the world, or the empty string if the world does not exist.
+	 */
+	const std::string& getWorldName(PhysicsWorldID world);
+
+	/**
+	 * Get the number of physics worlds, including the default world.
+	 *
+	 * \returns the number of worlds.
+	 */
+	unsigned int getWorldCount();
+
+	/**
+	 * Set the general gravity, of every physics world.
 	 * 
 	 * \param x: the x-component of the gravity (side to side)
 	 * \param y: the y-component of the gravity (up or down)
@@ -27,5 +127,129 @@ namespace Physics
 	 *  Disable the physics debug view mode.
 	 */
 	void disableDebugMode();
+
+	/**
+	 * Set which categories the physics debug view draws.
+	 * Categories can be combined with |, e.g. PHYSICS_DEBUG_SHAPES | PHYSICS_DEBUG_CONTACTS.
+	 * Options: PHYSICS_DEBUG_SHAPES, PHYSICS_DEBUG_JOINTS, PHYSICS_DEBUG_AABBS,
+	 * PHYSICS_DEBUG_CENTERS_OF_MASS, PHYSICS_DEBUG_CONTACTS and PHYSICS_DEBUG_ALL.
+	 * Default = PHYSICS_DEBUG_SHAPES.
+	 *
+	 * \param categories: the categories to draw.
+	 */
+	void setDebugCategories(unsigned int categories);
+
+	/**
+	 * Get which categories the physics debug view draws.
+	 *
+	 * \returns the categories that are drawn.
+	 */
+	unsigned int getDebugCategories();
+
+	/**
+	 * Set whether each physics step is measured.
+	 * The measurements are shown in the profiler window and kept for the last 120 steps.
+	 * Off by default, since measuring a step walks every body and contact.
+	 *
+	 * \param enabled: whether to profile the physics steps.
+	 */
+	void setProfilingEnabled(bool enabled);
+
+	/**
+	 * Get the measurements of the most recent physics steps.
+	 *
+	 * \returns the recorded steps, oldest first.
+	 */
+	std::vector<PhysicsStepProfile> getProfileHistory();
+
+	/**
+	 * Write the measurements of the most recent physics steps to a JSON file.
+	 * Useful when running without the profiler window.
+	 *
+	 * \param path: the path of the file to write.
+	 * \returns whether the file was written.
+	 */
+	bool writeProfileHistory(const std::string& path);
+
+	/**
+	 * Cast a ray and find the closest collider it hits.
+	 * Sensors are ignored.
+	 *
+	 * \param origin: the world position the ray starts at.
+	 * \param end: the world position the ray ends at.
+	 * \param hit: will be filled with information about the closest hit, if there was one.
+	 * \param layerMask: only colliders on one of these layers can be hit [optional: default = LAYER_ALL].
+	 * \returns whether the ray hit anything.
+	 */
+	bool raycast(glm::vec2 origin, glm::vec2 end, RaycastHit& hit, LayerMask layerMask = LAYER_ALL);
+
+	/**
+	 * Cast a ray and find all colliders it hits.
+	 * Sensors are ignored.
+	 *
+	 * \param origin: the world position the ray starts at.
+	 * \param end: the world position the ray ends at.
+	 * \param layerMask: only colliders on one of these layers can be hit [optional: default = LAYER_ALL].
+	 * \returns every hit, sorted from closest to furthest.
+	 */
+	std::vector<RaycastHit> raycastAll(glm::vec2 origin, glm::vec2 end, LayerMask layerMask = LAYER_ALL);
+
+	/**
+	 * Find all rigidbodies with a collider overlapping an axis-aligned box.
+	 *
+	 * \param min: the bottom left corner of the box.
+	 * \param max: the top right corner of the box.
+	 * \param layerMask: only colliders on one of these layers are found [optional: default = LAYER_ALL].
+	 * \returns every overlapping rigidbody, each only once.
+	 */
+	std::vector<Rigidbody*> overlapAABB(glm::vec2 min, glm::vec2 max, LayerMask layerMask = LAYER_ALL);
+
+	/**
+	 * Find all rigidbodies with a collider overlapping a circle.
+	 *
+	 * \param center: the center of the circle.
+	 * \param radius: the radius of the circle.
+	 * \param layerMask: only colliders on one of these layers are found [optional: default = LAYER_ALL].
+	 * \returns every overlapping rigidbody, each only once.
+	 */
+	std::vector<Rigidbody*> overlapCircle(glm::vec2 center, float radius, LayerMask layerMask = LAYER_ALL);
+
+	/**
+	 * Move a shape in a straight line and find the first collider it touches.
+	 * Sensors are ignored.
+	 *
+	 * \param shape: the shape to move, e.g. a b2CircleShape or b2PolygonShape.
+	 * \param position: the world position the shape starts at.
+	 * \param rotation: the rotation of the shape in degrees.
+	 * \param translation: how far the shape moves.
+	 * \param hit: will be filled with information about the first hit, if there was one.
+	 * \param layerMask: only colliders on one of these layers can be hit [optional: default = LAYER_ALL].
+	 * \returns whether the shape hit anything.
+	 */
+	bool shapeCast(const b2Shape& shape,
+		glm::vec2 position,
+		float rotation,
+		glm::vec2 translation,
+		ShapeCastHit& hit,
+		LayerMask layerMask = LAYER_ALL);
+
+	/**
+	 * Run many raycasts at once, spread over multiple threads.
+	 * Much faster than separate raycast() calls when many objects query the world every frame.
+	 *
+	 * \param queries: the raycasts to run.
+	 * \param results: will be resized to hold one result per query, in the same order.
+	 * Reusing the same vector every frame avoids allocations.
+	 */
+	void raycastBatch(const std::vector<RaycastQuery>& queries, std::vector<RaycastResult>& results);
+
+	/**
+	 * Run many circle overlap tests at once, spread over multiple threads.
+	 *
+	 * \param queries: the overlap tests to run.
+	 * \param results: will be resized to hold one result per query, in the same order.
+	 * Reusing the same vector every frame avoids allocations.
+	 */
+	void overlapCircleBatch(const std::vector<OverlapCircleQuery>& queries, std::vector<OverlapResult>& results);
 };
 
@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * Measurements of a single physics step.
+ * The times and counts are summed over all physics worlds,
+ * so with several worlds stepping in parallel the times are the total processor time.
+ */
+struct PhysicsStepProfile
+{
+	// Times in milliseconds, as measured by Box2D
+	float step{ 0.0f };
+	float collide{ 0.0f };
+	float solve{ 0.0f };
+	float solveInit{ 0.0f };
+	float solveVelocity{ 0.0f };
+	float solvePosition{ 0.0f };
+	float broadphase{ 0.0f };
+	float solveTOI{ 0.0f };
+
+	// Time spent on the queued body changes before the step, in milliseconds
+	float queues{ 0.0f };
+
+	// The sizes of the queues of body changes that were applied before the step
+	unsigned int bodiesToDestroy{ 0 };
+	unsigned int bodyEnabledStateChanges{ 0 };
+	unsigned int bodyPositionChanges{ 0 };
+
+	// The state of the world after the step
+	unsigned int bodyCount{ 0 };
+	unsigned int awakeBodyCount{ 0 };
+	unsigned int contactCount{ 0 };
+	unsigned int touchingContactCount{ 0 };
+	unsigned int proxyCount{ 0 };
+	unsigned int jointCount{ 0 };
+	// The number of groups of awake bodies that are connected by contacts or joints, which Box2D solves separately
+	unsigned int islandCount{ 0 };
+};
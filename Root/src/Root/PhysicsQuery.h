@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Root/colliders/Collider.h>
+
+#include <box2d/b2_fixture.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class Rigidbody;
+
+/**
+ * Information about where a ray hit a collider.
+ */
+struct RaycastHit
+{
+	// The rigidbody that was hit
+	Rigidbody* rigidbody{ nullptr };
+	// The fixture of the rigidbody that was hit
+	b2Fixture* fixture{ nullptr };
+	// The world position where the ray hit
+	glm::vec2 point{ 0.0f };
+	// The surface normal at the point where the ray hit
+	glm::vec2 normal{ 0.0f };
+	// How far along the ray the hit was, from 0 (origin) to 1 (end)
+	float fraction{ 1.0f };
+};
+
+/**
+ * Information about where a moving shape first touched a collider.
+ */
+struct ShapeCastHit
+{
+	// The rigidbody that was hit
+	Rigidbody* rigidbody{ nullptr };
+	// The fixture of the rigidbody that was hit
+	b2Fixture* fixture{ nullptr };
+	// The world position where the shapes touched
+	glm::vec2 point{ 0.0f };
+	// The surface normal at the point where the shapes touched
+	glm::vec2 normal{ 0.0f };
+	// How far along the translation the hit was, from 0 (start) to 1 (end)
+	float fraction{ 1.0f };
+};
+
+/**
+ * A single raycast in a batch of raycasts.
+ */
+struct RaycastQuery
+{
+	glm::vec2 origin;
+	glm::vec2 end;
+	LayerMask layerMask{ LAYER_ALL };
+};
+
+/**
+ * The result of a single raycast in a batch of raycasts.
+ */
+struct RaycastResult
+{
+	// Whether the ray hit anything, if false the hit is not valid
+	bool hit{ false };
+	RaycastHit closestHit{};
+};
+
+/**
+ * A single circle overlap test in a batch of overlap tests.
+ */
+struct OverlapCircleQuery
+{
+	glm::vec2 center;
+	float radius;
+	LayerMask layerMask{ LAYER_ALL };
+};
+
+/**
+ * The result of a single overlap test in a batch of overlap tests.
+ */
+struct OverlapResult
+{
+	// Every rigidbody that overlapped, each only once
+	std::vector<Rigidbody*> rigidbodies;
+};
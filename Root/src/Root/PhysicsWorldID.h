@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+ * Identifier of a physics world.
+ * Rigidbodies in different worlds never collide, which allows the worlds to be simulated in parallel.
+ */
+typedef unsigned int PhysicsWorldID;
+
+// The world rigidbodies are created in if no other world is given, which always exists
+#define DEFAULT_PHYSICS_WORLD 0u
+
+// Returned when a world could not be created or found
+#define INVALID_PHYSICS_WORLD 0xFFFFFFFFu
@@ -0,0 +1,13 @@
+#include "RigidbodyHandle.h"
+
+#include "Root/engine/PhysicsEngine.h"
+
+Rigidbody* RigidbodyHandle::get() const
+{
+	return PhysicsEngine::getRigidbody(*this);
+}
+
+bool RigidbodyHandle::isValid() const
+{
+	return get() != nullptr;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+class Rigidbody;
+
+/**
+ * A weak reference to a rigidbody.
+ * Unlike a raw pointer, a handle can be safely checked after the rigidbody was destroyed:
+ * get() will then return nullptr instead of a dangling pointer.
+ */
+struct RigidbodyHandle
+{
+	// The slot of the rigidbody in the physics engine
+	std::uint32_t index{ 0 };
+	// Incremented every time the slot is reused, so old handles to the slot become invalid
+	std::uint32_t generation{ 0 };
+
+	/**
+	 * Get the rigidbody this handle refers to.
+	 *
+	 * \returns the rigidbody, or nullptr if it was destroyed.
+	 */
+	Rigidbody* get() const;
+
+	/**
+	 * Get whether the rigidbody this handle refers to still exists.
+	 *
+	 * \returns whether the rigidbody still exists.
+	 */
+	bool isValid() const;
+
+	bool operator==(const RigidbodyHandle& other) const
+	{
+		return index == other.index && generation == other.generation;
+	}
+
+	bool operator!=(const RigidbodyHandle& other) const
+	{
+		return !(*this == other);
+	}
+};
@@ -41,6 +41,16 @@ namespace Root
         return RootEngine::getTransformByName(name);
     }
 
+    const std::vector<Transform*>& getTransformsWithTag(const std::string& tag)
+    {
+        return RootEngine::getTransformsWithTag(StringInterner::find(tag));
+    }
+
+    const std::vector<Transform*>& getTransformsWithTag(StringID tagID)
+    {
+        return RootEngine::getTransformsWithTag(tagID);
+    }
+
     Camera* getActiveCamera()
     {
         return RootEngine::getActiveCamera();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Transform.h"
+#include "StringID.h"
 #include "Root/Components.h"
 #include "Root/components/Script.h"
 #include "shaders/Shader.h"
@@ -95,6 +96,24 @@ namespace Root
 	 */
 	TransformPointer getTransformByName(std::string& name);
 
+	/**
+	 * Get all transforms with the given tag.
+	 * Runs in time proportional to the number of results.
+	 *
+	 * \param tag: the tag to look for.
+	 * \returns the transforms with the given tag. Only valid until a transform is added, removed or retagged.
+	 */
+	const std::vector<Transform*>& getTransformsWithTag(const std::string& tag);
+
+	/**
+	 * Get all transforms with the given tag ID.
+	 * Runs in time proportional to the number of results.
+	 *
+	 * \param tagID: the interned ID of the tag to look for.
+	 * \returns the transforms with the given tag. Only valid until a transform is added, removed or retagged.
+	 */
+	const std::vector<Transform*>& getTransformsWithTag(StringID tagID);
+
 	/**
 	 * Get the camera currently actively used for rendering.
 	 *
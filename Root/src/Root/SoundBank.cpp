@@ -0,0 +1,284 @@
+#include "SoundBank.h"
+
+#include <Root/Logger.h>
+
+#include <AudioFile/AudioFile.h>
+
+#include <fstream>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+	/*
+	 * A sound bank starts with a header, followed by one table entry per clip, the names of the clips
+	 * and the samples of each clip. All offsets are from the start of the file, and all values are little endian.
+	 */
+	const char bankMagic[4]{ 'R', 'S', 'B', 'K' };
+	const std::uint32_t bankVersion{ 1 };
+
+	struct BankHeader
+	{
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t clipCount;
+		std::uint32_t reserved;
+	};
+
+	struct BankTableEntry
+	{
+		std::uint64_t dataOffset;
+		std::uint64_t dataSize;
+		std::uint32_t nameOffset;
+		std::uint32_t nameLength;
+		std::uint32_t sampleRate;
+		std::uint16_t channelCount;
+		std::uint16_t bitsPerSample;
+	};
+
+	static_assert(sizeof(BankHeader) == 16, "The sound bank header must not be padded");
+	static_assert(sizeof(BankTableEntry) == 32, "Sound bank table entries must not be padded");
+
+	// The samples of each clip start at a multiple of this, so they can be read efficiently
+	const std::uint64_t dataAlignment{ 16 };
+
+	float millisecondsSince(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+bool SoundBank::cook(const std::vector<SoundBankClip>& clips, const std::string& bankPath)
+{
+	std::vector<BankTableEntry> table(clips.size());
+	std::vector<std::vector<std::uint8_t>> samples(clips.size());
+	std::string names;
+
+	for (std::size_t i{ 0 }; i < clips.size(); i++)
+	{
+		AudioFile<float> soundFile;
+		if (!soundFile.load(clips[i].path))
+		{
+			Logger::logError("SoundBank: Failed to load sound at " + clips[i].path);
+			return false;
+		}
+
+		if (soundFile.getNumChannels() != 1 && soundFile.getNumChannels() != 2)
+		{
+			Logger::logError("SoundBank: Only mono and stereo sounds are supported, which " + clips[i].path + " is not.");
+			return false;
+		}
+
+		// OpenAL only takes 8 and 16 bit samples
+		if (soundFile.getBitDepth() != 8)
+			soundFile.setBitDepth(16);
+
+		soundFile.writePCMToBuffer(samples[i]);
+
+		table[i].dataSize = samples[i].size();
+		table[i].nameOffset = static_cast<std::uint32_t>(names.size());
+		table[i].nameLength = static_cast<std::uint32_t>(clips[i].name.size());
+		table[i].sampleRate = soundFile.getSampleRate();
+		table[i].channelCount = static_cast<std::uint16_t>(soundFile.getNumChannels());
+		table[i].bitsPerSample = static_cast<std::uint16_t>(soundFile.getBitDepth());
+
+		names += clips[i].name;
+	}
+
+	// Placing the samples after the table and the names
+	std::uint64_t offset{ sizeof(BankHeader) + table.size() * sizeof(BankTableEntry) + names.size() };
+	for (BankTableEntry& entry : table)
+	{
+		offset = (offset + dataAlignment - 1) / dataAlignment * dataAlignment;
+		entry.dataOffset = offset;
+		offset += entry.dataSize;
+	}
+
+	std::ofstream file{ bankPath, std::ios::out | std::ios::binary | std::ios::trunc };
+	if (!file.is_open())
+	{
+		Logger::logError("SoundBank: Could not open file " + bankPath + " to write the sound bank to.");
+		return false;
+	}
+
+	BankHeader header{};
+	std::memcpy(header.magic, bankMagic, sizeof(bankMagic));
+	header.version = bankVersion;
+	header.clipCount = static_cast<std::uint32_t>(table.size());
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(BankTableEntry));
+	file.write(names.data(), names.size());
+
+	const char padding[dataAlignment]{};
+	for (std::size_t i{ 0 }; i < table.size(); i++)
+	{
+		std::uint64_t position{ static_cast<std::uint64_t>(file.tellp()) };
+		file.write(padding, static_cast<std::streamsize>(table[i].dataOffset - position));
+		file.write(reinterpret_cast<const char*>(samples[i].data()), samples[i].size());
+	}
+
+	if (!file)
+	{
+		Logger::logError("SoundBank: Failed to write the sound bank to " + bankPath);
+		return false;
+	}
+
+	ROOT_LOG("Cooked " + std::to_string(clips.size()) + " sounds into " + bankPath);
+	return true;
+}
+
+std::unique_ptr<SoundBank> SoundBank::open(const std::string& path)
+{
+	std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+
+	std::unique_ptr<SoundBank> bank{ new SoundBank() };
+	bank->path = path;
+
+	if (!bank->file.open(path))
+		return nullptr;
+
+	const unsigned char* data{ bank->file.getData() };
+	std::size_t size{ bank->file.getSize() };
+
+	BankHeader header;
+	if (size < sizeof(header))
+	{
+		Logger::logError("SoundBank: " + path + " is not a sound bank.");
+		return nullptr;
+	}
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.magic, bankMagic, sizeof(bankMagic)) != 0 || header.version != bankVersion)
+	{
+		Logger::logError("SoundBank: " + path + " is not a sound bank, or was cooked by a different version.");
+		return nullptr;
+	}
+
+	std::uint64_t tableEnd{ sizeof(header) + static_cast<std::uint64_t>(header.clipCount) * sizeof(BankTableEntry) };
+	if (tableEnd > size)
+	{
+		Logger::logError("SoundBank: The table of " + path + " is cut off.");
+		return nullptr;
+	}
+
+	bank->clips.reserve(header.clipCount);
+
+	for (std::uint32_t i{ 0 }; i < header.clipCount; i++)
+	{
+		BankTableEntry entry;
+		std::memcpy(&entry, data + sizeof(header) + i * sizeof(BankTableEntry), sizeof(entry));
+
+		std::uint64_t nameStart{ tableEnd + entry.nameOffset };
+		if (nameStart + entry.nameLength > size || entry.dataOffset + entry.dataSize > size
+			|| (entry.bitsPerSample != 8 && entry.bitsPerSample != 16)
+			|| (entry.channelCount != 1 && entry.channelCount != 2)
+			|| entry.sampleRate == 0)
+		{
+			Logger::logError("SoundBank: Clip " + std::to_string(i) + " of " + path + " is invalid.");
+			return nullptr;
+		}
+
+		Clip clip;
+		clip.name = StringInterner::intern(std::string{ reinterpret_cast<const char*>(data + nameStart), entry.nameLength });
+		clip.dataOffset = entry.dataOffset;
+		clip.dataSize = entry.dataSize;
+		clip.sampleRate = entry.sampleRate;
+
+		if (entry.bitsPerSample == 8)
+			clip.format = entry.channelCount == 2 ? AL_FORMAT_STEREO8 : AL_FORMAT_MONO8;
+		else
+			clip.format = entry.channelCount == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+
+		std::uint64_t bytesPerFrame{ static_cast<std::uint64_t>(entry.channelCount) * entry.bitsPerSample / 8 };
+		clip.length = static_cast<float>(entry.dataSize / bytesPerFrame) / entry.sampleRate;
+
+		bank->dataSize += entry.dataSize;
+		bank->clips.push_back(clip);
+	}
+
+	bank->openMilliseconds = millisecondsSince(start);
+	return bank;
+}
+
+SoundBank::~SoundBank()
+{
+	if (loader.joinable())
+		loader.join();
+}
+
+void SoundBank::startLoading()
+{
+	if (loader.joinable() || loaded)
+		return;
+
+	loader = std::thread{ &SoundBank::upload, this };
+}
+
+bool SoundBank::isLoaded() const
+{
+	return loaded.load(std::memory_order_acquire);
+}
+
+void SoundBank::finishLoading()
+{
+	if (!loader.joinable() && !loaded)
+		upload();
+
+	if (loader.joinable())
+		loader.join();
+
+	// The samples were copied into the buffers, so the file is not needed anymore
+	file.close();
+}
+
+void SoundBank::upload()
+{
+	std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+
+	// OpenAL calls are thread safe, and alBufferData copies the samples straight from the mapped file
+	for (Clip& clip : clips)
+	{
+		alGenBuffers(1, &clip.buffer);
+		alBufferData(clip.buffer, clip.format, file.getData() + clip.dataOffset,
+			static_cast<ALsizei>(clip.dataSize), static_cast<ALsizei>(clip.sampleRate));
+	}
+
+	uploadMilliseconds = millisecondsSince(start);
+	loaded.store(true, std::memory_order_release);
+}
+
+bool SoundBank::contains(StringID name) const
+{
+	for (const Clip& clip : clips)
+	{
+		if (clip.name == name)
+			return true;
+	}
+	return false;
+}
+
+const std::vector<SoundBank::Clip>& SoundBank::getClips() const
+{
+	return clips;
+}
+
+const std::string& SoundBank::getPath() const
+{
+	return path;
+}
+
+std::uint64_t SoundBank::getDataSize() const
+{
+	return dataSize;
+}
+
+float SoundBank::getOpenMilliseconds() const
+{
+	return openMilliseconds;
+}
+
+float SoundBank::getUploadMilliseconds() const
+{
+	return uploadMilliseconds;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Root/MemoryMappedFile.h>
+#include <Root/StringID.h>
+
+#include <AL/al.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A sound to put in a sound bank.
+ */
+struct SoundBankClip
+{
+	// The path of the sound file, in any format that loadSound() supports
+	std::string path;
+	// The name the sound is loaded under
+	std::string name;
+};
+
+/**
+ * Many sounds packed into one file, as integer PCM samples that can be given to OpenAL as they are.
+ * The file is memory mapped and the sounds are uploaded to OpenAL buffers on a background thread,
+ * so loading a bank costs the main thread almost nothing and needs no decoding.
+ */
+class SoundBank
+{
+public:
+	/**
+	 * A sound in the bank.
+	 */
+	struct Clip
+	{
+		StringID name;
+		std::uint64_t dataOffset;
+		std::uint64_t dataSize;
+		std::uint32_t sampleRate;
+		ALenum format;
+		// The length in seconds
+		float length;
+		// Set when the clip is uploaded
+		ALuint buffer{ 0 };
+	};
+
+	/**
+	 * Decode the given sounds and write them to a sound bank file.
+	 * Meant to be run once when the sounds change, e.g. from a build step, not every time the game starts.
+	 *
+	 * \param clips: the sounds to put in the bank.
+	 * \param bankPath: the path of the bank file to write.
+	 * \returns whether the bank was written.
+	 */
+	static bool cook(const std::vector<SoundBankClip>& clips, const std::string& bankPath);
+
+	/**
+	 * Map a sound bank file and read which sounds it contains.
+	 * The sounds are not uploaded until startLoading() is called.
+	 *
+	 * \param path: the path of the bank file.
+	 * \returns the bank, or nullptr if the file is not a valid sound bank.
+	 */
+	static std::unique_ptr<SoundBank> open(const std::string& path);
+
+	~SoundBank();
+
+	SoundBank(const SoundBank&) = delete;
+	SoundBank& operator=(const SoundBank&) = delete;
+
+	/**
+	 * Start uploading the sounds to OpenAL buffers on a background thread.
+	 */
+	void startLoading();
+
+	/**
+	 * Get whether all sounds were uploaded.
+	 */
+	bool isLoaded() const;
+
+	/**
+	 * Wait until all sounds are uploaded, and close the file.
+	 * Must be called before the buffers of the clips are used.
+	 */
+	void finishLoading();
+
+	/**
+	 * Get whether the bank contains a sound.
+	 *
+	 * \param name: the interned name of the sound.
+	 */
+	bool contains(StringID name) const;
+
+	const std::vector<Clip>& getClips() const;
+
+	const std::string& getPath() const;
+
+	/**
+	 * Get the number of bytes of samples in the bank.
+	 */
+	std::uint64_t getDataSize() const;
+
+	/**
+	 * Get how long opening the bank took, in milliseconds.
+	 */
+	float getOpenMilliseconds() const;
+
+	/**
+	 * Get how long uploading the sounds took on the background thread, in milliseconds.
+	 */
+	float getUploadMilliseconds() const;
+
+private:
+	SoundBank() = default;
+
+	void upload();
+
+	std::string path;
+	MemoryMappedFile file;
+	std::vector<Clip> clips;
+	std::uint64_t dataSize{ 0 };
+
+	std::thread loader;
+	std::atomic<bool> loaded{ false };
+
+	float openMilliseconds{ 0.0f };
+	float uploadMilliseconds{ 0.0f };
+};
@@ -0,0 +1,61 @@
+#include "StringID.h"
+
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+
+namespace StringInterner
+{
+	namespace
+	{
+		// Deque so that references to the strings stay valid when new ones are added
+		std::deque<std::string> strings{ std::string{} };
+		std::unordered_map<std::string, StringID> ids{ { std::string{}, EMPTY_STRING_ID } };
+
+		std::shared_mutex mutex;
+	}
+
+	StringID intern(const std::string& string)
+	{
+		{
+			std::shared_lock<std::shared_mutex> lock{ mutex };
+			auto iterator{ ids.find(string) };
+			if (iterator != ids.end())
+				return iterator->second;
+		}
+
+		std::unique_lock<std::shared_mutex> lock{ mutex };
+
+		// Another thread may have interned the string in the meantime
+		auto iterator{ ids.find(string) };
+		if (iterator != ids.end())
+			return iterator->second;
+
+		StringID id{ static_cast<StringID>(strings.size()) };
+		strings.push_back(string);
+		ids.emplace(string, id);
+		return id;
+	}
+
+	StringID find(const std::string& string)
+	{
+		std::shared_lock<std::shared_mutex> lock{ mutex };
+		auto iterator{ ids.find(string) };
+		return iterator == ids.end() ? INVALID_STRING_ID : iterator->second;
+	}
+
+	const std::string& lookup(StringID id)
+	{
+		std::shared_lock<std::shared_mutex> lock{ mutex };
+		if (id >= strings.size())
+			return strings[EMPTY_STRING_ID];
+		return strings[id];
+	}
+
+	unsigned int getInternedCount()
+	{
+		std::shared_lock<std::shared_mutex> lock{ mutex };
+		return static_cast<unsigned int>(strings.size());
+	}
+};
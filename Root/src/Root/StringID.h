@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/**
+ * Identifier of an interned string.
+ * Two equal strings always map to the same StringID for the lifetime of the program,
+ * so comparing or hashing StringIDs is equivalent to comparing the strings themselves.
+ */
+typedef std::uint32_t StringID;
+
+// The ID of the empty string (""), which is always interned
+#define EMPTY_STRING_ID 0u
+
+// Returned by StringInterner::find() if a string was never interned
+#define INVALID_STRING_ID 0xFFFFFFFFu
+
+namespace StringInterner
+{
+	/**
+	 * Get the ID for a string, interning it if it was not interned before.
+	 * Safe to call from any thread.
+	 *
+	 * \param string: the string to get the ID for.
+	 * \returns the stable ID of the string.
+	 */
+	StringID intern(const std::string& string);
+
+	/**
+	 * Get the ID for a string without interning it.
+	 * Useful for lookups, since a string that was never interned cannot be used by anything.
+	 *
+	 * \param string: the string to get the ID for.
+	 * \returns the ID of the string, or INVALID_STRING_ID if it was never interned.
+	 */
+	StringID find(const std::string& string);
+
+	/**
+	 * Get the string belonging to an ID.
+	 * The returned reference stays valid for the lifetime of the program.
+	 *
+	 * \param id: the ID to get the string for.
+	 * \returns the string with the given ID, or the empty string if the ID is unknown.
+	 */
+	const std::string& lookup(StringID id);
+
+	/**
+	 * Get the number of strings currently interned.
+	 *
+	 * \returns the number of interned strings, including the empty string.
+	 */
+	unsigned int getInternedCount();
+};
@@ -6,6 +6,7 @@ namespace Time
 	{
 		float deltaTime{ 0.0f };
 		float time{ 0.0f };
+		float scaledTime{ 0.0f };
 		float timeScale{ 1.0f };
 	}
 
@@ -13,6 +14,7 @@ namespace Time
 	{
 		deltaTime = (newTime - time) * timeScale;
 		time = newTime;
+		scaledTime += deltaTime;
 	}
 
 	float getTime()
@@ -20,6 +22,11 @@ namespace Time
 		return time;
 	}
 
+	float getScaledTime()
+	{
+		return scaledTime;
+	}
+
 	float getDeltaTime()
 	{
 		return deltaTime;
@@ -16,6 +16,14 @@ namespace Time
 	 */
 	float getTime();
 
+	/**
+	 * Get the number of seconds the game has run, following the time scale.
+	 * This is the sum of all delta times, so it stops while the time scale is 0.
+	 *
+	 * \returns the scaled time.
+	 */
+	float getScaledTime();
+
 	/**
 	 * Get the current deltaTime, which is the number of seconds since the last frame.
 	 *
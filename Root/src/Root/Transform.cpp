@@ -31,6 +31,15 @@ void Transform::destroy()
 	RootEngine::removeTransform(this);
 }
 
+void Transform::setTag(StringID tagID)
+{
+	if (tagID == tag)
+		return;
+
+	RootEngine::updateTransformTag(this, tag, tagID);
+	TransformBase::setTag(tagID);
+}
+
 void Transform::render(float parentRenderDepth, float renderDepthOffset)
 {
 	// Either use own renderdepth
@@ -59,7 +68,7 @@ std::string Transform::toString()
 {
 	std::stringstream stream;
 	// Writing this object to the stream
-	stream << "[Transform] " << name << ", tagged " << tag
+	stream << "[Transform] " << getName() << ", tagged " << getTag()
 		<< "\n > position: (" << position.x << ", " << position.y << ")"
 		<< "\n > rotation: " << rotation
 		<< "\n > scale: (" << scale.x << ", " << scale.y << ")"
@@ -107,6 +107,16 @@ public:
 	 */
 	bool removeChild(Transform* childToRemove);
 
+	using TransformBase::setTag;
+
+	/**
+	 * Set this transform's tag by its interned ID.
+	 * Also keeps the scene's tag lookup up to date.
+	 *
+	 * \param tagID: the ID of the new tag.
+	 */
+	void setTag(StringID tagID) override;
+
 	/**
 	 * Set this transform's render depth.
 	 * The render depth is a scale from 0 (closest) to 10000 (furthest).
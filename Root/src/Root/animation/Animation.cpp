@@ -1,5 +1,7 @@
 #include "Animation.h"
 
+#include <algorithm>
+
 Animation::Animation()
 {
 }
@@ -10,47 +12,45 @@ Animation::~Animation()
 }
 
 bool Animation::update()
+{
+	return update(playback, nullptr);
+}
+
+bool Animation::update(AnimationPlayback& playback, void* target) const
 {
 	// Don't update anything if it's not playing the animation
-	if (!playing)
+	if (!playback.playing)
 		return true;
 
-	animationTime += Time::getDeltaTime() * animationSpeed;
+	playback.time += Time::getDeltaTime() * animationSpeed;
 
 	bool animationFinished{ true };
-	for (std::shared_ptr<ValueAnimationInterface>& valueAnimation : valueAnimations)
+	for (const std::shared_ptr<ValueAnimationInterface>& valueAnimation : valueAnimations)
 	{
 		// If any animation is not yet finished, the full animation cannot be finished
-		if (!valueAnimation->update(animationTime))
+		if (!valueAnimation->update(playback.time, target))
 			animationFinished = false;
 	}
 
-	for (AnimationFunctionAtTime& animationFunctionAtTime : animationFunctions)
+	// Calling the functions whose time has passed, which are the ones after those already called
+	while (playback.calledFunctions < animationFunctions.size()
+		&& playback.time > animationFunctions[playback.calledFunctions].time)
 	{
-		// If it's already called no need to do it again
-		if (animationFunctionAtTime.called)
-			continue;
-
-		// Check if it's time has passed, if it has call the function
-		if (animationTime > animationFunctionAtTime.time)
-		{
-			animationFunctionAtTime.animationFunction->call();
-			animationFunctionAtTime.called = true;
-		}
+		animationFunctions[playback.calledFunctions].animationFunction->call();
+		playback.calledFunctions++;
 	}
 
-
 	// Check whether the animation is finished
 	if (animationFinished)
 	{
 		switch (onAnimationFinish)
 		{
 			case OnAnimationFinish::STOP:
-				stop();
+				playback.playing = false;
 				break;
 
 			case OnAnimationFinish::REPEAT:
-				play();
+				play(playback);
 				break;
 		}
 	}
@@ -60,19 +60,21 @@ bool Animation::update()
 
 void Animation::play()
 {
-	playing = true;
-	animationTime = 0.0f;
+	play(playback);
+}
 
-	// Resetting all animation function call flags
-	for (AnimationFunctionAtTime& animationFunctionAtTime : animationFunctions)
-	{
-		animationFunctionAtTime.called = false;
-	}
+void Animation::play(AnimationPlayback& playback) const
+{
+	playback.playing = true;
+	playback.time = 0.0f;
+
+	// Resetting all animation function calls
+	playback.calledFunctions = 0;
 }
 
 void Animation::stop()
 {
-	this->playing = false;
+	playback.playing = false;
 }
 
 void Animation::addValueAnimation(std::shared_ptr<ValueAnimationInterface> valueAnimation)
@@ -87,8 +89,12 @@ void Animation::setOnFinish(OnAnimationFinish onAnimationFinish)
 
 void Animation::addAnimationFunction(AnimationFunctionCallPointer& animationFunctionPointer, float time)
 {
+	// Keeping the functions sorted by time, so playing the animation only has to look at the next one to call
+	std::vector<AnimationFunctionAtTime>::iterator position{ std::upper_bound(animationFunctions.begin(), animationFunctions.end(), time,
+		[](float time, const AnimationFunctionAtTime& animationFunctionAtTime) { return time < animationFunctionAtTime.time; }) };
+
 	// Putting a pointer to the copied animation function into the object
-	animationFunctions.push_back(AnimationFunctionAtTime {
+	animationFunctions.insert(position, AnimationFunctionAtTime {
 		animationFunctionPointer,
 		time
 	});
@@ -9,6 +9,7 @@
 #include <memory>
 #include <vector>
 #include <sstream>
+#include <cstdint>
 
 enum class OnAnimationFinish
 {
@@ -20,7 +21,19 @@ struct AnimationFunctionAtTime
 {
 	std::shared_ptr<AnimationFunctionCall> animationFunction;
 	float time;
-	bool called{ false };
+};
+
+/**
+ * How far an animation has played.
+ * Kept apart from the animation, so that many animation web instances can play the same animation.
+ */
+struct AnimationPlayback
+{
+	// How long the animation has been going for
+	float time{ 0.0f };
+	// How many animation functions were called, which are the first ones since they are sorted by time
+	std::uint32_t calledFunctions{ 0 };
+	bool playing{ true };
 };
 
 class Animation
@@ -41,11 +54,27 @@ public:
 	 */
 	bool update();
 
+	/**
+	 * Update the value animations of this animation for one of the instances playing it.
+	 * 
+	 * \param playback: how far the instance has played this animation.
+	 * \param target: the object of the instance, changed by value animations that are not bound to an object themselves.
+	 * \returns whether the animation was done.
+	 */
+	bool update(AnimationPlayback& playback, void* target) const;
+
 	/**
 	 * Play this animation.
 	 */
 	void play();
 
+	/**
+	 * Play this animation from the start for one of the instances playing it.
+	 * 
+	 * \param playback: how far the instance has played this animation.
+	 */
+	void play(AnimationPlayback& playback) const;
+
 	/**
 	 * Stop this animation.
 	 */
@@ -85,12 +114,10 @@ private:
 	// Defines what should happen when the animation finishes
 	OnAnimationFinish onAnimationFinish { OnAnimationFinish::REPEAT };
 
-	bool playing{ true };
-
 	// The speed multiplier of this animation
 	float animationSpeed{ 1.0f };
 
-	// How long the animation has been going for
-	float animationTime{ 0.0f };
+	// How far this animation has played when it is updated by itself
+	AnimationPlayback playback;
 };
 
@@ -1,21 +1,81 @@
 #include "AnimationHandler.h"
 
 #include <Root/engine/AnimationHandlerEngine.h>
+#include <Root/Logger.h>
 
 namespace AnimationHandler
 {
 	void addAnimationWeb(AnimationWeb& animationWeb, const std::string& tag)
+	{
+		AnimationHandlerEngine::addAnimationWeb(animationWeb, StringInterner::intern(tag));
+	}
+
+	void addAnimationWeb(AnimationWeb& animationWeb, StringID tag)
 	{
 		AnimationHandlerEngine::addAnimationWeb(animationWeb, tag);
 	}
 
+	void addAnimationWebDefinition(AnimationWeb& animationWeb, const std::string& definitionTag)
+	{
+		AnimationHandlerEngine::addAnimationWebDefinition(animationWeb, StringInterner::intern(definitionTag));
+	}
+
+	bool removeAnimationWebDefinition(const std::string& definitionTag)
+	{
+		// Finding instead of interning, so that unknown tags do not grow the intern table
+		StringID id{ StringInterner::find(definitionTag) };
+		if (id == INVALID_STRING_ID)
+			return false;
+
+		return AnimationHandlerEngine::removeAnimationWebDefinition(id);
+	}
+
+	bool addAnimationWebInstance(const std::string& definitionTag, const std::string& instanceTag, void* target)
+	{
+		return AnimationHandlerEngine::addAnimationWebInstance(
+			StringInterner::intern(definitionTag), StringInterner::intern(instanceTag), target);
+	}
+
 	bool removeAnimationWeb(const std::string& tag)
+	{
+		StringID id{ StringInterner::find(tag) };
+		if (id == INVALID_STRING_ID)
+			return false;
+
+		return AnimationHandlerEngine::removeAnimationWeb(id);
+	}
+
+	bool removeAnimationWeb(StringID tag)
 	{
 		return AnimationHandlerEngine::removeAnimationWeb(tag);
 	}
 
 	void setAnimationWebParameter(const std::string& animationWebTag, const std::string& parameterTag, bool value)
+	{
+		StringID webID{ StringInterner::find(animationWebTag) };
+		if (webID == INVALID_STRING_ID)
+		{
+			Logger::logError("Tried to access animation web with tag that doesn't exist. (" + animationWebTag + ")");
+			return;
+		}
+
+		StringID parameterID{ StringInterner::find(parameterTag) };
+		if (parameterID == INVALID_STRING_ID)
+		{
+			Logger::logError("Tried to set animation web parameter with tag that doesn't exist. (" + parameterTag + ")");
+			return;
+		}
+
+		AnimationHandlerEngine::setAnimationWebParameter(webID, parameterID, value);
+	}
+
+	void setAnimationWebParameter(StringID animationWebTag, StringID parameterTag, bool value)
 	{
 		AnimationHandlerEngine::setAnimationWebParameter(animationWebTag, parameterTag, value);
 	}
+
+	void setMultithreaded(bool multithreaded)
+	{
+		AnimationHandlerEngine::setMultithreaded(multithreaded);
+	}
 }
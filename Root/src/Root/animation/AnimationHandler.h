@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Root/animation/AnimationWeb.h>
+#include <Root/StringID.h>
 
 namespace AnimationHandler
 {
@@ -13,6 +14,44 @@ namespace AnimationHandler
 	 */
 	void addAnimationWeb(AnimationWeb& animationWeb, const std::string& tag);
 
+	/**
+	 * Add an animation web to the handler, identified by an interned tag.
+	 *
+	 * \param animationWeb: the animation web to add.
+	 * Will be copied, so the original instance will not be active.
+	 * \param tag: the interned tag to assign to the animation web.
+	 */
+	void addAnimationWeb(AnimationWeb& animationWeb, StringID tag);
+
+	/**
+	 * Add an animation web that many objects can play, without copying it for each of them.
+	 * Create the objects' instances with addAnimationWebInstance().
+	 * 
+	 * \param animationWeb: the animation web to add. Will be copied and compiled once.
+	 * \param definitionTag: the tag to assign to the definition, which instances are created from.
+	 */
+	void addAnimationWebDefinition(AnimationWeb& animationWeb, const std::string& definitionTag);
+
+	/**
+	 * Remove an animation web definition.
+	 * Instances that were already created from it keep playing.
+	 *
+	 * \param definitionTag: the tag assigned to the definition.
+	 * \returns: true if a definition was found and removed, false otherwise.
+	 */
+	bool removeAnimationWebDefinition(const std::string& definitionTag);
+
+	/**
+	 * Create an instance of an animation web definition, which only stores its own current animation and parameters.
+	 * Remove it with removeAnimationWeb().
+	 * 
+	 * \param definitionTag: the tag of the definition.
+	 * \param instanceTag: the tag to assign to the instance, which it will be identified by in the future.
+	 * \param target: the object whose setters are called by setter value animations created without an instance.
+	 * \returns whether the instance was created.
+	 */
+	bool addAnimationWebInstance(const std::string& definitionTag, const std::string& instanceTag, void* target = nullptr);
+
 	/**
 	 * Remove an animation web from the handler.
 	 *
@@ -21,6 +60,14 @@ namespace AnimationHandler
 	 */
 	bool removeAnimationWeb(const std::string& tag);
 
+	/**
+	 * Remove an animation web from the handler by its interned tag.
+	 *
+	 * \param tag: the interned tag assigned to the animation web.
+	 * \returns: true if an animation web was found and removed, false otherwise.
+	 */
+	bool removeAnimationWeb(StringID tag);
+
 	/**
 	 * Set a bool parameter in a certain animation web.
 	 * 
@@ -29,4 +76,24 @@ namespace AnimationHandler
 	 * \param value: the new value of the parameter.
 	 */
 	void setAnimationWebParameter(const std::string& animationWebTag, const std::string& parameterTag, bool value);
+
+	/**
+	 * Set a bool parameter in a certain animation web using interned tags.
+	 * Prefer this overload when setting parameters every frame.
+	 *
+	 * \param animatorTag: the interned tag of the animation web to set the parameter in.
+	 * \param parameterTag: the interned tag of the parameter to set.
+	 * \param value: the new value of the parameter.
+	 */
+	void setAnimationWebParameter(StringID animationWebTag, StringID parameterTag, bool value);
+
+	/**
+	 * Set whether animation web instances are updated on the worker threads.
+	 * Disabled by default.
+	 * Only enable this when the value animations and animation functions of each instance
+	 * only change the instance's own objects, and nothing that other threads use.
+	 * 
+	 * \param multithreaded: whether to update the instances on the worker threads.
+	 */
+	void setMultithreaded(bool multithreaded);
 };
@@ -11,86 +11,158 @@ AnimationWeb::~AnimationWeb()
 
 void AnimationWeb::update()
 {
-	if (animationsMapChanged)
+	if (!compiled)
+		compile();
+
+	update(ownState);
+}
+
+void AnimationWeb::update(AnimationWebState& state) const
+{
+	if (!compiled)
+		return;
+
+	if (state.currentAnimation == -1)
 	{
-		// Re-get the current animation address
-		if (currentAnimationTag != "")
-		{
-			currentAnimation = &animations[currentAnimationTag];
-			animationsMapChanged = false;
-		}
-		else
+		if (startAnimationIndex == -1)
 		{
 			Logger::logError("No animation set as start animation.");
+			return;
 		}
+		state.currentAnimation = startAnimationIndex;
+		animations[state.currentAnimation].play(state.playback);
 	}
 
-	bool animationDone{ currentAnimation == nullptr ? true : currentAnimation->update() };
+	bool animationDone{ animations[state.currentAnimation].update(state.playback, state.target) };
 
-	// Going to the next animation:
-	for (AnimationLink& link : links)
+	// Going to the next animation, using the first link from the current animation of which all conditions are met
+	const CompiledAnimationLink* link{ compiledLinks.data() + linkStart[state.currentAnimation] };
+	const CompiledAnimationLink* end{ compiledLinks.data() + linkStart[state.currentAnimation + 1] };
+
+	for (; link != end; link++)
 	{
-		// Making sure the link starts from the current animation
-		if (link.tag1 != currentAnimationTag)
+		// Check whether we must wait for the end of the previous animation
+		if (link->waitForEndOfAnimation && !animationDone)
 			continue;
 
-		// Check whether we must wait for the end of the previous animation
-		if (link.waitForEndOfAnimation && !animationDone)
+		// Check all conditions at once
+		if ((state.parameters & link->conditionMask) != link->conditionValues)
 			continue;
 
-		// Check each condition
-		bool allConditionsMet{ true };
-		for (BoolAnimationCondition& condition : link.conditions)
+		// Moving to the next animation, and playing it from the start
+		state.currentAnimation = static_cast<int>(link->target);
+		animations[state.currentAnimation].play(state.playback);
+
+		// Resetting all triggers
+		state.parameters &= ~link->triggerMask;
+		break;
+	}
+}
+
+AnimationWebState AnimationWeb::createState(void* target) const
+{
+	AnimationWebState newState;
+	newState.parameters = initialParameters;
+	newState.target = target;
+	return newState;
+}
+
+bool AnimationWeb::compile()
+{
+	compiledLinks.clear();
+	linkStart.assign(animations.size() + 1, 0);
+
+	// Counting the links from each animation, so they can be placed next to each other
+	std::vector<int> fromIndices(links.size(), -1);
+	std::vector<int> toIndices(links.size(), -1);
+	for (std::size_t i{ 0 }; i < links.size(); i++)
+	{
+		fromIndices[i] = findAnimationIndex(links[i].tag1);
+		toIndices[i] = findAnimationIndex(links[i].tag2);
+
+		if (fromIndices[i] == -1 || toIndices[i] == -1)
 		{
-			if (!evaluateCondition(condition))
-			{
-				allConditionsMet = false;
-				break;
-			}
+			Logger::logError("Animation web has a link between animations that do not exist. ("
+				+ StringInterner::lookup(links[i].tag1) + " to " + StringInterner::lookup(links[i].tag2) + ")");
+			continue;
 		}
 
-		// Not all conditions were met, check the next link
-		if (!allConditionsMet)
-			continue;
+		linkStart[fromIndices[i] + 1]++;
+	}
 
-		// All conditions were met, transition to the next animation
+	for (std::size_t i{ 1 }; i < linkStart.size(); i++)
+	{
+		linkStart[i] += linkStart[i - 1];
+	}
 
-		// Moving to the next animation
-		currentAnimation = &animations[link.tag2];
-		currentAnimationTag = link.tag2;
+	compiledLinks.resize(linkStart.back());
 
-		// Resetting all triggers
-		for (BoolAnimationCondition& condition : link.conditions)
+	// Filling in the links in the order they were created, so they are checked in that order
+	std::vector<std::uint32_t> nextLink(linkStart.begin(), linkStart.end() - 1);
+	for (std::size_t i{ 0 }; i < links.size(); i++)
+	{
+		if (fromIndices[i] == -1 || toIndices[i] == -1)
+			continue;
+
+		CompiledAnimationLink compiledLink{ static_cast<std::uint32_t>(toIndices[i]), links[i].waitForEndOfAnimation, 0, 0, 0 };
+
+		for (const BoolAnimationCondition& condition : links[i].conditions)
 		{
-			if (condition.conditionType == ConditionType::TRIGGER)
+			// Parameters that were never added are false, like before they were compiled
+			if (parameterIndices.find(condition.parameterTag) == parameterIndices.end())
+				addParameter(condition.parameterTag, false);
+
+			int parameterIndex{ getParameterIndex(condition.parameterTag) };
+			if (parameterIndex == -1)
 			{
-				boolParameters[condition.parameterTag] = false;
+				// Not compiling again every update, since it would fail again until the web is changed
+				compiledLinks.clear();
+				linkStart.assign(animations.size() + 1, 0);
+				compiled = true;
+				return false;
 			}
+
+			std::uint64_t bit{ std::uint64_t{ 1 } << parameterIndex };
+			compiledLink.conditionMask |= bit;
+			if (condition.comparative)
+				compiledLink.conditionValues |= bit;
+			if (condition.conditionType == ConditionType::TRIGGER)
+				compiledLink.triggerMask |= bit;
 		}
+
+		compiledLinks[nextLink[fromIndices[i]]++] = compiledLink;
 	}
+
+	compiled = true;
+	return true;
 }
 
 void AnimationWeb::addAnimation(Animation& animation, const std::string& tag, bool startAnimation)
 {
-	animations.emplace(tag, animation);
-	
-	animationsMapChanged = true;
+	StringID tagID{ StringInterner::intern(tag) };
+
+	if (findAnimationIndex(tagID) != -1)
+	{
+		Logger::logWarning("Tried to add an animation with a tag that is already used. (" + tag + ")");
+		return;
+	}
+
+	animations.push_back(animation);
+	animationTags.push_back(tagID);
+	compiled = false;
 	
 	if (startAnimation)
 	{
-		//currentAnimation = &animations[tag];
-		currentAnimationTag = tag;
+		startAnimationIndex = static_cast<int>(animations.size() - 1);
+		ownState.currentAnimation = -1;
 		Logger::log(tag);
 	}
-	else
-	{
-		currentAnimation = nullptr;
-	}
 }
 
 void AnimationWeb::createLink(const std::string& tag1, const std::string& tag2, bool waitForEndOfAnimation)
 {
-	links.emplace_back(AnimationLink{ tag1, tag2, waitForEndOfAnimation });
+	links.emplace_back(AnimationLink{ StringInterner::intern(tag1), StringInterner::intern(tag2), waitForEndOfAnimation });
+	compiled = false;
 }
 
 void AnimationWeb::addConditionToLink(const std::string& tag1,
@@ -99,47 +171,110 @@ void AnimationWeb::addConditionToLink(const std::string& tag1,
 	ConditionType conditionType,
 	bool comparative)
 {
-	AnimationLink* link{ getLinkByTags(tag1, tag2) };
+	AnimationLink* link{ getLinkByTags(StringInterner::intern(tag1), StringInterner::intern(tag2)) };
 
-	link->conditions.push_back(BoolAnimationCondition{ parameterTag, comparative, conditionType });
+	if (link == nullptr)
+	{
+		Logger::logError("Tried to add a condition to a link that doesn't exist. (" + tag1 + " to " + tag2 + ")");
+		return;
+	}
+
+	link->conditions.push_back(BoolAnimationCondition{ StringInterner::intern(parameterTag), comparative, conditionType });
+	compiled = false;
 }
 
 void AnimationWeb::setBool(const std::string& tag, bool value)
 {
-	//std::map<std::string, bool>::iterator iterator{ boolParameters.find(tag) };
+	setBool(StringInterner::intern(tag), value);
+}
+
+void AnimationWeb::setBool(StringID tag, bool value)
+{
+	std::unordered_map<StringID, unsigned int>::iterator iterator{ parameterIndices.find(tag) };
 
 	// Check if a parameter with the given tag exists
-	if (boolParameters.find(tag) == boolParameters.end())
+	if (iterator == parameterIndices.end())
 	{
-		Logger::logError("Tried to access animation web with tag that doesn't exist. (" + tag + ")");
+		Logger::logError("Tried to access animation web with tag that doesn't exist. (" + StringInterner::lookup(tag) + ")");
+		addParameter(tag, value);
+		return;
 	}
 
-	boolParameters[tag] = value;
-	/*
-	else
+	setBoolByIndex(static_cast<int>(iterator->second), value);
+}
+
+void AnimationWeb::setBoolByIndex(int parameterIndex, bool value)
+{
+	setBoolByIndex(ownState, parameterIndex, value);
+}
+
+void AnimationWeb::setBool(AnimationWebState& state, StringID tag, bool value) const
+{
+	int parameterIndex{ getParameterIndex(tag) };
+
+	if (parameterIndex == -1)
 	{
-		iterator->second = value;
-	}*/
+		Logger::logError("Tried to access animation web with tag that doesn't exist. (" + StringInterner::lookup(tag) + ")");
+		return;
+	}
+
+	setBoolByIndex(state, parameterIndex, value);
+}
+
+void AnimationWeb::setBoolByIndex(AnimationWebState& state, int parameterIndex, bool value) const
+{
+	if (parameterIndex < 0 || parameterIndex >= static_cast<int>(parameterTags.size()))
+	{
+		Logger::logError("Tried to access animation web parameter with index that doesn't exist. (" + std::to_string(parameterIndex) + ")");
+		return;
+	}
+
+	std::uint64_t bit{ std::uint64_t{ 1 } << parameterIndex };
+	state.parameters = value ? (state.parameters | bit) : (state.parameters & ~bit);
+}
+
+bool AnimationWeb::getBool(StringID tag) const
+{
+	int parameterIndex{ getParameterIndex(tag) };
+	if (parameterIndex == -1)
+		return false;
+
+	return (ownState.parameters >> parameterIndex) & 1;
 }
 
 void AnimationWeb::addParameter(const std::string& tag, bool initialValue)
 {
-	boolParameters.emplace(tag, initialValue);
+	addParameter(StringInterner::intern(tag), initialValue);
 }
 
-std::vector<AnimationLink> AnimationWeb::getLinksByAnimationTag(const std::string& tag)
+void AnimationWeb::addParameter(StringID tag, bool initialValue)
 {
-	std::vector<AnimationLink> result;
+	if (parameterIndices.find(tag) != parameterIndices.end())
+		return;
 
-	for (AnimationLink& link : links)
+	if (parameterTags.size() >= maxParameters)
 	{
-		if (link.tag1 == tag)
-		{
-			result.push_back(link);
-		}
+		Logger::logError("An animation web can have at most " + std::to_string(maxParameters)
+			+ " parameters. (" + StringInterner::lookup(tag) + ")");
+		return;
 	}
 
-	return result;
+	std::uint64_t bit{ std::uint64_t{ 1 } << parameterTags.size() };
+
+	parameterIndices.emplace(tag, static_cast<unsigned int>(parameterTags.size()));
+	parameterTags.push_back(tag);
+
+	if (initialValue)
+	{
+		initialParameters |= bit;
+		ownState.parameters |= bit;
+	}
+}
+
+int AnimationWeb::getParameterIndex(StringID tag) const
+{
+	std::unordered_map<StringID, unsigned int>::const_iterator iterator{ parameterIndices.find(tag) };
+	return iterator == parameterIndices.end() ? -1 : static_cast<int>(iterator->second);
 }
 
 std::string AnimationWeb::toString()
@@ -147,22 +282,25 @@ std::string AnimationWeb::toString()
 	std::stringstream sstream;
 
 	sstream << "Animation web: \n";
-	sstream << "Active animation: " << (currentAnimationTag == "" ? "None" : currentAnimationTag) << "\n";
+	sstream << "Active animation: " << (ownState.currentAnimation == -1 ? "None" : StringInterner::lookup(animationTags[ownState.currentAnimation])) << "\n";
 	
-	for (std::pair<std::string, Animation> taggedAnimation : animations)
+	for (std::size_t i{ 0 }; i < animations.size(); i++)
 	{
-		const std::string& tag{ taggedAnimation.first };
+		const std::string& tag{ StringInterner::lookup(animationTags[i]) };
 
 		sstream << "Animation: \n";
 		sstream << "Identifying tag: " << tag << "\n";
 
 		// Printing the animations
-		sstream << taggedAnimation.second.functionsToString() << std::endl;
+		sstream << animations[i].functionsToString() << std::endl;
 
 		sstream << "Links:\n";
-		for (AnimationLink& link : getLinksByAnimationTag(tag))
+		for (AnimationLink& link : links)
 		{
-			sstream << "  - " << tag << " to " << link.tag2;
+			if (link.tag1 != animationTags[i])
+				continue;
+
+			sstream << "  - " << tag << " to " << StringInterner::lookup(link.tag2);
 
 			unsigned int conditionIndex{ 0 };
 
@@ -178,7 +316,7 @@ std::string AnimationWeb::toString()
 					sstream << " and ";
 				}
 
-				sstream << condition.parameterTag << " "
+				sstream << StringInterner::lookup(condition.parameterTag) << " "
 					<< ((condition.conditionType == ConditionType::BOOLEAN) ? "(boolean)" : "(trigger)")
 					<< " is " << (condition.comparative ? "true" : "false");
 
@@ -193,7 +331,7 @@ std::string AnimationWeb::toString()
 	return sstream.str();
 }
 
-AnimationLink* AnimationWeb::getLinkByTags(const std::string& tag1, const std::string& tag2)
+AnimationLink* AnimationWeb::getLinkByTags(StringID tag1, StringID tag2)
 {
 	for (AnimationLink& link : links)
 	{
@@ -207,9 +345,13 @@ AnimationLink* AnimationWeb::getLinkByTags(const std::string& tag1, const std::s
 	return nullptr;
 }
 
-bool AnimationWeb::evaluateCondition(BoolAnimationCondition& condition)
+int AnimationWeb::findAnimationIndex(StringID tag) const
 {
-	bool parameterValue{ boolParameters[condition.parameterTag] };
+	for (std::size_t i{ 0 }; i < animationTags.size(); i++)
+	{
+		if (animationTags[i] == tag)
+			return static_cast<int>(i);
+	}
 
-	return condition.comparative == parameterValue;
+	return -1;
 }
@@ -3,11 +3,14 @@
 #include <Root/animation/Animation.h>
 
 #include "Root/Logger.h"
+#include "Root/StringID.h"
 
 #include <memory>
 #include <string>
 #include <sstream>
-#include <map>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
 
 /**
  * The condition type of the animation condition.
@@ -30,21 +33,62 @@ enum class ConditionType
 
 struct BoolAnimationCondition
 {
-	std::string parameterTag;
+	StringID parameterTag;
 	bool comparative;
 	ConditionType conditionType;
 };
 
 struct AnimationLink
 {
-	std::string tag1;
-	std::string tag2;
+	StringID tag1;
+	StringID tag2;
 	bool waitForEndOfAnimation;
 	std::vector<BoolAnimationCondition> conditions;
 };
 
+/**
+ * A link in its compiled form: the animation to go to, and its conditions as bit masks over the parameters.
+ */
+struct CompiledAnimationLink
+{
+	// The index of the animation to go to
+	std::uint32_t target;
+	bool waitForEndOfAnimation;
+	// The parameters this link checks
+	std::uint64_t conditionMask;
+	// What the checked parameters must be equal to
+	std::uint64_t conditionValues;
+	// The parameters to reset to false when this link is used
+	std::uint64_t triggerMask;
+};
+
+/**
+ * Everything that differs between objects playing the same animation web.
+ * Small enough to keep many of them next to each other, and update them all in one loop.
+ */
+struct AnimationWebState
+{
+	// The index of the current animation, -1 if the start animation was not entered yet
+	int currentAnimation{ -1 };
+	// How far the current animation has played
+	AnimationPlayback playback;
+	// The value of each parameter, with the parameter at index i in bit i
+	std::uint64_t parameters{ 0 };
+	// The object whose values are changed by value animations that are not bound to an object themselves
+	void* target{ nullptr };
+};
+
 /**
  * The Animation Web is a class which holds some animations, and any links between them.
+ * 
+ * Webs are built with string tags, and compiled into flat tables before they are updated:
+ * animations are identified by index, the links of each animation are stored next to each other,
+ * and the parameters are packed into the bits of a single integer.
+ * This way updating a web does no string or hash map work and allocates nothing.
+ * 
+ * A compiled web does not change while it is played, so it can be shared by many instances,
+ * which each keep their own AnimationWebState.
+ * Updating the web without a state uses a state of its own.
  */
 class AnimationWeb
 {
@@ -59,6 +103,32 @@ public:
 
 	void update();
 
+	/**
+	 * Update an instance of this web: update its current animation, and follow the first link whose conditions are met.
+	 * The web must be compiled.
+	 * 
+	 * \param state: the state of the instance.
+	 */
+	void update(AnimationWebState& state) const;
+
+	/**
+	 * Create the state of a new instance of this web.
+	 * 
+	 * \param target: the object changed by value animations that are not bound to an object themselves.
+	 * \returns the state, with all parameters at their initial values.
+	 */
+	AnimationWebState createState(void* target = nullptr) const;
+
+	/**
+	 * Freeze the animations, links and parameters into the tables used by update().
+	 * Called automatically by update() after the web was changed,
+	 * but can be called earlier to keep the cost out of the first frame.
+	 * If the web cannot be compiled, it will not leave its current animation until it is changed.
+	 * 
+	 * \returns whether the web could be compiled.
+	 */
+	bool compile();
+
 	/**
 	 * Add an animation.
 	 * 
@@ -103,6 +173,14 @@ public:
 	 */
 	void setBool(const std::string& tag, bool value);
 
+	/**
+	 * Set a boolean parameter by its interned tag.
+	 *
+	 * \param tag: the interned tag with which to identify the parameter.
+	 * \param value: the new value of the parameter.
+	 */
+	void setBool(StringID tag, bool value);
+
 	/**
 	 * Add a parameter to this animator.
 	 * 
@@ -111,6 +189,56 @@ public:
 	 */
 	void addParameter(const std::string& tag, bool initialValue);
 
+	/**
+	 * Add a parameter to this animator by its interned tag.
+	 *
+	 * \param tag: the interned tag the parameter will be identified by.
+	 * \param initialValue: the initial value of the parameter.
+	 */
+	void addParameter(StringID tag, bool initialValue);
+
+	/**
+	 * Get the index of a parameter, which can be used to set it without looking up its tag.
+	 * 
+	 * \param tag: the interned tag of the parameter.
+	 * \returns the index of the parameter, or -1 if it does not exist.
+	 */
+	int getParameterIndex(StringID tag) const;
+
+	/**
+	 * Set a boolean parameter by its index.
+	 * 
+	 * \param parameterIndex: the index of the parameter, as returned by getParameterIndex().
+	 * \param value: the new value of the parameter.
+	 */
+	void setBoolByIndex(int parameterIndex, bool value);
+
+	/**
+	 * Set a boolean parameter of an instance of this web.
+	 *
+	 * \param state: the state of the instance.
+	 * \param tag: the interned tag of the parameter.
+	 * \param value: the new value of the parameter.
+	 */
+	void setBool(AnimationWebState& state, StringID tag, bool value) const;
+
+	/**
+	 * Set a boolean parameter of an instance of this web by its index.
+	 *
+	 * \param state: the state of the instance.
+	 * \param parameterIndex: the index of the parameter, as returned by getParameterIndex().
+	 * \param value: the new value of the parameter.
+	 */
+	void setBoolByIndex(AnimationWebState& state, int parameterIndex, bool value) const;
+
+	/**
+	 * Get the value of a boolean parameter.
+	 *
+	 * \param tag: the interned tag of the parameter.
+	 * \returns the value of the parameter, or false if it does not exist.
+	 */
+	bool getBool(StringID tag) const;
+
 	/**
 	 * Create a human readable string from this animation web.
 	 * 
@@ -120,21 +248,31 @@ public:
 
 private:
 
-	Animation* currentAnimation{ nullptr };
-	std::string currentAnimationTag{};
+	// The maximum number of parameters, which is the number of bits in the parameter mask
+	static const unsigned int maxParameters{ 64 };
 
-	AnimationLink* getLinkByTags(const std::string& tag1, const std::string& tag2);
+	int findAnimationIndex(StringID tag) const;
 
-	std::vector<AnimationLink> getLinksByAnimationTag(const std::string& tag);
+	AnimationLink* getLinkByTags(StringID tag1, StringID tag2);
 
-	bool evaluateCondition(BoolAnimationCondition& condition);
+	// Authoring data, which can be changed at any time and is compiled before the next update
+	std::vector<Animation> animations;
+	std::vector<StringID> animationTags;
+	std::vector<AnimationLink> links;
+	std::vector<StringID> parameterTags;
 
-	// Indicates that the map which contains the animations may have changed,
-	// and so indicates invalidation of the current pointer to the current animation.
-	bool animationsMapChanged{ true };
+	int startAnimationIndex{ -1 };
 
-	std::map<std::string, Animation> animations;
-	std::vector<AnimationLink> links;
-	std::map<std::string, bool> boolParameters;
-};
+	bool compiled{ false };
 
+	// Compiled data: the links from animation i are compiledLinks[linkStart[i]] up to compiledLinks[linkStart[i + 1]]
+	std::vector<std::uint32_t> linkStart;
+	std::vector<CompiledAnimationLink> compiledLinks;
+	std::unordered_map<StringID, unsigned int> parameterIndices;
+
+	// The values the parameters of new instances start with
+	std::uint64_t initialParameters{ 0 };
+
+	// The state used when this web is updated by itself
+	AnimationWebState ownState;
+};
@@ -24,13 +24,24 @@ public:
 	  */
 	static SetterValueAnimation<T, U>* create(Animation* animation, U* instance, void (U::* functionPointer)(T), Gradient<T> gradient);
 
+	/**
+	 * Create a new setter value animation that calls the setter on the target of each animation web instance playing it.
+	 * This way one animation web can be shared by many objects.
+	 * The target is not type checked: every instance playing the animation must have been given a U as its target.
+	 *
+	 * \param animation: what animation this value animation should be added to.
+	 * \param functionPointer: a pointer to the setter function that will be used to update the value.
+	 * \param gradient: the gradient that decides the values that the value will take.
+	 */
+	static SetterValueAnimation<T, U>* create(Animation* animation, void (U::* functionPointer)(T), Gradient<T> gradient);
+
 	~SetterValueAnimation();
 
 	/**
 	 * Update the value of this animation.
 	 * Not to be called by the user.
 	 */
-	virtual bool update(float animationTime) override;
+	virtual bool update(float animationTime, void* target) const override;
 
 	/**
 	 * Set the pointer to the value that will be changed by the animation.
@@ -91,6 +102,12 @@ inline SetterValueAnimation<T, U>* SetterValueAnimation<T, U>::create(Animation*
 	return valueAnimation;
 }
 
+template<class T, class U>
+inline SetterValueAnimation<T, U>* SetterValueAnimation<T, U>::create(Animation* animation, void (U::* functionPointer)(T), Gradient<T> gradient)
+{
+	return create(animation, nullptr, functionPointer, gradient);
+}
+
 template<class T, class U>
 inline SetterValueAnimation<T, U>::~SetterValueAnimation()
 {
@@ -98,14 +115,18 @@ inline SetterValueAnimation<T, U>::~SetterValueAnimation()
 }
 
 template<class T, class U>
-inline bool SetterValueAnimation<T, U>::update(float animationTime)
+inline bool SetterValueAnimation<T, U>::update(float animationTime, void* target) const
 {
 	float usingAnimationTime{ animationTime * animationSpeed };
 
 	T newValue = gradient.sample(usingAnimationTime);
 
-	if (functionPointer != nullptr)
-		(instance->*functionPointer)(newValue);
+	// Animations without an instance of their own change the target of the animation web instance.
+	// Unchecked, the target must be a U (see create()).
+	U* usingInstance{ instance != nullptr ? instance : static_cast<U*>(target) };
+
+	if (functionPointer != nullptr && usingInstance != nullptr)
+		(usingInstance->*functionPointer)(newValue);
 
 	// Return whether the animation is finished
 	return (usingAnimationTime >= duration);
@@ -5,6 +5,8 @@
 
 #include <Root/Gradient.h>
 
+#include <functional>
+
 #define ValueAnimationPointer ValueAnimation<T>*
 
 template <class T>
@@ -13,6 +15,8 @@ class ValueAnimation : public ValueAnimationInterface
 public:
 	/**
 	 * Create a new animation.
+	 * Every animation web instance playing it changes the same value,
+	 * so use the overload with a member pointer for animation webs shared by many objects.
 	 *
 	 * \param animation: what animation this value animation should be added to.
 	 * \param valuePointer: a pointer to the value that will actually be changed.
@@ -20,13 +24,25 @@ public:
 	 */
 	static ValueAnimation<T>* create(Animation* animation, T* valuePointer, Gradient<T> gradient);
 
+	/**
+	 * Create a new animation that changes a member of the target of each animation web instance playing it.
+	 * This way one animation web can be shared by many objects.
+	 * The target is not type checked: every instance playing the animation must have been given a U as its target.
+	 *
+	 * \param animation: what animation this value animation should be added to.
+	 * \param member: a pointer to the member of U that will be changed.
+	 * \param gradient: the gradient that decides the values that the value will take.
+	 */
+	template <class U>
+	static ValueAnimation<T>* create(Animation* animation, T U::* member, Gradient<T> gradient);
+
 	~ValueAnimation();
 
 	/**
 	 * Update the value of this animation.
 	 * Not to be called by the user.
 	 */
-	virtual bool update(float animationTime) override;
+	virtual bool update(float animationTime, void* target) const override;
 
 	/**
 	 * Set the pointer to the value that will be changed by the animation.
@@ -67,6 +83,9 @@ private:
 	Gradient<T> gradient;
 
 	T* value = nullptr;
+
+	// Finds the value in the target of an animation web instance, for animations without a value pointer
+	std::function<T*(void*)> targetValue;
 };
 
 template<class T>
@@ -86,6 +105,15 @@ inline ValueAnimation<T>* ValueAnimation<T>::create(Animation* animation, T* val
 	return valueAnimation;
 }
 
+template<class T>
+template<class U>
+inline ValueAnimation<T>* ValueAnimation<T>::create(Animation* animation, T U::* member, Gradient<T> gradient)
+{
+	ValueAnimation<T>* valueAnimation = create(animation, nullptr, gradient);
+	valueAnimation->targetValue = [member](void* target) { return &(static_cast<U*>(target)->*member); };
+	return valueAnimation;
+}
+
 template<class T>
 inline ValueAnimation<T>::~ValueAnimation()
 {
@@ -93,14 +121,17 @@ inline ValueAnimation<T>::~ValueAnimation()
 }
 
 template<class T>
-inline bool ValueAnimation<T>::update(float animationTime)
+inline bool ValueAnimation<T>::update(float animationTime, void* target) const
 {
 	float usingAnimationTime{ animationTime * animationSpeed };
 
-	float newValue = gradient.sample(usingAnimationTime);
+	T newValue = gradient.sample(usingAnimationTime);
 
 	if (value != nullptr)
 		(*value) = newValue;
+	// Animations without a value pointer change the target of the animation web instance
+	else if (targetValue && target != nullptr)
+		(*targetValue(target)) = newValue;
 
 	// Return whether the animation is finished
 	return (usingAnimationTime >= duration);
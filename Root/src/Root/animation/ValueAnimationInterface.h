@@ -11,8 +11,12 @@ public:
 	 * Update the value of this animation.
 	 * Not to be called by the user.
 	 * 
+	 * \param animationTime: how long the animation has been playing.
+	 * \param target: the object of the animation web instance that is playing the animation, or nullptr.
 	 * \returns whether the value animation is done.
 	 */
-	virtual bool update(float animationTime) { return false; }
+	virtual bool update(float animationTime, void* target) const { return false; }
+
+	virtual ~ValueAnimationInterface() = default;
 };
 
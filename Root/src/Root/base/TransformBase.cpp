@@ -88,7 +88,7 @@ std::string TransformBase::toString()
 {
 	std::stringstream stream;
 	// Writing this object to the stream
-	stream << "[Transform] " << name << ", tagged " << tag
+	stream << "[Transform] " << getName() << ", tagged " << getTag()
 		<< "\n > position: (" << position.x << ", " << position.y << ")"
 		<< "\n > rotation: " << rotation
 		<< "\n > scale: (" << scale.x << ", " << scale.y << ")"
@@ -121,22 +121,42 @@ void TransformBase::setParent(TransformBase* parent, bool alsoAddChild)
 		parent->addChild(this, false);
 }
 
-void TransformBase::setName(std::string name)
+void TransformBase::setName(const std::string& name)
 {
-	this->name = name;
+	setName(StringInterner::intern(name));
 }
 
-std::string TransformBase::getName()
+void TransformBase::setName(StringID nameID)
+{
+	this->name = nameID;
+}
+
+const std::string& TransformBase::getName()
+{
+	return StringInterner::lookup(name);
+}
+
+StringID TransformBase::getNameID()
 {
 	return name;
 }
 
-void TransformBase::setTag(std::string tag)
+void TransformBase::setTag(const std::string& tag)
+{
+	setTag(StringInterner::intern(tag));
+}
+
+void TransformBase::setTag(StringID tagID)
+{
+	this->tag = tagID;
+}
+
+const std::string& TransformBase::getTag()
 {
-	this->tag = tag;
+	return StringInterner::lookup(tag);
 }
 
-std::string TransformBase::getTag()
+StringID TransformBase::getTagID()
 {
 	return tag;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Root/Logger.h"
+#include "Root/StringID.h"
 
 #include <glm/glm.hpp>
 #include <glm/trigonometric.hpp>
@@ -56,7 +57,14 @@ public:
 	 *
 	 * \param name: the new name.
 	 */
-	void setName(std::string name);
+	void setName(const std::string& name);
+
+	/**
+	 * Set this transform's name by its interned ID.
+	 *
+	 * \param nameID: the ID of the new name.
+	 */
+	void setName(StringID nameID);
 
 	/**
 	 * Get this transform's name.
@@ -64,7 +72,14 @@ public:
 	 *
 	 * \returns name: the name.
 	 */
-	std::string getName();
+	const std::string& getName();
+
+	/**
+	 * Get the interned ID of this transform's name.
+	 *
+	 * \returns the ID of the name.
+	 */
+	StringID getNameID();
 
 	/**
 	 * Set this transform's tag.
@@ -72,7 +87,14 @@ public:
 	 *
 	 * \param tag: the new tag.
 	 */
-	void setTag(std::string tag);
+	void setTag(const std::string& tag);
+
+	/**
+	 * Set this transform's tag by its interned ID.
+	 *
+	 * \param tagID: the ID of the new tag.
+	 */
+	virtual void setTag(StringID tagID);
 
 	/**
 	 * Get this transform's tag.
@@ -80,7 +102,15 @@ public:
 	 *
 	 * \returns tag: the tag.
 	 */
-	std::string getTag();
+	const std::string& getTag();
+
+	/**
+	 * Get the interned ID of this transform's tag.
+	 * Comparing tag IDs is equivalent to, but much cheaper than, comparing the tags.
+	 *
+	 * \returns the ID of the tag.
+	 */
+	StringID getTagID();
 
 	/**
 	 * Get the parent of this transform.
@@ -317,8 +347,8 @@ protected:
 	float rotation;
 	glm::vec2 scale;
 
-	std::string name{};
-	std::string tag{};
+	StringID name{ EMPTY_STRING_ID };
+	StringID tag{ EMPTY_STRING_ID };
 
 	// Flag that when set, causes the transform matrices to be updated
 	bool transformUpdated{ true };
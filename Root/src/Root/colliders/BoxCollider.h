@@ -40,8 +40,6 @@ public:
 
 	const virtual std::vector<b2Shape*> getShapes() override;
 
-	void renderDebugView() override;
-
 private:
 
 	/**
@@ -68,8 +66,6 @@ private:
 		glm::vec2 offset,
 		float rotation);
 
-	void generateDebugVAO();
-
 	float width;
 	float height;
 
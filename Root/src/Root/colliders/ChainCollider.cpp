@@ -35,19 +35,6 @@ ChainCollider::~ChainCollider()
 	Logger::destructorMessage("Polygon collider");
 }
 
-void ChainCollider::renderDebugView()
-{
-	if (debugVAO == 0)
-	{
-		generateDebugVAO();
-	}
-	glBindVertexArray(debugVAO);
-
-	glDrawArrays(GL_LINE, 0, points.size());
-
-	glBindVertexArray(0);
-}
-
 void ChainCollider::setPoints(std::vector<glm::vec2>& points)
 {
 	unsigned int pointCount = points.size();
@@ -84,32 +71,3 @@ const std::vector<b2Shape*> ChainCollider::getShapes()
 
 	return std::vector<b2Shape*> { shape };
 }
-
-void ChainCollider::generateDebugVAO()
-{
-	// Creating the VAO
-
-	unsigned int VBO;
-
-	// Generating the required objects
-	glGenVertexArrays(1, &debugVAO);
-	glGenBuffers(1, &VBO);
-
-	// Making sure everything gets put on this specific VAO
-	glBindVertexArray(debugVAO);
-
-	// Binding the buffers
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-	// Putting the vertices into the buffer
-	glBufferData(GL_ARRAY_BUFFER, points.size() * sizeof(glm::vec2), points.data(), GL_STATIC_DRAW);
-
-	// Letting OpenGL know how to interpret the data:
-	// 2 floats for position
-	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-
-	// Unbinding
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
-}
@@ -37,8 +37,6 @@ public:
 
 	const virtual std::vector<b2Shape*> getShapes() override;
 
-	void renderDebugView() override;
-
 private:
 
 	/**
@@ -72,8 +70,6 @@ private:
 	 */
 	void setPoints(std::vector<glm::vec2>& points);
 
-	void generateDebugVAO();
-
 	// The points that make up this collider
 	std::vector<glm::vec2> points;
 
@@ -37,8 +37,6 @@ public:
 
 	const virtual std::vector<b2Shape*> getShapes() override;
 
-	void renderDebugView() override;
-
 private:
 
 	/**
@@ -62,13 +60,9 @@ private:
 		float friction,
 		glm::vec2 offset);
 
-	void generateDebugVAO();
-
 	float radius;
 	glm::vec2 offset;
 
-	unsigned int debugResolution{ 12 };
-
 	b2CircleShape* shape{ nullptr };
 };
 
@@ -10,9 +10,12 @@
 #include <glm/glm.hpp>
 
 #include <vector>
+#include <memory>
 
 #define ColliderPointer std::shared_ptr<Collider>
 
+class Rigidbody;
+
 /**
  * How to use layers:
  *
@@ -53,14 +56,15 @@ class Collider
 {
 public:
 
-	~Collider()
-	{
-		glDeleteVertexArrays(1, &debugVAO);
-	}
-
 	const virtual std::vector<b2Shape*> getShapes() { return std::vector<b2Shape*>(); }
 
-	virtual void renderDebugView() { }
+	/**
+	 * Called every frame by the rigidbody this collider is attached to,
+	 * for colliders whose shapes change at runtime.
+	 *
+	 * \param rigidbody: the rigidbody this collider is attached to.
+	 */
+	virtual void update(Rigidbody& rigidbody) {}
 
 	LayerMask getSelfLayerMask()
 	{
@@ -90,8 +94,6 @@ protected:
 	LayerMask selfLayerMask;
 	LayerMask interactionLayerMask;
 
-	unsigned int debugVAO{ 0 };
-
 	float density;
 	float friction;
 	bool sensor;
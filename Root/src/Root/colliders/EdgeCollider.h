@@ -36,8 +36,6 @@ public:
 
 	const virtual std::vector<b2Shape*> getShapes() override;
 
-	void renderDebugView() override;
-
 private:
 
 	/**
@@ -59,8 +57,6 @@ private:
 		float density,
 		float friction);
 
-	void generateDebugVAO();
-
 	// The points that make up this collider
 	glm::vec2 point1;
 	glm::vec2 point2;
@@ -7,6 +7,7 @@
 #include <box2d/b2_chain_shape.h>
 
 #include <vector>
+#include <memory>
 
 class LoopCollider : public Collider
 {
@@ -39,8 +40,6 @@ public:
 
 	const virtual std::vector<b2Shape*> getShapes() override;
 
-	void renderDebugView() override;
-
 	/**
 	 * Set the inversion of the collider.
 	 *
@@ -80,8 +79,6 @@ private:
 		float density,
 		float friction);
 
-	void generateDebugVAO();
-
 	// The points that make up this collider
 	std::vector<glm::vec2> points;
 
@@ -37,8 +37,6 @@ public:
 
 	const virtual std::vector<b2Shape*> getShapes() override;
 
-	void renderDebugView() override;
-
 	/**
 	 * Set the inversion of the collider.
 	 *
@@ -76,8 +74,6 @@ private:
 	 */
 	void setPoints(std::vector<glm::vec2>& points);
 
-	void generateDebugVAO();
-
 	// The points that make up this collider (CCW)
 	std::vector<glm::vec2> points;
 
@@ -1,5 +1,9 @@
 #include "TileGridCollider.h"
 
+#include <Root/components/Rigidbody.h>
+
+#include <box2d/b2_world.h>
+
 std::shared_ptr<Collider> TileGridCollider::create(
 	TileGrid* tileGrid,
 	LayerMask selfLayerMask,
@@ -38,22 +42,17 @@ TileGridCollider::TileGridCollider(
 	updateWithTileGrid(tileGrid, collisionType, layerIndex);
 }
 
-bool TileGridCollider::isEmpty(TileGrid* tileGrid,
-	unsigned int layerIndex,
-	glm::ivec2 sample)
+void TileGridCollider::updateSolidMask(glm::ivec2 min, glm::ivec2 max)
 {
-	if (sample.x >= tileGrid->tileGridSize.x || sample.x < 0 || sample.y >= tileGrid->tileGridSize.y || sample.y < 0)
+	const TileLayer& layer{ tileGrid->layers[layerIndex] };
+
+	for (int y{ min.y }; y <= max.y; y++)
 	{
-		return true;
+		for (int x{ min.x }; x <= max.x; x++)
+		{
+			solidMask[(x + 1) + (y + 1) * (gridSize.x + 2)] = layer.getTile(glm::ivec2(x, y)) != -1;
+		}
 	}
-
-	// The 1D index of the square to check
-	unsigned int sampleIndex
-		= sample.x
-		+ sample.y * tileGrid->tileGridSize.x
-		+ layerIndex * tileGrid->tileGridSize.x * tileGrid->tileGridSize.y;
-
-	return tileGrid->tileIndices[sampleIndex] == -1;
 }
 
 glm::vec2 TileGridCollider::getPointFromSquare(TileGrid* tileGrid, glm::ivec2 square, Direction directionMoving)
@@ -85,16 +84,44 @@ glm::vec2 TileGridCollider::getPointFromSquare(TileGrid* tileGrid, glm::ivec2 sq
 	return glm::vec2(0.0f);
 }
 
-void removeValue(std::vector<glm::ivec2>& vec, glm::ivec2 v)
+namespace
 {
-	for (unsigned int i{ 0 }; i < vec.size(); i++)
+	/**
+	 * Remove the points that lie on a straight line between their neighbours,
+	 * so that long runs of tiles become a single edge.
+	 */
+	void removeCollinearPoints(std::vector<glm::vec2>& points)
 	{
-		if (vec[i] == v)
+		unsigned int pointCount = points.size();
+
+		if (pointCount < 3)
+			return;
+
+		std::vector<glm::vec2> simplified;
+		simplified.reserve(pointCount);
+
+		for (unsigned int i{ 0 }; i < pointCount; i++)
 		{
-			vec.erase(vec.begin() + i);
+			const glm::vec2& previous = points[(i + pointCount - 1) % pointCount];
+			const glm::vec2& point = points[i];
+			const glm::vec2& next = points[(i + 1) % pointCount];
+
+			// All edges are axis aligned, so collinear points share an x or y coordinate
+			bool collinear = (previous.x == point.x && point.x == next.x)
+				|| (previous.y == point.y && point.y == next.y);
+
+			if (!collinear)
+				simplified.push_back(point);
 		}
+
+		points.swap(simplified);
+	}
+
+	bool rangesOverlap(glm::ivec2 minA, glm::ivec2 maxA, glm::ivec2 minB, glm::ivec2 maxB)
+	{
+		return minA.x <= maxB.x && maxA.x >= minB.x
+			&& minA.y <= maxB.y && maxA.y >= minB.y;
 	}
-	return;
 }
 
 void TileGridCollider::updateWithTileGrid(
@@ -108,187 +135,344 @@ void TileGridCollider::updateWithTileGrid(
 		Logger::logError("The layer index " + std::to_string(layerIndex)
 			+ "is an invalid value for the tile grid with "
 			+ std::to_string(tileGrid->layerCount) + " layers.");
+		return;
 	}
 
+	this->tileGrid = tileGrid;
+	this->collisionType = collisionType;
+	this->layerIndex = layerIndex;
+	gridSize = tileGrid->getGridSize();
+
 	// Clearing any previous data
-	loopColliders.clear();
+	loops.clear();
+	freeLoopSlots.clear();
+	solidMask.assign((gridSize.x + 2) * (gridSize.y + 2), false);
+	topEdgeLoops.assign(gridSize.x * gridSize.y, -1);
+
+	// Remembering the state of every chunk, so that only changes after this are regenerated
+	unsigned int chunksPerLayer = tileGrid->chunkCount.x * tileGrid->chunkCount.y;
+	chunkRevisions.assign(
+		tileGrid->chunkRevisions.begin() + layerIndex * chunksPerLayer,
+		tileGrid->chunkRevisions.begin() + (layerIndex + 1) * chunksPerLayer);
+	gridRevision = tileGrid->revision;
+
+	if (gridSize.x <= 0 || gridSize.y <= 0)
+	{
+		updateShapes();
+		return;
+	}
+
+	updateSolidMask(glm::ivec2(0), gridSize - 1);
+
+	std::vector<b2Shape*> addedShapes;
+	traceRange(glm::ivec2(0), gridSize - 1, addedShapes);
+
+	updateShapes();
+}
 
-	// Retrieving grid data
-	int* gridData = tileGrid->getData();
-	glm::ivec2 gridSize = tileGrid->getGridSize();
+void TileGridCollider::update(Rigidbody& rigidbody)
+{
+	if (tileGrid == nullptr || tileGrid->revision == gridRevision)
+		return;
+
+	updateChangedTiles(&rigidbody);
+}
+
+unsigned int TileGridCollider::updateChangedTiles(Rigidbody* rigidbody)
+{
+	if (tileGrid == nullptr)
+		return 0;
+
+	// The fixtures cannot be replaced while the world is stepping.
+	// Nothing is changed yet, so the same chunks are found again on the next update.
+	if (rigidbody != nullptr && rigidbody->getBody()->GetWorld()->IsLocked())
+		return 0;
 
+	gridRevision = tileGrid->revision;
 
-	// First, we find all squares on the grid for which
-	// the square above is not a grid tile (empty or out of bounds)
-	std::vector<glm::ivec2> squaresWithEmptyAbove;
+	glm::ivec2 chunkCount = tileGrid->chunkCount;
+	unsigned int chunksPerLayer = chunkCount.x * chunkCount.y;
 
-	for (unsigned int y{ 0 }; y < gridSize.y; y++)
+	// Finding the chunks that changed, and bringing the solid mask up to date for them
+	std::vector<glm::ivec2> dirtyMin;
+	std::vector<glm::ivec2> dirtyMax;
+
+	for (unsigned int i{ 0 }; i < chunksPerLayer; i++)
 	{
-		for (unsigned int x{ 0 }; x < gridSize.x; x++)
+		unsigned int revision = tileGrid->chunkRevisions[layerIndex * chunksPerLayer + i];
+
+		if (revision == chunkRevisions[i])
+			continue;
+
+		chunkRevisions[i] = revision;
+
+		glm::ivec2 chunkMin = glm::ivec2(i % chunkCount.x, i / chunkCount.x) * TILE_GRID_CHUNK_SIZE;
+		glm::ivec2 chunkMax = glm::min(chunkMin + TILE_GRID_CHUNK_SIZE - 1, gridSize - 1);
+
+		updateSolidMask(chunkMin, chunkMax);
+
+		// Squares next to the chunk can gain or lose edges as well
+		dirtyMin.push_back(glm::max(chunkMin - 1, glm::ivec2(0)));
+		dirtyMax.push_back(glm::min(chunkMax + 1, gridSize - 1));
+	}
+
+	if (dirtyMin.empty())
+		return 0;
+
+	// Removing every loop that goes around or along a changed square.
+	// The other loops cannot have changed, since none of the squares they depend on did.
+	std::vector<std::shared_ptr<LoopCollider>> removedLoops;
+	std::vector<b2Shape*> removedShapes;
+
+	std::vector<glm::ivec2> searchMin{ dirtyMin };
+	std::vector<glm::ivec2> searchMax{ dirtyMax };
+
+	for (unsigned int slot{ 0 }; slot < loops.size(); slot++)
+	{
+		TileLoop& loop = loops[slot];
+
+		if (loop.collider == nullptr)
+			continue;
+
+		bool affected = false;
+		for (unsigned int i{ 0 }; i < dirtyMin.size() && !affected; i++)
+		{
+			affected = rangesOverlap(loop.min - 1, loop.max + 1, dirtyMin[i], dirtyMax[i]);
+		}
+
+		if (!affected)
+			continue;
+
+		// Releasing the top edges of the loop so that they are traced again
+		for (int y{ loop.min.y }; y <= loop.max.y; y++)
 		{
-			// This space must not be empty and the space above it must be
-			if (!isEmpty(tileGrid, layerIndex, glm::ivec2(x, y)) &&
-				isEmpty(tileGrid, layerIndex, glm::ivec2(x, y+1)))
+			for (int x{ loop.min.x }; x <= loop.max.x; x++)
 			{
-				squaresWithEmptyAbove.push_back(glm::ivec2(x, y));
+				int& owner = topEdgeLoops[x + y * gridSize.x];
+				if (owner == (int)slot)
+					owner = -1;
 			}
 		}
+
+		searchMin.push_back(loop.min);
+		searchMax.push_back(loop.max);
+
+		for (b2Shape* shape : loop.collider->getShapes())
+		{
+			removedShapes.push_back(shape);
+		}
+
+		// Keeping the collider alive until its fixtures are gone
+		removedLoops.push_back(loop.collider);
+		loop.collider = nullptr;
+		freeLoopSlots.push_back(slot);
 	}
 
-	// While there are squares left with empty above them,
-	// loop around them and remove the current and any we come across.
-	while (squaresWithEmptyAbove.size() != 0)
+	// Tracing the new loops, starting from any released or changed top edge
+	std::vector<b2Shape*> addedShapes;
+	for (unsigned int i{ 0 }; i < searchMin.size(); i++)
 	{
-		glm::ivec2 currentSquare = squaresWithEmptyAbove[0];
+		traceRange(searchMin[i], searchMax[i], addedShapes);
+	}
 
-		glm::vec2 startPoint = getPointFromSquare(tileGrid, currentSquare, Direction::UP);
+	if (rigidbody != nullptr)
+	{
+		rigidbody->replaceColliderShapes(*this, removedShapes, addedShapes);
+	}
 
-		std::vector<glm::vec2> points;
+	updateShapes();
 
-		// Add the top left point
-		points.push_back(startPoint);
+	return removedLoops.size();
+}
 
-		Direction directionMoving = Direction::RIGHT;
+void TileGridCollider::traceRange(glm::ivec2 min, glm::ivec2 max, std::vector<b2Shape*>& addedShapes)
+{
+	// Every square with an empty square above it starts a loop, unless a loop already went along it
+	for (int y{ min.y }; y <= max.y; y++)
+	{
+		for (int x{ min.x }; x <= max.x; x++)
+		{
+			glm::ivec2 square{ x, y };
 
-		while (true)
+			if (isSolid(square) &&
+				!isSolid(square + glm::ivec2(0, 1)) &&
+				topEdgeLoops[x + y * gridSize.x] == -1)
+			{
+				traceLoop(square, addedShapes);
+			}
+		}
+	}
+}
+
+void TileGridCollider::traceLoop(glm::ivec2 startSquare, std::vector<b2Shape*>& addedShapes)
+{
+	// Finding a slot for the loop
+	int slot;
+	if (freeLoopSlots.empty())
+	{
+		slot = loops.size();
+		loops.emplace_back();
+	}
+	else
+	{
+		slot = freeLoopSlots.back();
+		freeLoopSlots.pop_back();
+	}
+
+	glm::ivec2 currentSquare = startSquare;
+	glm::ivec2 min = startSquare;
+	glm::ivec2 max = startSquare;
+
+	std::vector<glm::vec2> points;
+
+	Direction directionMoving = Direction::RIGHT;
+
+	// The loop is done when we are back on the top edge of the start square.
+	// Comparing the square and direction instead of the point makes the loop the same wherever it starts,
+	// even when it touches itself at a corner.
+	do
+	{
+		// Moving right means walking along the top edge of this square, so it belongs to this loop.
+		// Other squares can be passed at a corner while their top edge belongs to another loop.
+		if (directionMoving == Direction::RIGHT)
 		{
-			// First we add the point
-			glm::vec2 point = getPointFromSquare(tileGrid, currentSquare, directionMoving);
+			topEdgeLoops[currentSquare.x + currentSquare.y * gridSize.x] = slot;
+		}
 
-			// Check if we have arrived back at the beginning
-			if (point == startPoint) break;
+		min = glm::min(min, currentSquare);
+		max = glm::max(max, currentSquare);
 
-			points.push_back(point);
+		// First we add the point
+		points.push_back(getPointFromSquare(tileGrid, currentSquare, directionMoving));
 
-			// This space must not be empty and the space above it must be to remove it from the list
-			if (!isEmpty(tileGrid, layerIndex, currentSquare) &&
-				isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(0, 1)))
+		// Then we check if we can move
+		switch (directionMoving)
+		{
+			case Direction::UP:
 			{
-				removeValue(squaresWithEmptyAbove, currentSquare);
-			}
+				bool upEmpty = !isSolid(currentSquare + glm::ivec2(0, 1));
+				bool upLeftEmpty = !isSolid(currentSquare + glm::ivec2(-1, 1));
 
-			// Then we check if we can move
-			switch (directionMoving)
-			{
-				case Direction::UP:
+				// Check for movable:
+				if (upEmpty)
 				{
-					bool upEmpty = isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(0, 1));
-					bool upLeftEmpty = isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(-1, 1));
-
-					// Check for movable:
-					if (upEmpty)
-					{
-						// Found an upper left corner, rotate right
-						directionMoving = Direction::RIGHT;
-						break;
-					}
-					if (upLeftEmpty)
-					{
-						// Found a straight edge, just keep going
-						currentSquare += glm::ivec2(0, 1);
-						break;
-					}
-					// Found a corner, rotate left
-					directionMoving = Direction::LEFT;
-					// Moving to top left
-					currentSquare += glm::ivec2(-1, 1);
+					// Found an upper left corner, rotate right
+					directionMoving = Direction::RIGHT;
 					break;
 				}
+				if (upLeftEmpty)
+				{
+					// Found a straight edge, just keep going
+					currentSquare += glm::ivec2(0, 1);
+					break;
+				}
+				// Found a corner, rotate left
+				directionMoving = Direction::LEFT;
+				// Moving to top left
+				currentSquare += glm::ivec2(-1, 1);
+				break;
+			}
 
 
-				case Direction::RIGHT:
+			case Direction::RIGHT:
+			{
+				bool rightEmpty = !isSolid(currentSquare + glm::ivec2(1, 0));
+				bool upRightEmpty = !isSolid(currentSquare + glm::ivec2(1, 1));
+
+				// Check for movable:
+				if (rightEmpty)
 				{
-					bool rightEmpty = isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(1, 0));
-					bool upRightEmpty = isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(1, 1));
-
-					// Check for movable:
-					if (rightEmpty)
-					{
-						// Found an upper right corner, rotate right
-						directionMoving = Direction::DOWN;
-						break;
-					}
-					if (upRightEmpty)
-					{
-						// Found a straight edge, just keep going
-						currentSquare += glm::ivec2(1, 0);
-						break;
-					}
-					// Found a corner, rotate left
-					directionMoving = Direction::UP;
-					// Moving to top right
-					currentSquare += glm::ivec2(1, 1);
+					// Found an upper right corner, rotate right
+					directionMoving = Direction::DOWN;
+					break;
+				}
+				if (upRightEmpty)
+				{
+					// Found a straight edge, just keep going
+					currentSquare += glm::ivec2(1, 0);
 					break;
 				}
+				// Found a corner, rotate left
+				directionMoving = Direction::UP;
+				// Moving to top right
+				currentSquare += glm::ivec2(1, 1);
+				break;
+			}
+
 
+			case Direction::DOWN:
+			{
+				bool downEmpty = !isSolid(currentSquare + glm::ivec2(0, -1));
+				bool downRightEmpty = !isSolid(currentSquare + glm::ivec2(1, -1));
 
-				case Direction::DOWN:
+				// Check for movable:
+				if (downEmpty)
 				{
-					bool downEmpty = isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(0, -1));
-					bool downRightEmpty = isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(1, -1));
-
-					// Check for movable:
-					if (downEmpty)
-					{
-						// Found an bottom right corner, rotate right
-						directionMoving = Direction::LEFT;
-						break;
-					}
-					if (downRightEmpty)
-					{
-						// Found a straight edge, just keep going
-						currentSquare += glm::ivec2(0, -1);
-						break;
-					}
-					// Found a corner, rotate left
-					directionMoving = Direction::RIGHT;
-					// Moving to bottom right
-					currentSquare += glm::ivec2(1, -1);
+					// Found an bottom right corner, rotate right
+					directionMoving = Direction::LEFT;
+					break;
+				}
+				if (downRightEmpty)
+				{
+					// Found a straight edge, just keep going
+					currentSquare += glm::ivec2(0, -1);
 					break;
 				}
+				// Found a corner, rotate left
+				directionMoving = Direction::RIGHT;
+				// Moving to bottom right
+				currentSquare += glm::ivec2(1, -1);
+				break;
+			}
+
 
+			case Direction::LEFT:
+			{
+				bool leftEmpty = !isSolid(currentSquare + glm::ivec2(-1, 0));
+				bool downLeftEmpty = !isSolid(currentSquare + glm::ivec2(-1, -1));
 
-				case Direction::LEFT:
+				// Check for movable:
+				if (leftEmpty)
 				{
-					bool leftEmpty = isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(-1, 0));
-					bool downLeftEmpty = isEmpty(tileGrid, layerIndex, currentSquare + glm::ivec2(-1, -1));
-
-					// Check for movable:
-					if (leftEmpty)
-					{
-						// Found an bottom right corner, rotate right
-						directionMoving = Direction::UP;
-						break;
-					}
-					if (downLeftEmpty)
-					{
-						// Found a straight edge, just keep going
-						currentSquare += glm::ivec2(-1, 0);
-						break;
-					}
-					// Found a corner, rotate left
-					directionMoving = Direction::DOWN;
-					// Moving to bottom left
-					currentSquare += glm::ivec2(-1, -1);
+					// Found an bottom right corner, rotate right
+					directionMoving = Direction::UP;
+					break;
+				}
+				if (downLeftEmpty)
+				{
+					// Found a straight edge, just keep going
+					currentSquare += glm::ivec2(-1, 0);
 					break;
 				}
+				// Found a corner, rotate left
+				directionMoving = Direction::DOWN;
+				// Moving to bottom left
+				currentSquare += glm::ivec2(-1, -1);
+				break;
 			}
 		}
-
-		// The collision should be inverted when using INSIDE collision mode
-		std::shared_ptr<LoopCollider> loopCollider
-			= std::static_pointer_cast<LoopCollider>(
-				LoopCollider::create(points,
-					selfLayerMask,
-					interactionLayerMask,
-					collisionType == CollisionType::INSIDE,
-					this->isSensor(),
-					this->getDensity(),
-					this->getFriction()));
-
-		loopColliders.push_back(loopCollider);
+	} while (currentSquare != startSquare || directionMoving != Direction::RIGHT);
+
+	// Box2D gets one edge per straight run instead of one per tile
+	removeCollinearPoints(points);
+
+	// The collision should be inverted when using INSIDE collision mode
+	std::shared_ptr<LoopCollider> loopCollider
+		= std::static_pointer_cast<LoopCollider>(
+			LoopCollider::create(points,
+				selfLayerMask,
+				interactionLayerMask,
+				collisionType == CollisionType::INSIDE,
+				this->isSensor(),
+				this->getDensity(),
+				this->getFriction()));
+
+	for (b2Shape* shape : loopCollider->getShapes())
+	{
+		addedShapes.push_back(shape);
 	}
-	updateShapes();
+
+	loops[slot] = TileLoop{ loopCollider, min, max };
 }
 
 TileGridCollider::~TileGridCollider()
@@ -301,29 +485,16 @@ const std::vector<b2Shape*> TileGridCollider::getShapes()
 	return shapes;
 }
 
-void TileGridCollider::renderDebugView()
-{
-	for (std::shared_ptr<LoopCollider>& loopCollider : loopColliders)
-	{
-		loopCollider->renderDebugView();
-	}
-}
-
-void TileGridCollider::generateDebugVAO()
-{
-	for (std::shared_ptr<LoopCollider>& loopCollider : loopColliders)
-	{
-		loopCollider->generateDebugVAO();
-	}
-}
-
 void TileGridCollider::updateShapes()
 {
 	shapes.clear();
 
-	for (std::shared_ptr<LoopCollider>& loopCollider : loopColliders)
+	for (TileLoop& loop : loops)
 	{
-		for (b2Shape* shape : loopCollider->getShapes())
+		if (loop.collider == nullptr)
+			continue;
+
+		for (b2Shape* shape : loop.collider->getShapes())
 		{
 			shapes.push_back(shape);
 		}
@@ -11,6 +11,8 @@
 
 #include <vector>
 
+class Rigidbody;
+
 enum class Direction
 {
 	UP,
@@ -65,8 +67,6 @@ public:
 
 	const virtual std::vector<b2Shape*> getShapes() override;
 
-	void renderDebugView() override;
-
 	/**
 	 * Update this collider's data with a tile grid and layer index.
 	 *
@@ -79,8 +79,33 @@ public:
 		CollisionType collisionType = CollisionType::OUTSIDE,
 		unsigned int layerIndex = 0);
 
+	/**
+	 * Regenerate the changed loops when tiles of the tile grid changed since the last update.
+	 * Called every frame by the rigidbody this collider is attached to.
+	 */
+	void update(Rigidbody& rigidbody) override;
+
+	/**
+	 * Regenerate the loops around the chunks of the tile grid that changed since the last update
+	 * (see TileGrid::setTile()), and replace only those loops on the rigidbody.
+	 * Does nothing while the physics world is stepping, the changes are then picked up by a later update.
+	 *
+	 * \param rigidbody: the rigidbody this collider is attached to.
+	 * \returns the number of loops that were replaced.
+	 */
+	unsigned int updateChangedTiles(Rigidbody* rigidbody);
+
 private:
 
+	// A loop around a group of tiles
+	struct TileLoop
+	{
+		std::shared_ptr<LoopCollider> collider;
+		// The squares the loop goes around, inclusive
+		glm::ivec2 min{ 0 };
+		glm::ivec2 max{ 0 };
+	};
+
 	/**
 	 * Create a new tile grid collider.
 	 *
@@ -104,8 +129,6 @@ private:
 		float density,
 		float friction);
 
-	void generateDebugVAO();
-
 	void updateShapes();
 
 	/**
@@ -113,12 +136,48 @@ private:
 	 */
 	glm::vec2 getPointFromSquare(TileGrid* tileGrid, glm::ivec2 square, Direction directionMoving);
 
-	bool isEmpty(TileGrid* tileGrid,
-		unsigned int layerIndex,
-		glm::ivec2 sample);
+	/**
+	 * Get whether a square holds a tile. Squares just outside of the grid are empty.
+	 */
+	bool isSolid(glm::ivec2 square) const
+	{
+		return solidMask[(square.x + 1) + (square.y + 1) * (gridSize.x + 2)];
+	}
+
+	/**
+	 * Update the solid mask for a range of squares (inclusive) from the tile grid.
+	 */
+	void updateSolidMask(glm::ivec2 min, glm::ivec2 max);
+
+	/**
+	 * Create loops for all untraced squares in a range (inclusive) that have an empty square above them.
+	 */
+	void traceRange(glm::ivec2 min, glm::ivec2 max, std::vector<b2Shape*>& addedShapes);
+
+	/**
+	 * Walk around the tiles starting at the top edge of a square and store the loop.
+	 */
+	void traceLoop(glm::ivec2 startSquare, std::vector<b2Shape*>& addedShapes);
+
+	TileGrid* tileGrid{ nullptr };
+	CollisionType collisionType{ CollisionType::OUTSIDE };
+	unsigned int layerIndex{ 0 };
+	glm::ivec2 gridSize{ 0 };
+
+	// One bit per square, with a border of empty squares around the grid so that neighbours never go out of bounds
+	std::vector<bool> solidMask;
+
+	// For each square with an empty square above it, the index of the loop that goes along its top edge, or -1
+	std::vector<int> topEdgeLoops;
+
+	// The loops that make up this tile grid collider, removed loops leave an empty slot
+	std::vector<TileLoop> loops;
+	std::vector<int> freeLoopSlots;
 
-	// The loop colliders that make up this tile grid collider
-	std::vector<std::shared_ptr<LoopCollider>> loopColliders;
+	// The revision of each chunk of the tile grid layer at the last update
+	std::vector<unsigned int> chunkRevisions;
+	// The revision of the whole tile grid at the last update
+	unsigned int gridRevision{ 0 };
 
 	// The shapes that make up this tile grid collider
 	std::vector<b2Shape*> shapes;
@@ -0,0 +1,51 @@
+#include "TileWorldCollider.h"
+
+std::shared_ptr<Collider> TileWorldCollider::create(
+	TileWorld* tileWorld,
+	LayerMask selfLayerMask,
+	LayerMask interactionLayerMask,
+	int layerIndex,
+	bool sensor,
+	float density,
+	float friction)
+{
+	if (tileWorld == nullptr)
+	{
+		Logger::logError("Cannot create a tile world collider without a tile world.");
+		return nullptr;
+	}
+
+	// The layer index must be a valid value
+	if (layerIndex < 0 || layerIndex >= (int)tileWorld->getLayerCount())
+	{
+		Logger::logError("The layer index " + std::to_string(layerIndex)
+			+ " is an invalid value for the tile world with "
+			+ std::to_string(tileWorld->getLayerCount()) + " layers.");
+		return nullptr;
+	}
+
+	TileWorldCollider* collider = new TileWorldCollider(
+		selfLayerMask,
+		interactionLayerMask,
+		sensor,
+		density,
+		friction);
+
+	std::shared_ptr<TileWorldCollider> pointer{ collider };
+
+	// Letting the tile world make edges for this layer from now on
+	tileWorld->collider = pointer;
+	tileWorld->collisionLayer = layerIndex;
+
+	return pointer;
+}
+
+TileWorldCollider::TileWorldCollider(
+	LayerMask selfLayerMask,
+	LayerMask interactionLayerMask,
+	bool sensor,
+	float density,
+	float friction)
+	: Collider(selfLayerMask, interactionLayerMask, density, friction, sensor)
+{
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Collider.h"
+
+#include <Root/components/TileWorld.h>
+
+#include <memory>
+
+/**
+ * A collider for one layer of a streamed tile world.
+ * The edges of each chunk are made on the loader threads of the tile world, and the tile world adds and removes
+ * their fixtures on the rigidbody on its own transform as chunks are loaded and unloaded.
+ * The rigidbody must therefore be on the same transform as the tile world, and should be static.
+ *
+ * Edges are one-sided and only collide with bodies outside of the tiles.
+ */
+class TileWorldCollider : public Collider
+{
+public:
+
+	/**
+	 * Create a new tile world collider.
+	 *
+	 * \param tileWorld:			the tile world to create the collider for.
+	 * \param selfLayerMask:		a layer mask which defines which layers this rigidbody is on. Default = LAYER_0.
+	 * \param interactionLayerMask:	a layer mask of all layers which this rigidbody can interact with. Default = LAYER_ALL.
+	 * \param layerIndex:			the index of the layer to create the collider for. Default = 0.
+	 * \param sensor:				whether the collider is a sensor. A sensor does not collide
+	 *								with other objects, but it reports overlaps anyways.
+	 * \param density:				the density of the collider. Default = 1.0.
+	 * \param friction:				the friction of the collider. Default = 0.3.
+	 */
+	static std::shared_ptr<Collider> create(
+		TileWorld* tileWorld,
+		LayerMask selfLayerMask = LAYER_0,
+		LayerMask interactionLayerMask = LAYER_ALL,
+		int layerIndex = 0,
+		bool sensor = false,
+		float density = 1.0f,
+		float friction = 0.3f);
+
+	/**
+	 * The shapes change while chunks are streamed, so they are never added up front:
+	 * the tile world adds the fixtures of each chunk itself.
+	 */
+	const virtual std::vector<b2Shape*> getShapes() override { return std::vector<b2Shape*>(); }
+
+private:
+
+	TileWorldCollider(
+		LayerMask selfLayerMask,
+		LayerMask interactionLayerMask,
+		bool sensor,
+		float density,
+		float friction);
+};
@@ -16,6 +16,6 @@ AnimatorPointer Animator::createBase(TransformPointer transform, std::string ani
 }
 
 Animator::Animator(std::string animationWebTag)
-	: animationWebTag(animationWebTag)
+	: animationWebTag(StringInterner::intern(animationWebTag))
 {
 }
@@ -36,5 +36,5 @@ protected:
 
 	Animator(std::string animationWebTag);
 
-	std::string animationWebTag;
+	StringID animationWebTag;
 };
@@ -0,0 +1,209 @@
+#include "AudioEmitter.h"
+
+#include <Root/Transform.h>
+
+#include <algorithm>
+#include <cmath>
+
+AudioEmitterPointer AudioEmitter::create(TransformPointer transform, const std::string& soundName, bool looping)
+{
+	AudioEmitter* emitter = new AudioEmitter(StringInterner::intern(soundName), looping);
+	std::shared_ptr<AudioEmitter> pointer{ emitter };
+	transform->addComponent(pointer);
+	return emitter;
+}
+
+AudioEmitter::AudioEmitter(StringID sound, bool looping)
+	: sound(sound),
+	length(AudioEngine::getSoundLength(sound)),
+	looping(looping)
+{
+	if (length <= 0.0f)
+		Logger::logError("AudioEmitter: Sound was not loaded: " + StringInterner::lookup(sound));
+
+	AudioEngine::registerEmitter(this);
+}
+
+AudioEmitter::~AudioEmitter()
+{
+	releaseVoice();
+	AudioEngine::unregisterEmitter(this);
+	Logger::destructorMessage("Audio emitter");
+}
+
+void AudioEmitter::play()
+{
+	// Restarting on the next update, which finds a voice if the emitter is audible
+	releaseVoice();
+	playing = length > 0.0f;
+	playbackPosition = 0.0f;
+}
+
+void AudioEmitter::stop()
+{
+	releaseVoice();
+	playing = false;
+	playbackPosition = 0.0f;
+}
+
+bool AudioEmitter::isPlaying() const
+{
+	return playing;
+}
+
+void AudioEmitter::setGain(float gain)
+{
+	this->gain = gain;
+}
+
+void AudioEmitter::setPitch(float pitch)
+{
+	this->pitch = pitch;
+
+	if (voiceAcquired)
+		alSourcef(AudioEngine::getVoiceSource(voice), AL_PITCH, pitch);
+}
+
+void AudioEmitter::setLooping(bool looping)
+{
+	this->looping = looping;
+
+	if (voiceAcquired)
+		alSourcei(AudioEngine::getVoiceSource(voice), AL_LOOPING, looping);
+}
+
+void AudioEmitter::setAudibleRange(float minDistance, float maxDistance)
+{
+	this->minDistance = std::max(minDistance, 0.0f);
+	this->maxDistance = std::max(maxDistance, this->minDistance);
+}
+
+float AudioEmitter::getAudibleGain() const
+{
+	return audibleGain;
+}
+
+bool AudioEmitter::hasVoice() const
+{
+	return voiceAcquired;
+}
+
+float AudioEmitter::getPlaybackPosition() const
+{
+	return playbackPosition;
+}
+
+std::string AudioEmitter::toString()
+{
+	return "AudioEmitter(" + StringInterner::lookup(sound)
+		+ (playing ? (voiceAcquired ? ", audible" : ", virtual") : ", stopped") + ")";
+}
+
+void AudioEmitter::internal_updateAudio(glm::vec2 listenerPosition, float deltaTime, float gainThreshold)
+{
+	if (!playing)
+		return;
+
+	float distance{ glm::length(transform->getPosition() - listenerPosition) };
+	float attenuation{ 1.0f };
+	if (distance >= maxDistance)
+		attenuation = 0.0f;
+	else if (distance > minDistance)
+		attenuation = 1.0f - (distance - minDistance) / (maxDistance - minDistance);
+
+	audibleGain = gain * attenuation;
+
+	if (voiceAcquired)
+	{
+		AudioEngine::VoiceState state{ AudioEngine::getVoiceState(voice) };
+
+		if (state == AudioEngine::VoiceState::FINISHED)
+		{
+			voiceAcquired = false;
+			playing = false;
+			playbackPosition = 0.0f;
+			return;
+		}
+
+		if (state == AudioEngine::VoiceState::PLAYING)
+		{
+			ALuint source{ AudioEngine::getVoiceSource(voice) };
+			alGetSourcef(source, AL_SEC_OFFSET, &playbackPosition);
+
+			// Giving up the voice a bit below the threshold to get one, so it is not given up and taken every frame
+			if (audibleGain < gainThreshold * 0.5f)
+			{
+				releaseVoice();
+				return;
+			}
+
+			alSourcef(source, AL_GAIN, audibleGain);
+			applyVoicePosition(listenerPosition);
+			return;
+		}
+
+		// The voice was taken by a more important sound, so continuing without one
+		voiceAcquired = false;
+	}
+
+	playbackPosition += deltaTime * pitch;
+
+	if (playbackPosition >= length)
+	{
+		if (looping)
+		{
+			playbackPosition = std::fmod(playbackPosition, length);
+		}
+		else
+		{
+			playing = false;
+			playbackPosition = 0.0f;
+		}
+	}
+}
+
+bool AudioEmitter::internal_wantsVoice(float gainThreshold) const
+{
+	return playing && !voiceAcquired && audibleGain >= gainThreshold;
+}
+
+bool AudioEmitter::internal_acquireVoice(glm::vec2 listenerPosition)
+{
+	if (!AudioEngine::acquireVoice(sound, voice))
+		return false;
+
+	voiceAcquired = true;
+
+	ALuint source{ AudioEngine::getVoiceSource(voice) };
+
+	// Attenuation is done by the emitter, OpenAL only pans the sound
+	alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
+	alSourcef(source, AL_ROLLOFF_FACTOR, 0.0f);
+	alSourcef(source, AL_GAIN, audibleGain);
+	alSourcef(source, AL_PITCH, pitch);
+	alSourcei(source, AL_LOOPING, looping);
+	applyVoicePosition(listenerPosition);
+
+	alSourcef(source, AL_SEC_OFFSET, playbackPosition);
+	alSourcePlay(source);
+
+	return true;
+}
+
+void AudioEmitter::releaseVoice()
+{
+	if (!voiceAcquired)
+		return;
+
+	AudioEngine::releaseVoice(voice);
+	voiceAcquired = false;
+}
+
+void AudioEmitter::applyVoicePosition(glm::vec2 listenerPosition)
+{
+	glm::vec2 offset{ transform->getPosition() - listenerPosition };
+
+	// Placing the listener minDistance away from the plane of the emitters,
+	// so sounds close to the camera are heard in the middle instead of jumping from side to side
+	alSource3f(AudioEngine::getVoiceSource(voice), AL_POSITION, offset.x, offset.y, -std::max(minDistance, 0.1f));
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Root/components/Component.h" // Base class
+#include "Root/engine/AudioEngine.h"
+#include "Root/StringID.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+
+#define AudioEmitterPointer AudioEmitter*
+
+class Transform;
+
+// TODO change this to somehow only be in Transform.h
+#define TransformPointer Transform*
+
+/**
+ * Plays a loaded sound at the position of its transform, quieter the further it is from the active camera.
+ *
+ * Emitters are virtual: an emitter only gets one of the engine's voices while it is loud enough to hear.
+ * The rest only keep track of where they are in their sound, so that they continue at the right time
+ * when they become audible again. This way a level can have thousands of emitters.
+ */
+class AudioEmitter : public Component
+{
+public:
+
+	/**
+	 * Create a new audio emitter.
+	 * Will automatically add this component to the given transform.
+	 *
+	 * \param transform: the transform to add this component to.
+	 * \param soundName: the name of the loaded sound to play. Streamed sounds cannot be emitted.
+	 * \param looping: whether the sound starts over when it ends.
+	 */
+	static AudioEmitterPointer create(TransformPointer transform, const std::string& soundName, bool looping = true);
+
+	~AudioEmitter();
+
+	/**
+	 * Start playing the sound from the start.
+	 */
+	void play();
+
+	/**
+	 * Stop playing the sound.
+	 */
+	void stop();
+
+	/**
+	 * Get whether the sound is playing, even if it is not audible.
+	 *
+	 * \returns whether the sound is playing.
+	 */
+	bool isPlaying() const;
+
+	/**
+	 * Set the gain of the sound when it is close to the camera.
+	 *
+	 * \param gain: the new gain. The gain is 1.0 by default.
+	 */
+	void setGain(float gain);
+
+	/**
+	 * Set the pitch of the sound.
+	 *
+	 * \param pitch: the new pitch. The pitch is 1.0 by default.
+	 */
+	void setPitch(float pitch);
+
+	/**
+	 * Set whether the sound starts over when it ends.
+	 */
+	void setLooping(bool looping);
+
+	/**
+	 * Set the distances over which the sound fades out.
+	 * The gain goes linearly from the full gain at minDistance to nothing at maxDistance.
+	 *
+	 * \param minDistance: the distance up to which the sound plays at the full gain, 1 by default.
+	 * \param maxDistance: the distance from which the sound cannot be heard, 20 by default.
+	 */
+	void setAudibleRange(float minDistance, float maxDistance);
+
+	/**
+	 * Get the gain of the sound at the distance it was from the camera last frame.
+	 *
+	 * \returns the gain that is heard.
+	 */
+	float getAudibleGain() const;
+
+	/**
+	 * Get whether the emitter has a voice, so that it can be heard.
+	 *
+	 * \returns whether the emitter has a voice.
+	 */
+	bool hasVoice() const;
+
+	/**
+	 * Get the time in the sound that is playing.
+	 *
+	 * \returns the time since the start of the sound, in seconds.
+	 */
+	float getPlaybackPosition() const;
+
+	std::string toString() override;
+
+	/**
+	 * Update the gain, the position and the playback position, and give up the voice if the sound became inaudible.
+	 * Called every frame by the audio engine.
+	 */
+	void internal_updateAudio(glm::vec2 listenerPosition, float deltaTime, float gainThreshold);
+
+	bool internal_wantsVoice(float gainThreshold) const;
+
+	/**
+	 * Try to get a voice and continue playing on it.
+	 *
+	 * \returns whether a voice was available.
+	 */
+	bool internal_acquireVoice(glm::vec2 listenerPosition);
+
+private:
+
+	AudioEmitter(StringID sound, bool looping);
+
+	void releaseVoice();
+	void applyVoicePosition(glm::vec2 listenerPosition);
+
+	StringID sound;
+	// The length of the sound in seconds
+	float length;
+
+	float gain{ 1.0f };
+	float pitch{ 1.0f };
+	bool looping;
+	float minDistance{ 1.0f };
+	float maxDistance{ 20.0f };
+
+	bool playing{ false };
+	// The time in the sound that is playing, also kept up to date while the emitter has no voice
+	float playbackPosition{ 0.0f };
+	float audibleGain{ 0.0f };
+
+	bool voiceAcquired{ false };
+	AudioEngine::VoiceHandle voice;
+};
@@ -4,9 +4,7 @@
 
 #include <box2d/b2_settings.h>
 
-void Rigidbody::generateDebugVAO()
-{
-}
+#include <unordered_set>
 
 Rigidbody::Rigidbody(TransformPointer transform,
 	float linearDamping,
@@ -17,7 +15,8 @@ Rigidbody::Rigidbody(TransformPointer transform,
 	bool bullet,
 	b2BodyType type,
 	bool enabled,
-	float gravityScale)
+	float gravityScale,
+	PhysicsWorldID world)
 	: enabled(enabled)
 {
 	glm::vec2 position{ transform->getPosition() };
@@ -34,8 +33,11 @@ Rigidbody::Rigidbody(TransformPointer transform,
 	bodyDef.bullet = bullet;
 	bodyDef.enabled = enabled;
 	bodyDef.gravityScale = gravityScale;
+	// Letting the body know which rigidbody it belongs to, used for transform synchronisation
+	bodyDef.userData.pointer = reinterpret_cast<uintptr_t>(this);
 
-	body = PhysicsEngine::addBody(&bodyDef);
+	body = PhysicsEngine::addBody(&bodyDef, world);
+	handle = PhysicsEngine::registerRigidbody(this);
 
 	/*
 	b2FixtureDef fixtureDef;
@@ -65,7 +67,8 @@ Rigidbody::Rigidbody(TransformPointer transform,
 	bool bullet,
 	b2BodyType type,
 	bool enabled,
-	float gravityScale)
+	float gravityScale,
+	PhysicsWorldID world)
 	: colliders(std::vector<std::shared_ptr<Collider>>{ collider })
 	, enabled(enabled)
 {
@@ -83,34 +86,13 @@ Rigidbody::Rigidbody(TransformPointer transform,
 	bodyDef.bullet = bullet;
 	bodyDef.enabled = enabled;
 	bodyDef.gravityScale = gravityScale;
+	// Letting the body know which rigidbody it belongs to, used for transform synchronisation
+	bodyDef.userData.pointer = reinterpret_cast<uintptr_t>(this);
 
-	body = PhysicsEngine::addBody(&bodyDef);
-
-	// Creating a fixture data
-	fixtureData = new FixtureData;
-
-	// Assigning the user data pointer of the fixture
-	uintptr_t ptr = reinterpret_cast<uintptr_t>(fixtureData);
-
-	// Adding each shape
-	for (b2Shape* shape : collider->getShapes())
-	{
-		b2FixtureDef fixtureDef;
-		fixtureDef.shape = shape;
-		fixtureDef.density = collider->getDensity();
-		fixtureDef.friction = collider->getFriction();
-		fixtureDef.isSensor = collider->isSensor();
-
-		// Setting the layer masks
-		fixtureDef.filter.categoryBits = collider->getSelfLayerMask();
-		fixtureDef.filter.maskBits = collider->getInteractionLayerMask();
+	body = PhysicsEngine::addBody(&bodyDef, world);
+	handle = PhysicsEngine::registerRigidbody(this);
 
-		fixture = body->CreateFixture(&fixtureDef);
-		fixture->GetUserDataRef().pointer = ptr;
-
-		fixtureData->mFixture = fixture;
-		fixtureData->rigidbody = this;
-	}
+	createFixtures(*collider);
 }
 
 Rigidbody::Rigidbody(TransformPointer transform,
@@ -123,7 +105,8 @@ Rigidbody::Rigidbody(TransformPointer transform,
 	bool bullet,
 	b2BodyType type,
 	bool enabled,
-	float gravityScale)
+	float gravityScale,
+	PhysicsWorldID world)
 	: colliders(colliders)
 	, enabled(enabled)
 {
@@ -141,39 +124,82 @@ Rigidbody::Rigidbody(TransformPointer transform,
 	bodyDef.bullet = bullet;
 	bodyDef.enabled = enabled;
 	bodyDef.gravityScale = gravityScale;
+	// Letting the body know which rigidbody it belongs to, used for transform synchronisation
+	bodyDef.userData.pointer = reinterpret_cast<uintptr_t>(this);
 
-	body = PhysicsEngine::addBody(&bodyDef);
+	body = PhysicsEngine::addBody(&bodyDef, world);
+	handle = PhysicsEngine::registerRigidbody(this);
 
-	// There must be at least one collider for the next section
-	if (colliders.size() < 1) return;
+	for (std::shared_ptr<Collider> collider : colliders)
+	{
+		createFixtures(*collider);
+	}
+}
 
-	// Creating a fixture data
-	fixtureData = new FixtureData;
+void Rigidbody::createFixtures(Collider& collider)
+{
+	// Adding each shape of the collider
+	for (b2Shape* shape : collider.getShapes())
+	{
+		createFixture(collider, shape);
+	}
+}
+
+void Rigidbody::createFixture(Collider& collider, b2Shape* shape)
+{
+	// Each fixture gets its own data, which also remembers the interaction layers the collider asked for
+	FixtureData* data{ new FixtureData{ this, nullptr, collider.getInteractionLayerMask(), shape } };
+
+	b2FixtureDef fixtureDef;
+	fixtureDef.shape = shape;
+	fixtureDef.density = collider.getDensity();
+	fixtureDef.friction = collider.getFriction();
+	fixtureDef.isSensor = collider.isSensor();
+
+	// Setting the layer masks, limited by the layer collision matrix
+	fixtureDef.filter = PhysicsEngine::createFilter(collider.getSelfLayerMask(), collider.getInteractionLayerMask());
 
 	// Assigning the user data pointer of the fixture
-	uintptr_t ptr = reinterpret_cast<uintptr_t>(fixtureData);
+	fixtureDef.userData.pointer = reinterpret_cast<uintptr_t>(data);
 
-	for (std::shared_ptr<Collider> collider : colliders)
+	fixture = body->CreateFixture(&fixtureDef);
+
+	data->mFixture = fixture;
+	fixtureDatas.push_back(data);
+}
+
+void Rigidbody::replaceColliderShapes(Collider& collider,
+	const std::vector<b2Shape*>& removedShapes,
+	const std::vector<b2Shape*>& addedShapes)
+{
+	if (body->GetWorld()->IsLocked())
 	{
-		// Adding each shape of each collider
-		for (b2Shape* shape : collider->getShapes())
+		Logger::logError("Cannot replace collider shapes while the physics world is stepping.");
+		return;
+	}
+
+	// Destroying the fixtures of the removed shapes in a single pass over the fixtures
+	std::unordered_set<const b2Shape*> removed{ removedShapes.begin(), removedShapes.end() };
+
+	unsigned int kept{ 0 };
+	for (FixtureData* data : fixtureDatas)
+	{
+		if (removed.count(data->shape) == 0)
 		{
-			b2FixtureDef fixtureDef;
-			fixtureDef.shape = shape;
-			fixtureDef.density = collider->getDensity();
-			fixtureDef.friction = collider->getFriction();
-			fixtureDef.isSensor = collider->isSensor();
+			fixtureDatas[kept++] = data;
+			continue;
+		}
 
-			// Setting the layer masks
-			fixtureDef.filter.categoryBits = collider->getSelfLayerMask();
-			fixtureDef.filter.maskBits = collider->getInteractionLayerMask();
+		body->DestroyFixture(data->mFixture);
+		delete data;
+	}
+	fixtureDatas.resize(kept);
 
-			fixture = body->CreateFixture(&fixtureDef);
-			fixture->GetUserDataRef().pointer = ptr;
+	fixture = fixtureDatas.empty() ? nullptr : fixtureDatas.back()->mFixture;
 
-			fixtureData->mFixture = fixture;
-			fixtureData->rigidbody = this;
-		}
+	for (b2Shape* shape : addedShapes)
+	{
+		createFixture(collider, shape);
 	}
 }
 
@@ -187,9 +213,10 @@ RigidbodyPointer Rigidbody::create(
 	float linearDamping,
 	float angularDamping,
 	bool awake,
-	bool enabled)
+	bool enabled,
+	PhysicsWorldID world)
 {
-	Rigidbody* rigidbody = new Rigidbody(transform, linearDamping, angularDamping, allowSleep, awake, fixedRotation, bullet, type, enabled, gravityScale);
+	Rigidbody* rigidbody = new Rigidbody(transform, linearDamping, angularDamping, allowSleep, awake, fixedRotation, bullet, type, enabled, gravityScale, world);
 	std::shared_ptr<Rigidbody> pointer{ rigidbody };
 	transform->addComponent(pointer);
 	return rigidbody;
@@ -206,9 +233,10 @@ RigidbodyPointer Rigidbody::create(
 	float linearDamping,
 	float angularDamping,
 	bool awake,
-	bool enabled)
+	bool enabled,
+	PhysicsWorldID world)
 {
-	Rigidbody* rigidbody = new Rigidbody(transform, collider, linearDamping, angularDamping, allowSleep, awake, fixedRotation, bullet, type, enabled, gravityScale);
+	Rigidbody* rigidbody = new Rigidbody(transform, collider, linearDamping, angularDamping, allowSleep, awake, fixedRotation, bullet, type, enabled, gravityScale, world);
 	std::shared_ptr<Rigidbody> pointer{ rigidbody };
 	transform->addComponent(pointer);
 	return rigidbody;
@@ -225,9 +253,10 @@ RigidbodyPointer Rigidbody::create(
 	float linearDamping,
 	float angularDamping,
 	bool awake,
-	bool enabled)
+	bool enabled,
+	PhysicsWorldID world)
 {
-	Rigidbody* rigidbody = new Rigidbody(transform, colliders, linearDamping, angularDamping, allowSleep, awake, fixedRotation, bullet, type, enabled, gravityScale);
+	Rigidbody* rigidbody = new Rigidbody(transform, colliders, linearDamping, angularDamping, allowSleep, awake, fixedRotation, bullet, type, enabled, gravityScale, world);
 	std::shared_ptr<Rigidbody> pointer{ rigidbody };
 	transform->addComponent(pointer);
 	return rigidbody;
@@ -235,13 +264,25 @@ RigidbodyPointer Rigidbody::create(
 
 Rigidbody::~Rigidbody()
 {
+	// The body may outlive this rigidbody if its destruction is queued
+	body->GetUserData().pointer = reinterpret_cast<uintptr_t>(nullptr);
+
+	// Deleting the fixture data created on the heap
+	for (FixtureData* data : fixtureDatas)
+	{
+		data->mFixture->GetUserData().pointer = reinterpret_cast<uintptr_t>(nullptr);
+		delete data;
+	}
+	fixtureDatas.clear();
+
+	if (simulationLOD.mode != SimulationLODMode::ALWAYS_SIMULATE)
+		PhysicsEngine::setSimulationLODEnabled(this, false);
+
 	// Removing the body from box2d
 	PhysicsEngine::destroyBody(this->body);
-	// Deleting the fixture data created on the heap
-	delete fixtureData;
 
-	uintptr_t ptr = reinterpret_cast<uintptr_t>(nullptr);
-	fixture->GetUserDataRef().pointer = ptr;
+	// Any handles to this rigidbody are now invalid
+	PhysicsEngine::unregisterRigidbody(handle);
 
 	// Indicating the rigidbody got destroyed
 	Logger::destructorMessage("Rigidbody");
@@ -249,6 +290,11 @@ Rigidbody::~Rigidbody()
 
 void Rigidbody::update()
 {
+	// Letting colliders that change at runtime bring their fixtures up to date
+	for (std::shared_ptr<Collider>& collider : colliders)
+	{
+		collider->update(*this);
+	}
 }
 
 void Rigidbody::updateTransform()
@@ -256,14 +302,41 @@ void Rigidbody::updateTransform()
 	if (!enabled)
 		return;
 
-	b2Vec2 position{ body->GetPosition() };
-	this->transform->setPosition(glm::vec2(position.x, position.y));
+	pollBodyTransformChange();
+	applyBodyTransform(glm::vec2(lastSyncedPosition.x, lastSyncedPosition.y), glm::degrees(lastSyncedAngle));
+}
+
+bool Rigidbody::pollBodyTransformChange()
+{
+	const b2Vec2& position{ body->GetPosition() };
+	float angle{ body->GetAngle() };
+
+	bool changed{ transformSyncRequested
+		|| position != lastSyncedPosition
+		|| angle != lastSyncedAngle };
 
-	this->transform->setRotation(glm::degrees(body->GetAngle()));
+	lastSyncedPosition = position;
+	lastSyncedAngle = angle;
+	transformSyncRequested = false;
+
+	return changed;
+}
+
+void Rigidbody::applyBodyTransform(glm::vec2 position, float rotation)
+{
+	this->transform->setPosition(position);
+	this->transform->setRotation(rotation);
+}
+
+bool Rigidbody::isTransformSyncRequested() const
+{
+	return transformSyncRequested;
 }
 
 void Rigidbody::setPosition(glm::vec2 position, bool alsoSetTransformPosition)
 {
+	// The body may be asleep or static, so the next synchronisation must not skip it
+	transformSyncRequested = true;
 	PhysicsEngine::setBodyPosition(body, position);
 	//body->SetTransform(b2Vec2(position.x, position.y), body->GetAngle());
 }
@@ -428,6 +501,12 @@ bool Rigidbody::isAwake() const
 bool Rigidbody::setEnabled(bool flag)
 {
 	enabled = flag;
+	transformSyncRequested = true;
+
+	// The body is enabled again once the camera comes close
+	if (!simulationActive && simulationLOD.mode == SimulationLODMode::DISABLE)
+		return true;
+
 	return PhysicsEngine::setBodyEnabled(body, flag);
 }
 
@@ -448,43 +527,144 @@ bool Rigidbody::isFixedRotation() const
 
 void Rigidbody::setSelfLayerMask(LayerMask mask)
 {
-	b2Filter filter{ fixture->GetFilterData() };
-	filter.categoryBits = mask;
-	fixture->SetFilterData(filter);
+	for (FixtureData* data : fixtureDatas)
+	{
+		data->mFixture->SetFilterData(PhysicsEngine::createFilter(mask, data->interactionLayerMask));
+	}
 }
 
 void Rigidbody::setInteractionLayerMask(LayerMask mask)
 {
-	b2Filter filter{ fixture->GetFilterData() };
-	filter.maskBits = mask;
-	fixture->SetFilterData(filter);
+	for (FixtureData* data : fixtureDatas)
+	{
+		data->interactionLayerMask = mask;
+		data->mFixture->SetFilterData(
+			PhysicsEngine::createFilter(data->mFixture->GetFilterData().categoryBits, mask));
+	}
 }
 
 LayerMask Rigidbody::getSelfLayerMask()
 {
+	if (fixture == nullptr)
+		return 0;
+
 	return fixture->GetFilterData().categoryBits;
 }
 
 LayerMask Rigidbody::getInteractionLayerMask()
 {
-	return fixture->GetFilterData().maskBits;
+	if (fixtureDatas.empty())
+		return 0;
+
+	return fixtureDatas.back()->interactionLayerMask;
+}
+
+void Rigidbody::setSimulationLOD(const SimulationLOD& lod)
+{
+	// Restoring the body before switching, so it is not left deactivated by a mode it no longer has
+	setSimulationActive(true);
+
+	simulationLOD = lod;
+	PhysicsEngine::setSimulationLODEnabled(this, lod.mode != SimulationLODMode::ALWAYS_SIMULATE);
 }
 
-void Rigidbody::renderDebugView()
+const SimulationLOD& Rigidbody::getSimulationLOD() const
 {
-	// Getting the shader
-	Shader* debugRenderShader{ Root::getDebugRenderShader() };
+	return simulationLOD;
+}
 
-	// Setting shader variables
-	debugRenderShader->use();
-	debugRenderShader->setMat4("model", transform->getModelMatrixWithoutScale());
-	debugRenderShader->setMat4("view", Root::getActiveCamera()->getTransform()->getInverseTransformMatrix());
+bool Rigidbody::isSimulationActive() const
+{
+	return simulationActive;
+}
 
-	debugRenderShader->setMat4("projection", Root::getActiveCamera()->getProjectionMatrix());
-	debugRenderShader->setVector3("lineColor", glm::vec3(0.0f, 1.0f, 0.0f));
+void Rigidbody::setSimulationActive(bool active)
+{
+	if (simulationActive == active)
+		return;
 
-	for (std::shared_ptr<Collider> collider : colliders)
+	simulationActive = active;
+
+	if (!active)
+	{
+		savedLinearVelocity = body->GetLinearVelocity();
+		savedAngularVelocity = body->GetAngularVelocity();
+
+		if (simulationLOD.mode == SimulationLODMode::DISABLE)
+			PhysicsEngine::setBodyEnabled(body, false);
+		else
+			body->SetAwake(false);
+
+		return;
+	}
+
+	if (simulationLOD.mode == SimulationLODMode::DISABLE)
+	{
+		// A body disabled by the user stays disabled
+		if (!enabled)
+			return;
+
+		PhysicsEngine::setBodyEnabled(body, true);
+	}
+	else
 	{
-		collider->renderDebugView();
+		// A contact woke the body after updateSimulationLOD() last put it back to sleep,
+		// so its velocity is real and is kept
+		if (body->IsAwake())
+			return;
+
+		body->SetAwake(true);
 	}
+
+	// Putting a body to sleep clears its velocity, so it is set again
+	if (simulationLOD.preserveVelocity)
+	{
+		body->SetLinearVelocity(savedLinearVelocity);
+		body->SetAngularVelocity(savedAngularVelocity);
+	}
+	else
+	{
+		body->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+		body->SetAngularVelocity(0.0f);
+	}
+}
+
+bool Rigidbody::sleepIfWoken()
+{
+	if (simulationActive || simulationLOD.mode != SimulationLODMode::SLEEP || !body->IsAwake())
+		return false;
+
+	// Remembering the velocity the contact gave it, since sleeping clears it
+	savedLinearVelocity = body->GetLinearVelocity();
+	savedAngularVelocity = body->GetAngularVelocity();
+
+	body->SetAwake(false);
+	return true;
+}
+
+RigidbodyHandle Rigidbody::getHandle() const
+{
+	return handle;
+}
+
+bool Rigidbody::setWorld(PhysicsWorldID world)
+{
+	b2Body* movedBody{ PhysicsEngine::moveBody(body, world) };
+
+	if (movedBody == nullptr)
+		return false;
+
+	body = movedBody;
+	fixture = fixtureDatas.empty() ? nullptr : fixtureDatas.back()->mFixture;
+	return true;
+}
+
+PhysicsWorldID Rigidbody::getWorld() const
+{
+	return PhysicsEngine::getBodyWorld(body);
+}
+
+b2Body* Rigidbody::getBody()
+{
+	return body;
 }
@@ -2,6 +2,8 @@
 
 #include "Root/components/Component.h" // Base class
 #include "Root/colliders/Collider.h"
+#include "Root/RigidbodyHandle.h"
+#include "Root/PhysicsWorldID.h"
 
 #include <box2d/b2_body.h>
 #include <glm/glm.hpp>
@@ -20,6 +22,36 @@ struct FixtureData
 {
 	Rigidbody* rigidbody;
 	b2Fixture* mFixture{};
+	// The interaction layers asked for, before the layer collision matrix is applied
+	LayerMask interactionLayerMask{ LAYER_ALL };
+	// The collider shape this fixture was created from
+	const b2Shape* shape{ nullptr };
+};
+
+enum class SimulationLODMode
+{
+	// The body is always simulated
+	ALWAYS_SIMULATE,
+	// The body is disabled while it is far from the camera, so it is removed from the broad-phase entirely
+	DISABLE,
+	// The body is put to sleep while it is far from the camera.
+	// It still blocks other bodies, and wakes up when something touches it.
+	SLEEP
+};
+
+/**
+ * Settings for deactivating a rigidbody while it is far away from the active camera.
+ */
+struct SimulationLOD
+{
+	SimulationLODMode mode{ SimulationLODMode::ALWAYS_SIMULATE };
+	// The distance from the camera beyond which the body is deactivated
+	float radius{ 50.0f };
+	// How much closer than the deactivation distance the body must come to be activated again,
+	// so that a body moving around the radius does not switch every frame
+	float hysteresis{ 5.0f };
+	// Whether the body gets its velocity back when it is activated again, instead of starting at rest
+	bool preserveVelocity{ true };
 };
 
 #define STATIC		b2_staticBody
@@ -56,6 +88,7 @@ public:
 	 * 								Units are 1/time
 	 * \param awake:				is this body initially awake or sleeping?
 	 * \param enabled:				does this body start out enabled?
+	 * \param world:				the physics world to add this body to, see Physics::createWorld().
 	 */
 	static RigidbodyPointer create(
 		TransformPointer transform,
@@ -67,7 +100,8 @@ public:
 		float linearDamping = 0.0f,
 		float angularDamping = 0.0f,
 		bool awake = true,
-		bool enabled = true);
+		bool enabled = true,
+		PhysicsWorldID world = DEFAULT_PHYSICS_WORLD);
 
 	/**
 	 * Create a new rigidbody with a collider attached to it.
@@ -94,6 +128,7 @@ public:
 	 * 								Units are 1/time
 	 * \param awake:				is this body initially awake or sleeping?
 	 * \param enabled:				does this body start out enabled?
+	 * \param world:				the physics world to add this body to, see Physics::createWorld().
 	 */
 	static RigidbodyPointer create(
 		TransformPointer transform,
@@ -106,7 +141,8 @@ public:
 		float linearDamping = 0.0f,
 		float angularDamping = 0.0f,
 		bool awake = true,
-		bool enabled = true);
+		bool enabled = true,
+		PhysicsWorldID world = DEFAULT_PHYSICS_WORLD);
 
 	/**
 	 * Create a new rigidbody with multiple colliders attached to it.
@@ -133,6 +169,7 @@ public:
 	 * 								Units are 1/time
 	 * \param awake:				is this body initially awake or sleeping?
 	 * \param enabled:				does this body start out enabled?
+	 * \param world:				the physics world to add this body to, see Physics::createWorld().
 	 */
 	static RigidbodyPointer create(
 		TransformPointer transform,
@@ -145,7 +182,8 @@ public:
 		float linearDamping = 0.0f,
 		float angularDamping = 0.0f,
 		bool awake = true,
-		bool enabled = true);
+		bool enabled = true,
+		PhysicsWorldID world = DEFAULT_PHYSICS_WORLD);
 
 	void update() override;
 
@@ -154,6 +192,32 @@ public:
 	 */
 	void updateTransform();
 
+	/**
+	 * Check whether the body moved or rotated since the last time this was called,
+	 * and remember its current position and rotation.
+	 * Should not be called by the user.
+	 *
+	 * \returns whether the transform must be synchronised with the body.
+	 */
+	bool pollBodyTransformChange();
+
+	/**
+	 * Write a position and rotation that were read from the body to the transform.
+	 * Should not be called by the user.
+	 *
+	 * \param position: the world position of the body.
+	 * \param rotation: the rotation of the body in degrees.
+	 */
+	void applyBodyTransform(glm::vec2 position, float rotation);
+
+	/**
+	 * Get whether the transform must be synchronised on the next update,
+	 * even if the body is asleep or static.
+	 *
+	 * \returns whether a synchronisation was requested.
+	 */
+	bool isTransformSyncRequested() const;
+
 	/**
 	 * Set the position of this rigidbody.
 	 * 
@@ -402,17 +466,95 @@ public:
 	/**
 	 * Get the interaction layer mask,
 	 * which defines with which layers this object can interact.
+	 * This is the mask that was set, before the layer collision matrix is applied.
 	 *
 	 * \returns: the interaction layer mask.
 	 */
 	LayerMask getInteractionLayerMask();
 
+	/**
+	 * Set how this rigidbody is simulated while it is far away from the active camera.
+	 *
+	 * \param lod: the new simulation LOD settings.
+	 */
+	void setSimulationLOD(const SimulationLOD& lod);
 
-	void renderDebugView();
+	/**
+	 * Get how this rigidbody is simulated while it is far away from the active camera.
+	 *
+	 * \returns the simulation LOD settings.
+	 */
+	const SimulationLOD& getSimulationLOD() const;
 
-private:
+	/**
+	 * Get whether this rigidbody is being simulated, or was deactivated for being far from the camera.
+	 *
+	 * \returns false if the rigidbody was deactivated by its simulation LOD.
+	 */
+	bool isSimulationActive() const;
 
-	void generateDebugVAO();
+	/**
+	 * Activate or deactivate the simulation of this rigidbody, according to its simulation LOD.
+	 * Should not be called by the user.
+	 *
+	 * \param active: whether the rigidbody should be simulated.
+	 */
+	void setSimulationActive(bool active);
+
+	/**
+	 * Put this rigidbody back to sleep if it was deactivated by a SLEEP simulation LOD and a contact woke it,
+	 * so that it does not keep being simulated. The velocity it was given is restored when it is activated.
+	 * Should not be called by the user.
+	 *
+	 * \returns whether the rigidbody had been woken.
+	 */
+	bool sleepIfWoken();
+
+	/**
+	 * Get a handle to this rigidbody, which can be stored and checked safely after this rigidbody is destroyed.
+	 *
+	 * \returns a handle to this rigidbody.
+	 */
+	RigidbodyHandle getHandle() const;
+
+	/**
+	 * Move this rigidbody to another physics world.
+	 * Its colliders, velocity and layers are kept, but it stops touching the bodies in its old world.
+	 * Cannot be done from within the physics step, but can be done from collision callbacks.
+	 *
+	 * \param world: the world to move to.
+	 * \returns whether the rigidbody is now in the given world.
+	 */
+	bool setWorld(PhysicsWorldID world);
+
+	/**
+	 * Get the physics world this rigidbody is in.
+	 *
+	 * \returns the ID of the world.
+	 */
+	PhysicsWorldID getWorld() const;
+
+	/**
+	 * Get the Box2D body of this rigidbody.
+	 *
+	 * \returns the body.
+	 */
+	b2Body* getBody();
+
+	/**
+	 * Replace some of the shapes of a collider on this rigidbody, keeping the fixtures of the other shapes.
+	 * Used by colliders that change at runtime, like the TileGridCollider.
+	 * Must not be called while the physics world is stepping.
+	 *
+	 * \param collider: the collider the shapes belong to.
+	 * \param removedShapes: the shapes whose fixtures must be destroyed.
+	 * \param addedShapes: the shapes to create new fixtures for.
+	 */
+	void replaceColliderShapes(Collider& collider,
+		const std::vector<b2Shape*>& removedShapes,
+		const std::vector<b2Shape*>& addedShapes);
+
+private:
 
 	Rigidbody(TransformPointer transform,
 		float linearDamping,
@@ -423,7 +565,8 @@ private:
 		bool bullet,
 		b2BodyType type,
 		bool enabled,
-		float gravityScale);
+		float gravityScale,
+		PhysicsWorldID world);
 
 	Rigidbody(TransformPointer transform,
 		std::shared_ptr<Collider> collider,
@@ -435,7 +578,8 @@ private:
 		bool bullet,
 		b2BodyType type,
 		bool enabled,
-		float gravityScale);
+		float gravityScale,
+		PhysicsWorldID world);
 
 	Rigidbody(TransformPointer transform,
 		std::vector<std::shared_ptr<Collider>>& colliders,
@@ -447,12 +591,30 @@ private:
 		bool bullet,
 		b2BodyType type,
 		bool enabled,
-		float gravityScale);
+		float gravityScale,
+		PhysicsWorldID world);
+
+	void createFixtures(Collider& collider);
 
-	FixtureData* fixtureData;
-	b2Fixture* fixture;
+	void createFixture(Collider& collider, b2Shape* shape);
+
+	std::vector<FixtureData*> fixtureDatas;
+	// The last fixture that was created
+	b2Fixture* fixture{ nullptr };
 	b2Body* body;
+	RigidbodyHandle handle{};
 	std::vector<std::shared_ptr<Collider>> colliders;
 
 	bool enabled{ true };
+
+	// The body's transform at the last synchronisation with the transform
+	b2Vec2 lastSyncedPosition{ 0.0f, 0.0f };
+	float lastSyncedAngle{ 0.0f };
+	bool transformSyncRequested{ true };
+
+	SimulationLOD simulationLOD{};
+	bool simulationActive{ true };
+	// The velocity the body had when its simulation was deactivated
+	b2Vec2 savedLinearVelocity{ 0.0f, 0.0f };
+	float savedAngularVelocity{ 0.0f };
 };
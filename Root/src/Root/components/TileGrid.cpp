@@ -5,10 +5,6 @@
 
 TileGrid::~TileGrid()
 {
-	delete gridSpaces;
-
-	if (tileIndices != nullptr)
-		free(tileIndices);
 }
 
 TileGrid* TileGrid::create(Transform* transform,
@@ -54,8 +50,13 @@ void TileGrid::render(float renderDepth)
 	spriteRenderShader->setInt("sprite", 0);
 	spriteRenderShader->setFloat("renderDepth", renderDepth / 10000.0f);
 	spriteRenderShader->setIVector2("tileGridSize", tileGridSize);
+	spriteRenderShader->setInt("chunkSize", TILE_GRID_CHUNK_SIZE);
 	spriteRenderShader->setIVector2("textureGridSize", textureGridSize);
 	spriteRenderShader->setFloat("tileSize", tileSize);
+	// Tile worlds set their own seed per chunk
+	spriteRenderShader->setInt("tileIndexRandomisationSeed", 0);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, chunkPositionsSSBO);
 
 	// Binding the sprite
 	glActiveTexture(GL_TEXTURE0);
@@ -64,7 +65,7 @@ void TileGrid::render(float renderDepth)
 	glBindVertexArray(tileMapVAO);
 
 	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	glDrawArrays(GL_POINTS, 0, tileGridSize.x * tileGridSize.y * layerCount);
+	glDrawArrays(GL_POINTS, 0, uploadedChunkCount * TILE_GRID_CHUNK_SIZE * TILE_GRID_CHUNK_SIZE);
 
 	glBindVertexArray(0);
 }
@@ -85,20 +86,20 @@ void TileGrid::setTileSize(float tileSize)
 
 TileGrid::TileGrid(unsigned int texture,
 	glm::ivec2 textureGridSize,
-	GridSpace* data,
-	glm::ivec2 tileGridSize,
-	unsigned int layerCount,
+	const TileMapData& map,
 	std::string tileSet,
 	float tileSize)
 	: textureID(texture)
 	, textureGridSize(textureGridSize)
-	, gridSpaces(data)
-	, tileGridSize(tileGridSize)
-	, layerCount(layerCount)
-	, tileSetName(tileSet)
+	, tileGridSize(map.size)
+	, layerCount(map.layerCount)
+	, tileSetName(StringInterner::intern(tileSet))
 	, tileSize(tileSize)
 {
-	generateTileIndices();
+	chunkCount = (tileGridSize + glm::ivec2(TILE_GRID_CHUNK_SIZE - 1)) / TILE_GRID_CHUNK_SIZE;
+	chunkRevisions.resize(chunkCount.x * chunkCount.y * layerCount, 0);
+
+	generateTileIndices(map);
 }
 
 TileGrid* TileGrid::readData(const std::string& texturePath,
@@ -108,289 +109,57 @@ TileGrid* TileGrid::readData(const std::string& texturePath,
 	const std::string& tileSetName,
 	float tileSize)
 {
-	bool enableDebugLogging{ false };
-
-	// Additional tile map data
-	glm::ivec2 tileGridSize{ glm::ivec2(0) };
-	unsigned int layerCount{ 0 };
-
-	// Reading in the file
-	std::ifstream file(dataPath);
-	if (!file.is_open())
-	{
-		Logger::logError("Cannot read tile grid from '" + dataPath + "'; File cannot be opened.");
+	TileMapData map;
+	if (!TileMapFile::load(dataPath, map))
 		return nullptr;
-	}
-
-	// Holds a full line
-	std::string line;
-
-	unsigned int lineNumber{ 0 };
-
-	// Reading the tile grid dimensions
-	while (file.good())
-	{
-		// Find the next char
-		char c = file.get();
-
-		// Just go the the next line
-		if (c == '\n')
-		{
-			lineNumber++;
-			continue;
-		}
-
-		// Skip entire line after #
-		if (c == '#')
-		{
-			std::getline(file, line);
-			lineNumber++;
-			continue;
-		}
-
-		// Finding the first number
-		if (!TileGridEngine::isNumber(c))
-		{
-			continue;
-		}
-
-		// Reading the tile grid dimensions
-		tileGridSize.y = TileGridEngine::readNumber(&file, c);
-		file.get();
-		c = file.get();
-		tileGridSize.x = TileGridEngine::readNumber(&file, c);
-		if (enableDebugLogging)
-			Logger::log(std::string("Found tile grid size: ") + std::to_string(tileGridSize.x) + " x " + std::to_string(tileGridSize.y));
-		break;
-	}
-
-	if (tileGridSize.x <= 0 || tileGridSize.y <= 0)
-	{
-		Logger::logError("Tile grid size must not be less than 1 in each dimension.");
-		return nullptr;
-	}
-
-	// Reading the number of layers
-	while (file.good())
-	{
-		// Find the next char
-		char c = file.get();
-
-		// Just go the the next line
-		if (c == '\n')
-		{
-			lineNumber++;
-			continue;
-		}
-
-		// Skip entire line after #
-		if (c == '#')
-		{
-			std::getline(file, line);
-			lineNumber++;
-			continue;
-		}
-
-		// Finding the first number
-		if (!TileGridEngine::isNumber(c))
-		{
-			continue;
-		}
-
-		// Reading the layer count
-		layerCount = TileGridEngine::readNumber(&file, c);
-		if (enableDebugLogging)
-			Logger::log(std::string("Found layer count: ") + std::to_string(layerCount));
-		break;
-	}
-
-	if (layerCount <= 0)
-	{
-		Logger::logError("Tile layer count must not be less than 1.");
-		return nullptr;
-	}
-
-	GridSpace* gridSpaces = (GridSpace*)malloc(tileGridSize.x * tileGridSize.y * layerCount * sizeof(GridSpace));
-
-	const std::string allowedTags{ "abcdefghijklmnopqrstuvwxyz" };
-
-	unsigned int currentRowIndex{ 0 };
-	unsigned int currentLayerIndex{ 0 };
-
-	// Reading the number of layers
-	while (file.good())
-	{
-		// Find the next char
-		char c = file.get();
-
-		// Just go the the next line
-		if (c == '\n')
-		{
-			lineNumber++;
-			continue;
-		}
-
-		// Skip entire line after #
-		if (c == '#')
-		{
-			std::getline(file, line);
-			lineNumber++;
-			continue;
-		}
-
-		// Reached a data line
-		for (unsigned int i{ 0 }; i < tileGridSize.x; i++)
-		{
-			// Find the next char except at the beginning
-			if (i != 0)
-				c = file.get();
-
-			GridSpace gridSpace{};
-
-			// Read an index
-			if (TileGridEngine::isNumber(c))
-			{
-				gridSpace.type = GridSpaceType::INDEX;
-				gridSpace.index = TileGridEngine::readNumber(&file, c);
-				if (enableDebugLogging)
-					Logger::log(std::string("Read grid space with index: ") + std::to_string(gridSpace.index));
-			}
-			else
-			{
-				// Read a char (tag or empty)
-				if (c == ' ' || c == '-')
-				{
-					// Empty
-					gridSpace.type = GridSpaceType::EMPTY;
-					if (enableDebugLogging)
-						Logger::log("Read empty grid space");
-				}
-				else if (c == '+')
-				{
-					// Fill-in
-					gridSpace.type = GridSpaceType::FILL_IN;
-					if (enableDebugLogging)
-						Logger::log("Read fill-in grid space");
-				}
-				else
-				{
-					// Tagged
-					if (allowedTags.find(c) == std::string::npos)
-					{
-						// Disallowed tag: empty space
-						gridSpace.type = GridSpaceType::EMPTY;
-
-						Logger::logError(std::string("Invalid tag found in layer ")
-							+ std::to_string(currentLayerIndex + 1)
-							+ " in column " + std::to_string(i + 1)
-							+ " in row " + std::to_string(currentRowIndex + 1)
-							+ ": " + c);
-					}
-					else
-					{
-						gridSpace.type = GridSpaceType::TAG;
-						gridSpace.tag = c;
-						if (enableDebugLogging)
-							Logger::log(std::string("Read grid space with tag: ") + gridSpace.tag);
-					}
-				}
-			}
-
-			// Tile space index
-			unsigned int index = 
-				tileGridSize.x * tileGridSize.y * currentLayerIndex + 
-				currentRowIndex * tileGridSize.x + 
-				i;
-
-			gridSpaces[index] = gridSpace;
-
-			// Skip a space
-			file.get();
-		}
-		currentRowIndex++;
-
-		// Move to the next layer
-		if (currentRowIndex >= tileGridSize.y)
-		{
-			currentRowIndex = 0;
-			currentLayerIndex++;
-
-			// Check if we read all layers
-			if (currentLayerIndex >= layerCount)
-			{
-				break;
-			}
-		}
-	}
-
-	for (int i = 0; i < tileGridSize.x * tileGridSize.y * layerCount; i++)
-	{
-		switch (gridSpaces[i].type)
-		{
-			case GridSpaceType::EMPTY:
-				std::cout << ' ' << ' ' << std::endl;
-				break;
-			case GridSpaceType::FILL_IN:
-				std::cout << '+' << ' ' << std::endl;
-				break;
-			case GridSpaceType::TAG:
-				std::cout << gridSpaces[i].tag << ' ' << std::endl;
-				break;
-			case GridSpaceType::INDEX:
-				std::cout << gridSpaces[i].index << ' ' << std::endl;
-				break;
-		}
-	}
 
 	// Loading the texture
 	unsigned int textureID = TextureEngine::loadTexture(texturePath, pixelPerfect);
 
-	TileGrid* tileGrid = new TileGrid(textureID, textureGridSize, gridSpaces, tileGridSize, layerCount, tileSetName, tileSize);
+	// The grid spaces are only needed to choose the tiles, and are released after this
+	TileGrid* tileGrid = new TileGrid(textureID, textureGridSize, map, tileSetName, tileSize);
+	tileGrid->logMemoryUsage(dataPath);
 	return tileGrid;
 }
 
-GridSpace TileGrid::getGridSpaceAtIndex(unsigned int x, unsigned int y, unsigned int layer)
+void TileGrid::logMemoryUsage(const std::string& dataPath)
 {
-	// Check for out of local bounds
-	if (x < 0 || x >= tileGridSize.x ||
-		y < 0 || y >= tileGridSize.y)
+#if ROOT_LOG_MIN_LEVEL > LOG_LEVEL_LOG
+	// The report would not be logged, so it is not worth going over the layers for
+	return;
+#endif
+
+	std::size_t totalMemory{ 0 };
+	std::string layerMemory;
+
+	for (unsigned int l{ 0 }; l < layerCount; l++)
 	{
-		return GridSpace{ GridSpaceType::OUT_OF_BOUNDS };
-	}
+		std::size_t memory{ layers[l].getMemoryUsage() };
+		totalMemory += memory;
 
-	// Grid space index
-	unsigned int index =
-		tileGridSize.x * tileGridSize.y * layer +
-		y * tileGridSize.x +
-		x;
+		layerMemory += (l == 0 ? "" : ", ") + std::to_string(memory / 1024) + " KB ("
+			+ std::to_string(layers[l].getOccupiedChunkCount()) + "/"
+			+ std::to_string(chunkCount.x * chunkCount.y) + " chunks)";
+	}
 
-	/*
-	if (index >= tileGridSize.x * tileGridSize.y * layerCount)
-		Logger::logError("Getting grid space data at index out of bounds.");
-	*/
+	ROOT_LOG("Tile grid '" + dataPath + "' takes " + std::to_string(totalMemory / 1024)
+		+ " KB for its tiles, per layer: " + layerMemory);
+}
 
-	return gridSpaces[index];
+bool TileGrid::convertDataToBinary(const std::string& textPath, const std::string& binaryPath)
+{
+	return TileMapFile::convertTextToBinary(textPath, binaryPath);
 }
 
-void TileGrid::autoFillGridSpace(TileSet* tileSet,
-	unsigned int x,
-	unsigned int y,
+int TileGrid::autoFillGridSpace(const TileMapData& map,
+	TileSet* tileSet,
+	int x,
+	int y,
 	unsigned int layer,
 	char requiredTag)
 {
-	// Check for out of local bounds
-	if (x < 0 || x >= tileGridSize.x ||
-		y < 0 || y >= tileGridSize.y ||
-		layer < 0 || layer >= layerCount)
-	{
-		return;
-	}
-
-	// Grid space index
-	unsigned int index =
-		tileGridSize.x * tileGridSize.y * layer +
-		y * tileGridSize.x +
-		x;
+	if (tileSet == nullptr)
+		return -1;
 
 	glm::ivec2 offsets[] = {
 		glm::ivec2(-1, -1),
@@ -403,170 +172,128 @@ void TileGrid::autoFillGridSpace(TileSet* tileSet,
 		glm::ivec2(1, 1),
 	};
 
-	bool tileFound{ false };
-
-	unsigned int tileIndex{ 0 };
-
-	for (Tile& tile : tileSet->getTiles())
+	// Grid spaces outside of the tile map are out of bounds, which does not count as empty
+	bool neighbourEmpty[8];
+	for (unsigned int i{ 0 }; i < 8; i++)
 	{
-		// If the required tag is not '-', we must check if it matches the tile
-		if (requiredTag != '-' && tile.tag != requiredTag)
-		{
-			// Skip if it doesn't match
-			tileIndex++;
-			continue;
-		}
-
-		bool ruleBroken{ false };
-
-		// Checking all rules for this tile:
-		for (unsigned int i{ 0 }; i < 8; i++)
-		{
-			char rule = tile.rules[i];
-
-			GridSpace ruleSpace = getGridSpaceAtIndex(x + offsets[i].x, y + offsets[i].y, layer);
-
-			// A '~' means that there is no rule set for that neighbouring grid space.
-			if (rule == '~')
-			{
-				// Rule is always true
-				continue;
-			}
+		neighbourEmpty[i] = map.getGridSpace(x + offsets[i].x, y + offsets[i].y, layer).type == GridSpaceType::EMPTY;
+	}
 
-			// A '+' means that the rule is satisfied if a tile exists there.
-			if (rule == '+')
-			{
-				// Verify the rule
-				if (ruleSpace.type != GridSpaceType::EMPTY)
-					continue;
-				
-				// Check no more rules
-				ruleBroken = true;
-				break;
-			}
+	// Using the first tile whose rules are satisfied, or making the space empty if there is none
+	return tileSet->chooseTile(requiredTag, neighbourEmpty);
+}
 
-			// A '-' means that the rule is satisfied if no tile exists there.
-			if (rule == '-')
-			{
-				// Verify the rule
-				if (ruleSpace.type == GridSpaceType::EMPTY)
-					continue;
+void TileGrid::generateVAO()
+{
+	unsigned int chunksPerLayer = chunkCount.x * chunkCount.y;
+	const unsigned int chunkArea = TILE_GRID_CHUNK_SIZE * TILE_GRID_CHUNK_SIZE;
 
-				// Check no more rules
-				ruleBroken = true;
-				break;
-			}
+	// Gathering the chunks that hold tiles, so that empty chunks are neither uploaded nor drawn
+	std::vector<std::uint16_t> tiles;
+	std::vector<glm::ivec4> chunkPositions;
+	chunkSlots.assign(chunksPerLayer * layerCount, -1);
 
-			// A letter means that the rule is satisfied if a tile exists there,
-			// with a tag matching the letter.
+	for (unsigned int l{ 0 }; l < layerCount; l++)
+	{
+		for (int y{ 0 }; y < chunkCount.y; y++)
+		{
+			for (int x{ 0 }; x < chunkCount.x; x++)
 			{
-				// Verify the rule
-				if (ruleSpace.type == GridSpaceType::EMPTY)
+				const std::uint16_t* chunkTiles = layers[l].getChunk(glm::ivec2(x, y));
+				if (chunkTiles == nullptr)
 					continue;
 
-				// Check no more rules
-				ruleBroken = true;
-				break;
+				chunkSlots[chunksPerLayer * l + y * chunkCount.x + x] = chunkPositions.size();
+				chunkPositions.push_back(glm::ivec4(x * TILE_GRID_CHUNK_SIZE, y * TILE_GRID_CHUNK_SIZE, l, 0));
+				tiles.insert(tiles.end(), chunkTiles, chunkTiles + chunkArea);
 			}
 		}
-
-
-
-		// Logger::log(std::string("Rule broken: ") + std::to_string(ruleBroken));
-
-		// If we found a non-rule breaking tile, set it as the tile for the spot
-		if (!ruleBroken)
-		{
-			tileIndices[index] = tileIndex;
-			tileFound = true;
-			break;
-		}
-
-		tileIndex++;
 	}
 
-	if (!tileFound)
-	{
-		// Make the tile empty
-		tileIndices[index] = -1;
-	}
-}
+	uploadedChunkCount = chunkPositions.size();
 
-void TileGrid::generateVAO()
-{
-	if (tileIndices == nullptr)
+	if (tileMapVAO == 0)
 	{
-		return;
+		glGenVertexArrays(1, &tileMapVAO);
+		glGenBuffers(1, &tileIndicesVBO);
+		glGenBuffers(1, &chunkPositionsSSBO);
 	}
 
-	unsigned int VBO{ 0 };
-
-	glGenVertexArrays(1, &tileMapVAO);
-	glGenBuffers(1, &VBO);
-
 	glBindVertexArray(tileMapVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, tileIndicesVBO);
 
-	glBufferData(GL_ARRAY_BUFFER, sizeof(int) * tileGridSize.x * tileGridSize.y * layerCount, tileIndices, GL_STATIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(std::uint16_t) * tiles.size(), tiles.data(), GL_STATIC_DRAW);
 
-	glVertexAttribIPointer(0, 1, GL_INT, sizeof(int), (void*)0);
+	// Read as signed, so empty spaces (0xFFFF) are -1 in the shader
+	glVertexAttribIPointer(0, 1, GL_SHORT, sizeof(std::uint16_t), (void*)0);
 	glEnableVertexAttribArray(0);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, chunkPositionsSSBO);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(glm::ivec4) * chunkPositions.size(), chunkPositions.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
-void TileGrid::generateTileIndices()
+void TileGrid::generateTileIndices(const TileMapData& map)
 {
-	if (tileIndices != nullptr)
-		free(tileIndices);
-
-	// Creating space for the tile indices
-	tileIndices = (int*)malloc(tileGridSize.x * tileGridSize.y * layerCount * sizeof(int));
+	layers.clear();
+	layers.reserve(layerCount);
+	for (unsigned int l{ 0 }; l < layerCount; l++)
+	{
+		layers.emplace_back(tileGridSize);
+	}
 
 	TileSet* tileSet = TileGridEngine::getTileSet(tileSetName);
 
-	if (tileSet == nullptr)
-		return;
+	unsigned int invalidIndices{ 0 };
 
 	for (unsigned int l{ 0 }; l < layerCount; l++)
 	{
-		for (unsigned int y{ 0 }; y < tileGridSize.y; y++)
+		for (int y{ 0 }; y < tileGridSize.y; y++)
 		{
-			for (unsigned int x{ 0 }; x < tileGridSize.x; x++)
+			for (int x{ 0 }; x < tileGridSize.x; x++)
 			{
-				GridSpace gridSpace = getGridSpaceAtIndex(x, y, l);
+				GridSpace gridSpace = map.getGridSpace(x, y, l);
 
-				// Grid space index
-				unsigned int index =
-					tileGridSize.x * tileGridSize.y * l +
-					y * tileGridSize.x +
-					x;
+				int tileIndex{ -1 };
 
 				switch (gridSpace.type)
 				{
-					case GridSpaceType::EMPTY:
-						// Indicate an empty space
-						tileIndices[index] = -1;
-						break;
-
 					case GridSpaceType::FILL_IN:
-						autoFillGridSpace(tileSet, x, y, l, '-');
+						tileIndex = autoFillGridSpace(map, tileSet, x, y, l, '-');
 						break;
 
 					case GridSpaceType::TAG:
-						autoFillGridSpace(tileSet, x, y, l, gridSpace.tag);
+						tileIndex = autoFillGridSpace(map, tileSet, x, y, l, gridSpace.tag);
 						break;
 
 					case GridSpaceType::INDEX:
 						// Use the index directly
-						tileIndices[index] = gridSpace.index;
+						tileIndex = gridSpace.index;
 						break;
 				}
+
+				if (tileIndex > TILE_LAYER_MAX_TILE_INDEX)
+				{
+					invalidIndices++;
+					continue;
+				}
+
+				// Empty spaces are already empty
+				if (tileIndex != -1)
+					layers[l].setTile(glm::ivec2(x, y), tileIndex);
 			}
 		}
 	}
 
+	if (invalidIndices > 0)
+	{
+		Logger::logError(std::to_string(invalidIndices) + " tiles in the tile grid have an index above "
+			+ std::to_string(TILE_LAYER_MAX_TILE_INDEX) + ", they are left empty.");
+	}
+
 	// Putting the new indices into the VAO
 	generateVAO();
 }
@@ -576,7 +303,74 @@ glm::ivec2 TileGrid::getGridSize()
 	return tileGridSize;
 }
 
-int* TileGrid::getData()
+unsigned int TileGrid::getLayerCount()
 {
-	return tileIndices;
+	return layerCount;
+}
+
+std::size_t TileGrid::getLayerMemoryUsage(unsigned int layer)
+{
+	if (layer >= layerCount)
+		return 0;
+
+	return layers[layer].getMemoryUsage();
+}
+
+void TileGrid::setTile(glm::ivec2 position, unsigned int layer, int tileIndex)
+{
+	if (position.x < 0 || position.x >= tileGridSize.x
+		|| position.y < 0 || position.y >= tileGridSize.y
+		|| layer >= layerCount)
+	{
+		Logger::logError("Cannot set the tile at (" + std::to_string(position.x) + ", "
+			+ std::to_string(position.y) + ") on layer " + std::to_string(layer)
+			+ ": it is outside of the tile grid.");
+		return;
+	}
+
+	if (tileIndex < -1 || tileIndex > TILE_LAYER_MAX_TILE_INDEX)
+	{
+		Logger::logError("Cannot set the tile at (" + std::to_string(position.x) + ", "
+			+ std::to_string(position.y) + ") to " + std::to_string(tileIndex)
+			+ ": tile indices must be at most " + std::to_string(TILE_LAYER_MAX_TILE_INDEX) + ".");
+		return;
+	}
+
+	if (!layers[layer].setTile(position, tileIndex))
+		return;
+
+	glm::ivec2 chunk{ position / TILE_GRID_CHUNK_SIZE };
+	unsigned int chunkIndex{ chunkCount.x * chunkCount.y * layer + chunk.y * chunkCount.x + chunk.x };
+
+	const std::uint16_t* chunkTiles{ layers[layer].getChunk(chunk) };
+
+	if (chunkSlots[chunkIndex] != -1 && chunkTiles != nullptr)
+	{
+		// Only the changed tile is uploaded
+		glm::ivec2 positionInChunk{ position % TILE_GRID_CHUNK_SIZE };
+		unsigned int indexInChunk = positionInChunk.y * TILE_GRID_CHUNK_SIZE + positionInChunk.x;
+
+		glBindBuffer(GL_ARRAY_BUFFER, tileIndicesVBO);
+		glBufferSubData(GL_ARRAY_BUFFER,
+			sizeof(std::uint16_t) * (chunkSlots[chunkIndex] * TILE_GRID_CHUNK_SIZE * TILE_GRID_CHUNK_SIZE + indexInChunk),
+			sizeof(std::uint16_t), &chunkTiles[indexInChunk]);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+	else
+	{
+		// The chunk was filled or emptied, so the chunks are gathered again
+		generateVAO();
+	}
+
+	// Letting colliders know this chunk changed
+	chunkRevisions[chunkIndex]++;
+	revision++;
+}
+
+int TileGrid::getTile(glm::ivec2 position, unsigned int layer)
+{
+	if (layer >= layerCount)
+		return -1;
+
+	return layers[layer].getTile(position);
 }
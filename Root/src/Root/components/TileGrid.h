@@ -1,9 +1,12 @@
 #pragma once
 
 #include <Root/tilegrids/TileSet.h>
+#include <Root/tilegrids/TileMapFile.h>
+#include <Root/tilegrids/TileLayer.h>
 
 #include <Root/components/Component.h>
 #include <Root/Transform.h>
+#include <Root/StringID.h>
 
 #include <glm/glm.hpp>
 
@@ -13,22 +16,6 @@
 #include <fstream>
 #include <memory>
 
-enum class GridSpaceType
-{
-	EMPTY,
-	FILL_IN,
-	INDEX,
-	TAG,
-	OUT_OF_BOUNDS
-};
-
-struct GridSpace
-{
-	GridSpaceType type;
-	unsigned int index; // For index grid spaces
-	char tag; // For tag grid spaces
-};
-
 class TileGrid : public Component
 {
 public:
@@ -42,7 +29,7 @@ public:
 	 * \param texture: the path to the texture to use.
 	 * \param pixelPerfect: whether the texture should be pixel perfect.
 	 * \param textureGridSize: the amount of columns, rows in the texture.
-	 * \param data: the path to the tile grid data
+	 * \param data: the path to the tile grid data, in the text or the binary format.
 	 * \param tileSetName: the name of the tile set to use.
 	 * \param tileSize: the size of each tile, default = 1.
 	 */
@@ -56,6 +43,15 @@ public:
 
 	void render(float renderDepth) override;
 
+	/**
+	 * Convert tile grid data from the text format to the binary format, which loads much faster.
+	 * 
+	 * \param textPath: the path to the tile grid data in the text format.
+	 * \param binaryPath: the path to write the tile grid data in the binary format to.
+	 * \returns whether the data was converted.
+	 */
+	static bool convertDataToBinary(const std::string& textPath, const std::string& binaryPath);
+
 	/**
 	 * Add a tile to the tile grid.
 	 * 
@@ -81,21 +77,45 @@ public:
 	 */
 	glm::ivec2 getGridSize();
 
+	/**
+	 * Get the number of layers.
+	 */
+	unsigned int getLayerCount();
+
+	/**
+	 * Get how much memory the tiles of a layer take, which depends on how many of its chunks hold tiles.
+	 *
+	 * \param layer: the layer.
+	 * \returns the number of bytes the layer uses.
+	 */
+	std::size_t getLayerMemoryUsage(unsigned int layer);
+
+	/**
+	 * Set the tile at a position in the grid.
+	 * The tile index is used directly, surrounding tiles are not auto-filled again.
+	 * Tile grid colliders pick up the change with TileGridCollider::updateChangedTiles().
+	 *
+	 * \param position: the position in the grid.
+	 * \param layer: the layer to set the tile on.
+	 * \param tileIndex: the index of the tile in the tile set (at most TILE_LAYER_MAX_TILE_INDEX),
+	 * or -1 to make the space empty.
+	 */
+	void setTile(glm::ivec2 position, unsigned int layer, int tileIndex);
 
 	/**
-	 * Get the tile grid data.
+	 * Get the tile at a position in the grid.
 	 *
-	 * \returns the tile grid data (tile index per grid square).
+	 * \param position: the position in the grid.
+	 * \param layer: the layer to get the tile from.
+	 * \returns the index of the tile in the tile set, or -1 if the space is empty or out of bounds.
 	 */
-	int* getData();
+	int getTile(glm::ivec2 position, unsigned int layer);
 
 private:
 
 	TileGrid(unsigned int texture,
 		glm::ivec2 textureGridSize,
-		GridSpace* data,
-		glm::ivec2 tileGridSize,
-		unsigned int layerCount,
+		const TileMapData& map,
 		std::string tileSet,
 		float tileSize);
 
@@ -106,23 +126,33 @@ private:
 		const std::string& tileSetName,
 		float tileSize);
 
-	void generateTileIndices();
-
-	GridSpace getGridSpaceAtIndex(unsigned int x, unsigned int y, unsigned int layer);
+	/**
+	 * Choose the tiles for all grid spaces of a tile map.
+	 */
+	void generateTileIndices(const TileMapData& map);
 
-	void autoFillGridSpace(TileSet* tileSet,
-		unsigned int x,
-		unsigned int y,
+	/**
+	 * Choose the tile for a fill-in or tag grid space from its neighbours.
+	 *
+	 * \returns the index of the tile, or -1 if no tile fits.
+	 */
+	int autoFillGridSpace(const TileMapData& map,
+		TileSet* tileSet,
+		int x,
+		int y,
 		unsigned int layer,
 		char requiredTag);
 
+	/**
+	 * Upload the chunks that hold tiles, skipping empty chunks.
+	 */
 	void generateVAO();
 
-	float tileSize{ 1.0f };
+	void logMemoryUsage(const std::string& dataPath);
 
-	std::string tileSetName{ "" };
+	float tileSize{ 1.0f };
 
-	int* tileIndices{ nullptr };
+	StringID tileSetName{ EMPTY_STRING_ID };
 
 	glm::ivec2 tileGridSize{ glm::ivec2(0) };
 
@@ -130,11 +160,27 @@ private:
 	glm::ivec2 textureGridSize{ glm::ivec2(0) };
 
 	unsigned int layerCount{ 0 };
-	
-	GridSpace* gridSpaces;
+
+	// The tiles of each layer, stored sparsely in chunks
+	std::vector<TileLayer> layers;
 
 	unsigned int textureID{ 0 };
 	unsigned int tileMapVAO{ 0 };
+	unsigned int tileIndicesVBO{ 0 };
+	// The position of each uploaded chunk
+	unsigned int chunkPositionsSSBO{ 0 };
+
+	// Where each chunk is in the uploaded tiles, per layer and chunk, or -1 if the chunk is empty
+	std::vector<int> chunkSlots;
+	unsigned int uploadedChunkCount{ 0 };
+
+	// The number of chunks horizontally, vertically
+	glm::ivec2 chunkCount{ glm::ivec2(0) };
+
+	// Incremented whenever a tile in a chunk changes, per layer and chunk
+	std::vector<unsigned int> chunkRevisions;
+	// Incremented whenever any tile changes, so colliders can cheaply check for changes every frame
+	unsigned int revision{ 0 };
 
 	// Give class TileGridCollider access
 	friend class TileGridCollider;
@@ -0,0 +1,743 @@
+#include "TileWorld.h"
+
+#include <Root/Root.h>
+#include <Root/components/Rigidbody.h>
+#include <Root/colliders/TileWorldCollider.h>
+#include <Root/engine/TextureEngine.h>
+#include <Root/engine/TileGridEngine.h>
+
+#include <simpleprofiler/Profiler.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+	// The width of a chunk with a border of one grid space on each side, which is how chunks are stored
+	const int storedChunkSize{ TILE_WORLD_CHUNK_SIZE + 2 };
+
+	// The width of the grid spaces that are read for a chunk:
+	// auto-filling the border of a chunk needs one more grid space around it
+	const int readChunkSize{ TILE_WORLD_CHUNK_SIZE + 4 };
+
+	// The neighbouring grid spaces, in the order of the tile rules
+	const glm::ivec2 ruleOffsets[8]{
+		glm::ivec2(-1, -1),
+		glm::ivec2(0, -1),
+		glm::ivec2(1, -1),
+		glm::ivec2(-1, 0),
+		glm::ivec2(1, 0),
+		glm::ivec2(-1, 1),
+		glm::ivec2(0, 1),
+		glm::ivec2(1, 1),
+	};
+
+	// A side of a tile that can get a collision edge
+	struct EdgeSide
+	{
+		// The direction the edge runs in, so that the tile is on its left
+		glm::ivec2 direction;
+		// The direction of the empty grid space on the other side of the edge
+		glm::ivec2 normal;
+	};
+
+	// In grid space, where y goes down
+	const EdgeSide edgeSides[4]{
+		EdgeSide{ glm::ivec2(-1, 0), glm::ivec2(0, -1) }, // Top
+		EdgeSide{ glm::ivec2(1, 0), glm::ivec2(0, 1) }, // Bottom
+		EdgeSide{ glm::ivec2(0, 1), glm::ivec2(-1, 0) }, // Left
+		EdgeSide{ glm::ivec2(0, -1), glm::ivec2(1, 0) }, // Right
+	};
+
+	float squaredDistance(glm::ivec2 a, glm::vec2 b)
+	{
+		glm::vec2 difference{ glm::vec2(a) - b };
+		return glm::dot(difference, difference);
+	}
+}
+
+TileWorld::~TileWorld()
+{
+	{
+		std::lock_guard<std::mutex> lock{ queueMutex };
+		stopLoaders = true;
+	}
+	queueCondition.notify_all();
+
+	for (std::thread& loader : loaders)
+	{
+		loader.join();
+	}
+
+	for (auto& [key, chunk] : chunks)
+	{
+		releaseChunk(chunk);
+	}
+
+	Logger::destructorMessage("Tile world");
+}
+
+TileWorld* TileWorld::create(Transform* transform,
+	const std::string& texturePath,
+	bool pixelPerfect,
+	glm::ivec2 textureGridSize,
+	const std::string& dataPath,
+	const std::string& tileSetName,
+	float tileSize,
+	unsigned int loaderThreadCount)
+{
+	std::unique_ptr<TileMapStream> stream{ new TileMapStream() };
+	if (!stream->open(dataPath))
+	{
+		// Something went wrong: don't create a tile world
+		return nullptr;
+	}
+
+	StringID tileSetID{ StringInterner::intern(tileSetName) };
+	if (TileGridEngine::getTileSet(tileSetID) == nullptr)
+	{
+		Logger::logError("Cannot create a tile world with tile set '" + tileSetName + "'; It does not exist.");
+		return nullptr;
+	}
+
+	// Loading the texture
+	unsigned int textureID = TextureEngine::loadTexture(texturePath, pixelPerfect);
+
+	TileWorld* tileWorld = new TileWorld(textureID, textureGridSize, std::move(stream), tileSetID, tileSize, loaderThreadCount);
+
+	std::shared_ptr<TileWorld> pointer{ tileWorld };
+	transform->addComponent(pointer);
+	return tileWorld;
+}
+
+TileWorld::TileWorld(unsigned int texture,
+	glm::ivec2 textureGridSize,
+	std::unique_ptr<TileMapStream> stream,
+	StringID tileSetName,
+	float tileSize,
+	unsigned int loaderThreadCount)
+	: textureID(texture)
+	, textureGridSize(textureGridSize)
+	, stream(std::move(stream))
+	, tileSetName(tileSetName)
+	, tileSize(tileSize)
+{
+	tileSet = TileGridEngine::getTileSet(tileSetName);
+	tileGridSize = this->stream->getSize();
+	layerCount = this->stream->getLayerCount();
+	chunkCount = (tileGridSize + glm::ivec2(TILE_WORLD_CHUNK_SIZE - 1)) / TILE_WORLD_CHUNK_SIZE;
+
+	for (unsigned int i{ 0 }; i < std::max(loaderThreadCount, 1u); i++)
+	{
+		loaders.emplace_back(&TileWorld::loaderThread, this);
+	}
+}
+
+void TileWorld::update()
+{
+	frame++;
+
+	updateCollision();
+	receiveChunks();
+
+	unsigned int uploadedChunks{ 0 };
+
+	if (getVisibleChunks(visibleMin, visibleMax))
+	{
+		loadedMin = glm::max(visibleMin - glm::ivec2(loadMargin), glm::ivec2(0));
+		loadedMax = glm::min(visibleMax + glm::ivec2(loadMargin), chunkCount - 1);
+
+		requestChunks(loadedMin, loadedMax);
+		uploadedChunks = uploadChunks(loadedMin, loadedMax);
+	}
+	else
+	{
+		// Nothing is needed, so the cache may keep everything that is loaded
+		visibleMin = loadedMin = glm::ivec2(0);
+		visibleMax = loadedMax = glm::ivec2(-1);
+
+		requestChunks(loadedMin, loadedMax);
+	}
+
+	evictChunks();
+
+	Profiler::setCounter("Tile world chunks resident", chunks.size());
+	Profiler::setCounter("Tile world chunks loading", pendingChunks.size());
+	Profiler::setCounter("Tile world chunks uploaded", uploadedChunks);
+}
+
+void TileWorld::render(float renderDepth)
+{
+	if (tileSet == nullptr)
+		return;
+
+	tileSet->bindSSBO();
+
+	// Getting the shader
+	Shader* tileRenderShader{ Root::getTileGridRenderShader() };
+
+	// Setting shader variables shared by all chunks
+	tileRenderShader->use();
+	tileRenderShader->setMat4("view", Root::getActiveCamera()->getTransform()->getInverseTransformMatrix());
+	tileRenderShader->setMat4("projection", Root::getActiveCamera()->getProjectionMatrix());
+	tileRenderShader->setInt("sprite", 0);
+	tileRenderShader->setFloat("renderDepth", renderDepth / 10000.0f);
+	tileRenderShader->setIVector2("tileGridSize", glm::ivec2(TILE_WORLD_CHUNK_SIZE));
+	// Every chunk is drawn as a tile grid of its own, with its tiles stored row by row
+	tileRenderShader->setInt("chunkSize", 0);
+	tileRenderShader->setIVector2("textureGridSize", textureGridSize);
+	tileRenderShader->setFloat("tileSize", tileSize);
+
+	// Binding the sprite
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	glm::mat4 model{ transform->getModelMatrix() };
+
+	// Only drawing the chunks in view, each as a tile grid of its own moved to its place in the world
+	for (int y{ visibleMin.y }; y <= visibleMax.y; y++)
+	{
+		for (int x{ visibleMin.x }; x <= visibleMax.x; x++)
+		{
+			unsigned int key{ getChunkKey(glm::ivec2(x, y)) };
+
+			auto iterator = chunks.find(key);
+			if (iterator == chunks.end() || iterator->second.vao == 0)
+				continue;
+
+			glm::vec2 chunkCenter{ glm::vec2(x, y) * (float)TILE_WORLD_CHUNK_SIZE
+				+ TILE_WORLD_CHUNK_SIZE / 2.0f - glm::vec2(tileGridSize) / 2.0f };
+
+			tileRenderShader->setMat4("model", glm::translate(model, glm::vec3(chunkCenter * tileSize * 2.0f, 0.0f)));
+			// Giving every chunk different random animation offsets, after the tile IDs of all layers of the previous chunk
+			tileRenderShader->setInt("tileIndexRandomisationSeed", (int)(key * TILE_WORLD_CHUNK_SIZE * TILE_WORLD_CHUNK_SIZE * layerCount));
+
+			glBindVertexArray(iterator->second.vao);
+			glDrawArrays(GL_POINTS, 0, TILE_WORLD_CHUNK_SIZE * TILE_WORLD_CHUNK_SIZE * layerCount);
+		}
+	}
+
+	glBindVertexArray(0);
+}
+
+void TileWorld::setLoadMargin(unsigned int margin)
+{
+	loadMargin = margin;
+}
+
+void TileWorld::setCacheSize(unsigned int chunkCount)
+{
+	cacheSize = chunkCount;
+}
+
+void TileWorld::setUploadBudget(unsigned int chunkCount)
+{
+	uploadBudget = std::max(chunkCount, 1u);
+}
+
+glm::ivec2 TileWorld::getGridSize()
+{
+	return tileGridSize;
+}
+
+unsigned int TileWorld::getLayerCount()
+{
+	return layerCount;
+}
+
+int TileWorld::getTile(glm::ivec2 position, unsigned int layer)
+{
+	if (position.x < 0 || position.x >= tileGridSize.x
+		|| position.y < 0 || position.y >= tileGridSize.y
+		|| layer >= layerCount)
+	{
+		return -1;
+	}
+
+	glm::ivec2 chunk{ position / TILE_WORLD_CHUNK_SIZE };
+
+	auto iterator = chunks.find(getChunkKey(chunk));
+	if (iterator == chunks.end())
+		return -1;
+
+	glm::ivec2 square{ position - chunk * TILE_WORLD_CHUNK_SIZE + 1 };
+	return iterator->second.data.tileIndices[
+		layer * storedChunkSize * storedChunkSize + square.y * storedChunkSize + square.x];
+}
+
+bool TileWorld::isLoaded(glm::ivec2 position)
+{
+	if (position.x < 0 || position.x >= tileGridSize.x
+		|| position.y < 0 || position.y >= tileGridSize.y)
+	{
+		return false;
+	}
+
+	auto iterator = chunks.find(getChunkKey(position / TILE_WORLD_CHUNK_SIZE));
+	return iterator != chunks.end() && iterator->second.vao != 0;
+}
+
+void TileWorld::loaderThread()
+{
+	while (true)
+	{
+		ChunkData data;
+
+		{
+			std::unique_lock<std::mutex> lock{ queueMutex };
+			queueCondition.wait(lock, [this]() { return stopLoaders || !requestQueue.empty(); });
+
+			if (stopLoaders)
+				return;
+
+			data.chunk = requestQueue.front();
+			requestQueue.pop_front();
+		}
+
+		loadChunk(data, collisionLayer.load());
+
+		std::lock_guard<std::mutex> lock{ queueMutex };
+		finishedChunks.push_back(std::move(data));
+	}
+}
+
+void TileWorld::loadChunk(ChunkData& data, int edgeLayer) const
+{
+	glm::ivec2 origin{ data.chunk * TILE_WORLD_CHUNK_SIZE };
+
+	std::vector<GridSpace> gridSpaces(readChunkSize * readChunkSize);
+	data.tileIndices.assign(storedChunkSize * storedChunkSize * layerCount, -1);
+
+	for (unsigned int layer{ 0 }; layer < layerCount; layer++)
+	{
+		// Reading the chunk with a border of two grid spaces, straight from the mapped file
+		stream->readRegion(origin - 2, glm::ivec2(readChunkSize), layer, gridSpaces.data());
+
+		int* tileIndices{ data.tileIndices.data() + layer * storedChunkSize * storedChunkSize };
+
+		// Choosing the tiles for the chunk and the first grid space around it,
+		// with the second grid space around it as the neighbours of the border
+		for (int y{ 0 }; y < storedChunkSize; y++)
+		{
+			for (int x{ 0 }; x < storedChunkSize; x++)
+			{
+				const GridSpace& gridSpace{ gridSpaces[(y + 1) * readChunkSize + (x + 1)] };
+				int& tileIndex{ tileIndices[y * storedChunkSize + x] };
+
+				if (gridSpace.type == GridSpaceType::INDEX)
+				{
+					// Use the index directly
+					tileIndex = gridSpace.index;
+					continue;
+				}
+
+				if ((gridSpace.type != GridSpaceType::FILL_IN && gridSpace.type != GridSpaceType::TAG)
+					|| tileSet == nullptr)
+				{
+					continue;
+				}
+
+				bool neighbourEmpty[8];
+				for (unsigned int i{ 0 }; i < 8; i++)
+				{
+					glm::ivec2 neighbour{ glm::ivec2(x + 1, y + 1) + ruleOffsets[i] };
+					neighbourEmpty[i] = gridSpaces[neighbour.y * readChunkSize + neighbour.x].type == GridSpaceType::EMPTY;
+				}
+
+				tileIndex = tileSet->chooseTile(
+					gridSpace.type == GridSpaceType::TAG ? gridSpace.tag : '-', neighbourEmpty);
+			}
+		}
+	}
+
+	generateEdges(data, edgeLayer);
+}
+
+void TileWorld::generateEdges(ChunkData& data, int edgeLayer) const
+{
+	data.edges.clear();
+	data.edgeLayer = -1;
+
+	if (edgeLayer < 0 || edgeLayer >= (int)layerCount)
+		return;
+
+	data.edgeLayer = edgeLayer;
+
+	const int* tileIndices{ data.tileIndices.data() + edgeLayer * storedChunkSize * storedChunkSize };
+	glm::ivec2 origin{ data.chunk * TILE_WORLD_CHUNK_SIZE };
+
+	// Squares are relative to the chunk, and may lie in the border around it.
+	// Grid spaces outside of the world are empty, just like for a TileGridCollider.
+	auto isSolid = [&](glm::ivec2 square)
+	{
+		return tileIndices[(square.y + 1) * storedChunkSize + (square.x + 1)] != -1;
+	};
+
+	auto isInChunk = [](glm::ivec2 square)
+	{
+		return square.x >= 0 && square.x < TILE_WORLD_CHUNK_SIZE
+			&& square.y >= 0 && square.y < TILE_WORLD_CHUNK_SIZE;
+	};
+
+	// Converting a corner in grid space to the space of the rigidbody, the same way a TileGridCollider does
+	auto toBodySpace = [&](glm::vec2 corner)
+	{
+		glm::vec2 position{ (glm::vec2(origin) + corner - glm::vec2(tileGridSize) / 2.0f) * tileSize * glm::vec2(1, -1) };
+		return b2Vec2(position.x, position.y);
+	};
+
+	for (const EdgeSide& side : edgeSides)
+	{
+		auto hasEdge = [&](glm::ivec2 square)
+		{
+			return isSolid(square) && !isSolid(square + side.normal);
+		};
+
+		glm::vec2 direction{ side.direction };
+		glm::vec2 normal{ side.normal };
+
+		for (int y{ 0 }; y < TILE_WORLD_CHUNK_SIZE; y++)
+		{
+			for (int x{ 0 }; x < TILE_WORLD_CHUNK_SIZE; x++)
+			{
+				glm::ivec2 first{ x, y };
+
+				// Only starting at the first square of a run of edges, and merging the run into one edge
+				if (!hasEdge(first) || (isInChunk(first - side.direction) && hasEdge(first - side.direction)))
+					continue;
+
+				glm::ivec2 last{ first };
+				while (isInChunk(last + side.direction) && hasEdge(last + side.direction))
+				{
+					last += side.direction;
+				}
+
+				glm::vec2 start{ glm::vec2(first) + 0.5f + normal * 0.5f - direction * 0.5f };
+				glm::vec2 end{ glm::vec2(last) + 0.5f + normal * 0.5f + direction * 0.5f };
+
+				// The ghost vertices follow the outline past both ends of the edge, also into neighbouring chunks,
+				// so that bodies slide over the seams without catching on them
+				glm::ivec2 before{ first - side.direction };
+				glm::vec2 previous{ !isSolid(before) ? start - normal
+					: isSolid(before + side.normal) ? start + normal
+					: start - direction };
+
+				glm::ivec2 after{ last + side.direction };
+				glm::vec2 next{ !isSolid(after) ? end - normal
+					: isSolid(after + side.normal) ? end + normal
+					: end + direction };
+
+				b2EdgeShape& edge{ data.edges.emplace_back() };
+				edge.SetOneSided(toBodySpace(previous), toBodySpace(start), toBodySpace(end), toBodySpace(next));
+			}
+		}
+	}
+}
+
+bool TileWorld::getVisibleChunks(glm::ivec2& min, glm::ivec2& max)
+{
+	Camera* camera{ Root::getActiveCamera() };
+	if (camera == nullptr || chunkCount.x <= 0 || chunkCount.y <= 0)
+		return false;
+
+	// Finding the corners of the screen in the space of the tile world
+	glm::mat4 screenToLocal{ glm::inverse(camera->getProjectionMatrix()
+		* camera->getTransform()->getInverseTransformMatrix()
+		* transform->getModelMatrix()) };
+
+	glm::vec2 localMin{ std::numeric_limits<float>::max() };
+	glm::vec2 localMax{ std::numeric_limits<float>::lowest() };
+
+	const glm::vec2 screenCorners[4]{ glm::vec2(-1, -1), glm::vec2(1, -1), glm::vec2(-1, 1), glm::vec2(1, 1) };
+	for (const glm::vec2& screenCorner : screenCorners)
+	{
+		glm::vec4 corner{ screenToLocal * glm::vec4(screenCorner, 0.0f, 1.0f) };
+		glm::vec2 localCorner{ glm::vec2(corner) / corner.w };
+
+		localMin = glm::min(localMin, localCorner);
+		localMax = glm::max(localMax, localCorner);
+	}
+
+	// Every tile is tileSize * 2 wide, and the tile world is centered on its transform
+	glm::vec2 gridMin{ localMin / (tileSize * 2.0f) + glm::vec2(tileGridSize) / 2.0f };
+	glm::vec2 gridMax{ localMax / (tileSize * 2.0f) + glm::vec2(tileGridSize) / 2.0f };
+
+	glm::ivec2 chunkMin{ glm::floor(gridMin / (float)TILE_WORLD_CHUNK_SIZE) };
+	glm::ivec2 chunkMax{ glm::floor(gridMax / (float)TILE_WORLD_CHUNK_SIZE) };
+
+	if (chunkMax.x < 0 || chunkMax.y < 0 || chunkMin.x >= chunkCount.x || chunkMin.y >= chunkCount.y)
+		return false;
+
+	min = glm::max(chunkMin, glm::ivec2(0));
+	max = glm::min(chunkMax, chunkCount - 1);
+	return true;
+}
+
+void TileWorld::requestChunks(glm::ivec2 min, glm::ivec2 max)
+{
+	glm::vec2 center{ glm::vec2(min + max) / 2.0f };
+
+	auto isInArea = [&](glm::ivec2 chunk)
+	{
+		return chunk.x >= min.x && chunk.x <= max.x && chunk.y >= min.y && chunk.y <= max.y;
+	};
+
+	std::vector<glm::ivec2> requests;
+
+	{
+		std::lock_guard<std::mutex> lock{ queueMutex };
+
+		// Forgetting requests that no loader started on and that are not needed anymore
+		for (glm::ivec2 chunk : requestQueue)
+		{
+			if (isInArea(chunk))
+				requests.push_back(chunk);
+			else
+				pendingChunks.erase(getChunkKey(chunk));
+		}
+	}
+
+	for (int y{ min.y }; y <= max.y; y++)
+	{
+		for (int x{ min.x }; x <= max.x; x++)
+		{
+			unsigned int key{ getChunkKey(glm::ivec2(x, y)) };
+
+			auto iterator = chunks.find(key);
+			if (iterator != chunks.end())
+			{
+				iterator->second.lastUsedFrame = frame;
+				continue;
+			}
+
+			if (pendingChunks.insert(key).second)
+				requests.push_back(glm::ivec2(x, y));
+		}
+	}
+
+	// Loading the chunks closest to the center of the view first
+	std::sort(requests.begin(), requests.end(), [&](glm::ivec2 a, glm::ivec2 b)
+		{
+			return squaredDistance(a, center) < squaredDistance(b, center);
+		});
+
+	{
+		std::lock_guard<std::mutex> lock{ queueMutex };
+		requestQueue.assign(requests.begin(), requests.end());
+	}
+
+	if (!requests.empty())
+		queueCondition.notify_all();
+}
+
+void TileWorld::receiveChunks()
+{
+	std::vector<ChunkData> received;
+
+	{
+		std::lock_guard<std::mutex> lock{ queueMutex };
+		received.swap(finishedChunks);
+	}
+
+	int edgeLayer{ collisionLayer.load() };
+
+	for (ChunkData& data : received)
+	{
+		unsigned int key{ getChunkKey(data.chunk) };
+		pendingChunks.erase(key);
+
+		// The collider changed while the chunk was loading
+		if (data.edgeLayer != edgeLayer)
+			generateEdges(data, edgeLayer);
+
+		Chunk& chunk{ chunks[key] };
+		chunk.data = std::move(data);
+		chunk.lastUsedFrame = frame;
+	}
+}
+
+unsigned int TileWorld::uploadChunks(glm::ivec2 min, glm::ivec2 max)
+{
+	bool hasRigidbody{ !collisionRigidbody.expired() };
+
+	std::vector<Chunk*> waiting;
+
+	for (int y{ min.y }; y <= max.y; y++)
+	{
+		for (int x{ min.x }; x <= max.x; x++)
+		{
+			auto iterator = chunks.find(getChunkKey(glm::ivec2(x, y)));
+			if (iterator == chunks.end())
+				continue;
+
+			Chunk& chunk{ iterator->second };
+			bool needsFixtures{ hasRigidbody && !chunk.hasFixtures && !chunk.data.edges.empty() };
+
+			if (chunk.vao == 0 || needsFixtures)
+				waiting.push_back(&chunk);
+		}
+	}
+
+	glm::vec2 center{ glm::vec2(min + max) / 2.0f };
+
+	// Uploading the chunks closest to the center of the view first, a limited number per frame
+	unsigned int uploadCount{ std::min(uploadBudget, (unsigned int)waiting.size()) };
+	std::partial_sort(waiting.begin(), waiting.begin() + uploadCount, waiting.end(), [&](Chunk* a, Chunk* b)
+		{
+			return squaredDistance(a->data.chunk, center) < squaredDistance(b->data.chunk, center);
+		});
+
+	for (unsigned int i{ 0 }; i < uploadCount; i++)
+	{
+		if (waiting[i]->vao == 0)
+			uploadChunk(*waiting[i]);
+
+		setChunkFixtures(*waiting[i], true);
+	}
+
+	return uploadCount;
+}
+
+void TileWorld::evictChunks()
+{
+	auto isLoadedArea = [&](glm::ivec2 chunk)
+	{
+		return chunk.x >= loadedMin.x && chunk.x <= loadedMax.x && chunk.y >= loadedMin.y && chunk.y <= loadedMax.y;
+	};
+
+	std::vector<std::pair<unsigned long long, unsigned int>> cached;
+
+	for (auto& [key, chunk] : chunks)
+	{
+		if (!isLoadedArea(chunk.data.chunk))
+			cached.emplace_back(chunk.lastUsedFrame, key);
+	}
+
+	if (cached.size() <= cacheSize)
+		return;
+
+	// Releasing the chunks that were seen the longest ago
+	std::size_t evictCount{ cached.size() - cacheSize };
+	std::partial_sort(cached.begin(), cached.begin() + evictCount, cached.end());
+
+	for (std::size_t i{ 0 }; i < evictCount; i++)
+	{
+		auto iterator = chunks.find(cached[i].second);
+		releaseChunk(iterator->second);
+		chunks.erase(iterator);
+	}
+}
+
+void TileWorld::uploadChunk(Chunk& chunk)
+{
+	// Leaving out the border, so the chunk is drawn like a tile grid of its own
+	std::vector<int> tileIndices(TILE_WORLD_CHUNK_SIZE * TILE_WORLD_CHUNK_SIZE * layerCount);
+
+	for (unsigned int layer{ 0 }; layer < layerCount; layer++)
+	{
+		for (int y{ 0 }; y < TILE_WORLD_CHUNK_SIZE; y++)
+		{
+			const int* row{ chunk.data.tileIndices.data()
+				+ layer * storedChunkSize * storedChunkSize + (y + 1) * storedChunkSize + 1 };
+
+			std::copy(row, row + TILE_WORLD_CHUNK_SIZE,
+				tileIndices.begin() + (layer * TILE_WORLD_CHUNK_SIZE + y) * TILE_WORLD_CHUNK_SIZE);
+		}
+	}
+
+	glGenVertexArrays(1, &chunk.vao);
+	glGenBuffers(1, &chunk.vbo);
+
+	glBindVertexArray(chunk.vao);
+	glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+
+	glBufferData(GL_ARRAY_BUFFER, sizeof(int) * tileIndices.size(), tileIndices.data(), GL_STATIC_DRAW);
+
+	glVertexAttribIPointer(0, 1, GL_INT, sizeof(int), (void*)0);
+	glEnableVertexAttribArray(0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void TileWorld::releaseChunk(Chunk& chunk)
+{
+	setChunkFixtures(chunk, false);
+
+	if (chunk.vao != 0)
+	{
+		glDeleteVertexArrays(1, &chunk.vao);
+		glDeleteBuffers(1, &chunk.vbo);
+		chunk.vao = 0;
+		chunk.vbo = 0;
+	}
+}
+
+void TileWorld::setChunkFixtures(Chunk& chunk, bool present)
+{
+	if (chunk.hasFixtures == present)
+		return;
+
+	std::shared_ptr<Rigidbody> rigidbody{ collisionRigidbody.lock() };
+
+	if (rigidbody == nullptr || collider == nullptr)
+	{
+		// The fixtures went away with the rigidbody
+		chunk.hasFixtures = false;
+		return;
+	}
+
+	if (present && chunk.data.edges.empty())
+		return;
+
+	std::vector<b2Shape*> shapes;
+	shapes.reserve(chunk.data.edges.size());
+	for (b2EdgeShape& edge : chunk.data.edges)
+	{
+		shapes.push_back(&edge);
+	}
+
+	if (present)
+		rigidbody->replaceColliderShapes(*collider, std::vector<b2Shape*>(), shapes);
+	else
+		rigidbody->replaceColliderShapes(*collider, shapes, std::vector<b2Shape*>());
+
+	chunk.hasFixtures = present;
+}
+
+void TileWorld::updateCollision()
+{
+	if (collider == nullptr)
+		return;
+
+	std::shared_ptr<Rigidbody> rigidbody{ transform->getComponent<Rigidbody>() };
+	int edgeLayer{ collisionLayer.load() };
+
+	bool rigidbodyChanged{ rigidbody != collisionRigidbody.lock() || collider.get() != fixtureCollider };
+
+	for (auto& [key, chunk] : chunks)
+	{
+		if (rigidbodyChanged)
+		{
+			setChunkFixtures(chunk, false);
+		}
+
+		// A new collider can be for a different layer
+		if (chunk.data.edgeLayer != edgeLayer)
+		{
+			setChunkFixtures(chunk, false);
+			generateEdges(chunk.data, edgeLayer);
+		}
+	}
+
+	// The fixtures are added again, as part of the upload budget
+	collisionRigidbody = rigidbody;
+	fixtureCollider = collider.get();
+}
+
+unsigned int TileWorld::getChunkKey(glm::ivec2 chunk) const
+{
+	return chunk.y * chunkCount.x + chunk.x;
+}
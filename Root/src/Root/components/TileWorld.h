@@ -0,0 +1,253 @@
+#pragma once
+
+#include <Root/tilegrids/TileSet.h>
+#include <Root/tilegrids/TileMapFile.h>
+
+#include <Root/components/Component.h>
+#include <Root/Transform.h>
+#include <Root/StringID.h>
+
+#include <glm/glm.hpp>
+
+#include <box2d/b2_edge_shape.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// The width and height in tiles of the chunks that a tile world is streamed in
+#define TILE_WORLD_CHUNK_SIZE 32
+
+class Rigidbody;
+class TileWorldCollider;
+
+/**
+ * A tile grid that is too large to keep in memory, streamed in chunks around the active camera.
+ *
+ * Chunks are read from a memory mapped binary tile map (see TileGrid::convertDataToBinary()),
+ * auto-filled and turned into collision edges on background threads.
+ * Finished chunks are uploaded to the GPU on the main thread, a limited number per frame,
+ * and chunks that go out of view are kept in a cache until it is full, so moving back and forth is free.
+ *
+ * Every chunk is read with a border of neighbouring grid spaces,
+ * so auto-filled tiles and collision edges along chunk borders are the same as in a TileGrid.
+ */
+class TileWorld : public Component
+{
+public:
+
+	~TileWorld();
+
+	/**
+	 * Create a new streamed tile world.
+	 *
+	 * \param transform: the transform to add this tile world to.
+	 * \param texturePath: the path to the texture to use.
+	 * \param pixelPerfect: whether the texture should be pixel perfect.
+	 * \param textureGridSize: the amount of columns, rows in the texture.
+	 * \param dataPath: the path to the tile grid data, in the binary format.
+	 * \param tileSetName: the name of the tile set to use, which must exist before the tile world is created.
+	 * \param tileSize: the size of each tile, default = 1.
+	 * \param loaderThreadCount: the number of background threads that load chunks, default = 2.
+	 */
+	static TileWorld* create(Transform* transform,
+		const std::string& texturePath,
+		bool pixelPerfect,
+		glm::ivec2 textureGridSize,
+		const std::string& dataPath,
+		const std::string& tileSetName,
+		float tileSize = 1.0f,
+		unsigned int loaderThreadCount = 2);
+
+	void update() override;
+
+	void render(float renderDepth) override;
+
+	/**
+	 * Set how many chunks around the view are loaded ahead of time.
+	 *
+	 * \param margin: the number of chunks on each side of the view, default = 1.
+	 */
+	void setLoadMargin(unsigned int margin);
+
+	/**
+	 * Set how many chunks outside of the loaded area are kept, in the order they were last seen.
+	 *
+	 * \param chunkCount: the number of cached chunks, default = 64.
+	 */
+	void setCacheSize(unsigned int chunkCount);
+
+	/**
+	 * Set how many chunks may be uploaded to the GPU in one frame.
+	 *
+	 * \param chunkCount: the number of uploads per frame, default = 4.
+	 */
+	void setUploadBudget(unsigned int chunkCount);
+
+	/**
+	 * Get the grid size.
+	 *
+	 * \returns the grid size (#tiles hor., #tiles vert.).
+	 */
+	glm::ivec2 getGridSize();
+
+	unsigned int getLayerCount();
+
+	/**
+	 * Get the tile at a position in the world, if the chunk it is in is loaded.
+	 *
+	 * \param position: the position in the grid.
+	 * \param layer: the layer to get the tile from.
+	 * \returns the index of the tile in the tile set,
+	 * or -1 if the space is empty, out of bounds or not loaded.
+	 */
+	int getTile(glm::ivec2 position, unsigned int layer);
+
+	/**
+	 * Get whether the chunk holding a position in the grid is loaded and uploaded.
+	 *
+	 * \param position: the position in the grid.
+	 */
+	bool isLoaded(glm::ivec2 position);
+
+private:
+
+	// A chunk as it is made by a loader thread
+	struct ChunkData
+	{
+		glm::ivec2 chunk{ glm::ivec2(0) };
+		// The tile indices of the chunk and a border of one grid space around it, per layer, row by row
+		std::vector<int> tileIndices;
+		// The collision edges of the chunk
+		std::vector<b2EdgeShape> edges;
+		// The layer the edges were made for, or -1 if there are none
+		int edgeLayer{ -1 };
+	};
+
+	struct Chunk
+	{
+		ChunkData data;
+		unsigned int vao{ 0 };
+		unsigned int vbo{ 0 };
+		// Whether the fixtures of the edges were added to the collision rigidbody
+		bool hasFixtures{ false };
+		// The frame the chunk was last inside of the loaded area
+		unsigned long long lastUsedFrame{ 0 };
+	};
+
+	TileWorld(unsigned int texture,
+		glm::ivec2 textureGridSize,
+		std::unique_ptr<TileMapStream> stream,
+		StringID tileSetName,
+		float tileSize,
+		unsigned int loaderThreadCount);
+
+	void loaderThread();
+
+	/**
+	 * Read, auto-fill and make the collision edges of a chunk. Safe to call from any thread.
+	 */
+	void loadChunk(ChunkData& data, int edgeLayer) const;
+
+	/**
+	 * Make the collision edges of a chunk from its tile indices.
+	 */
+	void generateEdges(ChunkData& data, int edgeLayer) const;
+
+	/**
+	 * Find the chunks (inclusive) that the active camera sees.
+	 *
+	 * \returns whether the camera sees any part of the tile world.
+	 */
+	bool getVisibleChunks(glm::ivec2& min, glm::ivec2& max);
+
+	void requestChunks(glm::ivec2 min, glm::ivec2 max);
+
+	void receiveChunks();
+
+	/**
+	 * Upload the received chunks in an area (inclusive) and add their fixtures, within the upload budget.
+	 *
+	 * \returns the number of chunks that were uploaded.
+	 */
+	unsigned int uploadChunks(glm::ivec2 min, glm::ivec2 max);
+
+	void evictChunks();
+
+	void uploadChunk(Chunk& chunk);
+
+	void releaseChunk(Chunk& chunk);
+
+	/**
+	 * Add or remove the fixtures of a chunk on the collision rigidbody.
+	 */
+	void setChunkFixtures(Chunk& chunk, bool present);
+
+	/**
+	 * Bring the collision rigidbody up to date with the tile world collider.
+	 */
+	void updateCollision();
+
+	unsigned int getChunkKey(glm::ivec2 chunk) const;
+
+	float tileSize{ 1.0f };
+
+	StringID tileSetName{ EMPTY_STRING_ID };
+	TileSet* tileSet{ nullptr };
+
+	std::unique_ptr<TileMapStream> stream;
+
+	glm::ivec2 tileGridSize{ glm::ivec2(0) };
+
+	// The number of columns, rows in the texture
+	glm::ivec2 textureGridSize{ glm::ivec2(0) };
+
+	unsigned int layerCount{ 0 };
+
+	unsigned int textureID{ 0 };
+
+	// The number of chunks horizontally, vertically
+	glm::ivec2 chunkCount{ glm::ivec2(0) };
+
+	unsigned int loadMargin{ 1 };
+	unsigned int cacheSize{ 64 };
+	unsigned int uploadBudget{ 4 };
+
+	unsigned long long frame{ 0 };
+
+	// The loaded chunks, by chunk key
+	std::unordered_map<unsigned int, Chunk> chunks;
+
+	// The chunk areas that were last seen and loaded, inclusive
+	glm::ivec2 visibleMin{ glm::ivec2(0) };
+	glm::ivec2 visibleMax{ glm::ivec2(-1) };
+	glm::ivec2 loadedMin{ glm::ivec2(0) };
+	glm::ivec2 loadedMax{ glm::ivec2(-1) };
+
+	// Chunk keys that were requested and have not been received yet
+	std::unordered_set<unsigned int> pendingChunks;
+
+	// Shared with the loader threads
+	std::mutex queueMutex;
+	std::condition_variable queueCondition;
+	std::deque<glm::ivec2> requestQueue;
+	std::vector<ChunkData> finishedChunks;
+	bool stopLoaders{ false };
+	std::vector<std::thread> loaders;
+
+	// The layer that collision edges are made for, or -1 when there is no collider
+	std::atomic<int> collisionLayer{ -1 };
+	std::shared_ptr<TileWorldCollider> collider;
+	// The rigidbody and collider that the fixtures of the chunks were added with
+	std::weak_ptr<Rigidbody> collisionRigidbody;
+	TileWorldCollider* fixtureCollider{ nullptr };
+
+	friend class TileWorldCollider;
+};
@@ -1,89 +1,152 @@
 #include "AnimationHandlerEngine.h"
 
+#include <Root/engine/WorkerPool.h>
+
 namespace AnimationHandlerEngine
 {
     namespace
     {
-        std::vector<TaggedAnimationWeb> animationWebs;
+        // Stored next to each other, so they can all be updated in one loop
+        std::vector<AnimationWebInstance> instances;
+
+        // The index of each instance in instances, so finding one does not search through all of them
+        std::unordered_map<StringID, unsigned int> instanceIndices;
+
+        std::unordered_map<StringID, std::shared_ptr<const AnimationWeb>> definitions;
+
+        bool multithreaded{ false };
+
+        // The number of instances updated by a worker thread at a time
+        const unsigned int instanceBatchSize{ 64 };
+
+        AnimationWebInstance* getInstance(StringID tag)
+        {
+            std::unordered_map<StringID, unsigned int>::iterator iterator{ instanceIndices.find(tag) };
+
+            if (iterator == instanceIndices.end())
+                return nullptr;
 
-        // getAnimator optimisation: 
-        // since many getAnimator calls are likely made contiguously with the same tag,
-        // we store the last result and it's tag, so it can be stored first.
-        std::string lastGetAnimationWebCallTag{};
-        int lastGetAnimationWebCallResultIndex{ -1 }; // -1 signifies not found
+            return &instances[iterator->second];
+        }
 
-        AnimationWeb* getAnimationWeb(const std::string& tag)
+        std::shared_ptr<const AnimationWeb> compileDefinition(AnimationWeb& animationWeb)
         {
-            // Check whether this call was made for the second time with the same tag
-            if (lastGetAnimationWebCallResultIndex != -1
-                && lastGetAnimationWebCallTag == tag)
-                // And return the previous call's result if it was
-                return &animationWebs[lastGetAnimationWebCallResultIndex].animationWeb;
+            animationWeb.compile();
+            return std::make_shared<const AnimationWeb>(std::move(animationWeb));
+        }
 
-            for (int i = 0; i < animationWebs.size(); i++)
+        bool addInstance(const std::shared_ptr<const AnimationWeb>& definition, StringID tag, void* target)
+        {
+            if (instanceIndices.find(tag) != instanceIndices.end())
             {
-                if (animationWebs[i].tag == tag)
-                {
-                    lastGetAnimationWebCallTag = tag;
-                    lastGetAnimationWebCallResultIndex = i;
-                    return &animationWebs[i].animationWeb;
-                }
+                Logger::logWarning("Tried to add an animation web with a tag that is already used. (" + StringInterner::lookup(tag) + ")");
+                return false;
             }
 
-            return nullptr;
+            instances.push_back(AnimationWebInstance{ definition, definition->createState(target), tag });
+            instanceIndices.emplace(tag, static_cast<unsigned int>(instances.size() - 1));
+            return true;
         }
     }
 
-    void addAnimationWeb(AnimationWeb animationWeb, const std::string& tag)
+    void addAnimationWeb(AnimationWeb animationWeb, StringID tag)
     {
-        // Creating a copy of the animation web and putting it into a vector to ensure memory contiguity
-        animationWebs.push_back(TaggedAnimationWeb{ animationWeb, tag });
-
-        // Reset the last get call result index
-        lastGetAnimationWebCallResultIndex = -1;
+        // The web is not shared, so it only gets an instance and no definition
+        addInstance(compileDefinition(animationWeb), tag, nullptr);
     }
 
-    bool removeAnimationWeb(const std::string& tag)
+    void addAnimationWebDefinition(AnimationWeb animationWeb, StringID definitionTag)
     {
-        for (int i = 0; i < animationWebs.size(); i++)
+        if (definitions.find(definitionTag) != definitions.end())
         {
-            if (animationWebs[i].tag == tag)
-            {
-                // Removing the animation web at the index where it is found
-                animationWebs.erase(animationWebs.begin() + i);
+            Logger::logWarning("Tried to add an animation web definition with a tag that is already used. (" + StringInterner::lookup(definitionTag) + ")");
+            return;
+        }
 
-                // Reset the last get call result index,
-                // since the object's index may have changed
-                lastGetAnimationWebCallResultIndex = -1;
+        definitions.emplace(definitionTag, compileDefinition(animationWeb));
+    }
 
-                // Return true indicating an animation was removed
-                return true;
-            }
+    bool removeAnimationWebDefinition(StringID definitionTag)
+    {
+        return definitions.erase(definitionTag) > 0;
+    }
+
+    bool addAnimationWebInstance(StringID definitionTag, StringID instanceTag, void* target)
+    {
+        std::unordered_map<StringID, std::shared_ptr<const AnimationWeb>>::iterator iterator{ definitions.find(definitionTag) };
+
+        if (iterator == definitions.end())
+        {
+            Logger::logError("Tried to create an instance of an animation web definition that doesn't exist. (" + StringInterner::lookup(definitionTag) + ")");
+            return false;
         }
 
+        return addInstance(iterator->second, instanceTag, target);
+    }
+
+    bool removeAnimationWeb(StringID tag)
+    {
+        std::unordered_map<StringID, unsigned int>::iterator iterator{ instanceIndices.find(tag) };
+
         // Return false indicating no animation was removed
-        return false;
+        if (iterator == instanceIndices.end())
+            return false;
+
+        unsigned int index{ iterator->second };
+        instanceIndices.erase(iterator);
+
+        // Moving the last instance into the removed one's place, so no other instances have to move
+        if (index != instances.size() - 1)
+        {
+            instances[index] = std::move(instances.back());
+            instanceIndices[instances[index].tag] = index;
+        }
+        instances.pop_back();
+
+        // Return true indicating an animation was removed
+        return true;
     }
 
-    void setAnimationWebParameter(const std::string& animationWebTag, const std::string& parameterTag, bool value)
+    void setAnimationWebParameter(StringID animationWebTag, StringID parameterTag, bool value)
     {
-        AnimationWeb* animationWeb{ getAnimationWeb(animationWebTag) };
+        AnimationWebInstance* instance{ getInstance(animationWebTag) };
 
-        if (animationWeb == nullptr)
+        if (instance == nullptr)
         {
-            Logger::logError("Tried to access animation web with tag that doesn't exist. (" + animationWebTag + ")");
+            Logger::logError("Tried to access animation web with tag that doesn't exist. (" + StringInterner::lookup(animationWebTag) + ")");
             return;
         }
 
-        animationWeb->setBool(parameterTag, value);
+        instance->definition->setBool(instance->state, parameterTag, value);
+    }
+
+    void setMultithreaded(bool multithreaded)
+    {
+        AnimationHandlerEngine::multithreaded = multithreaded;
     }
 
     void update()
     {
-        for (int i = 0; i < animationWebs.size(); i++)
-        {
-            animationWebs[i].animationWeb.update();
-        }
+        PROFILE_FUNCTION();
+
+        auto job{ [](unsigned int begin, unsigned int end)
+            {
+                for (unsigned int i{ begin }; i < end; i++)
+                {
+                    instances[i].definition->update(instances[i].state);
+                }
+            } };
+
+        unsigned int count{ static_cast<unsigned int>(instances.size()) };
+
+        // Each instance only changes its own state, so they can be updated at the same time
+        if (multithreaded)
+            WorkerPool::parallelFor(count, instanceBatchSize, job);
+        else
+            job(0, count);
+
+        Profiler::setCounter("Animation web instances", count);
+        Profiler::setCounter("Animation web definitions", static_cast<long long>(definitions.size()));
 
         Profiler::addCheckpoint("Animation updates");
     }
@@ -1,23 +1,64 @@
 #pragma once
 
 #include <Root/animation/AnimationWeb.h>
+#include <Root/StringID.h>
 #include <simpleprofiler/Profiler.h>
 
+#include <memory>
 #include <vector>
+#include <unordered_map>
 
 namespace AnimationHandlerEngine
 {
-	struct TaggedAnimationWeb
+	/**
+	 * An object playing an animation web.
+	 */
+	struct AnimationWebInstance
 	{
-		AnimationWeb animationWeb;
-		std::string tag;
+		// The compiled web, which may be shared with other instances
+		std::shared_ptr<const AnimationWeb> definition;
+		AnimationWebState state;
+		StringID tag;
 	};
 
-	void addAnimationWeb(AnimationWeb animationWeb, const std::string& tag);
+	/**
+	 * Add an animation web with a single instance, both identified by the tag.
+	 */
+	void addAnimationWeb(AnimationWeb animationWeb, StringID tag);
+
+	/**
+	 * Add an animation web that instances can be created from.
+	 * The web is compiled, and not copied again for each instance.
+	 */
+	void addAnimationWebDefinition(AnimationWeb animationWeb, StringID definitionTag);
+
+	/**
+	 * Remove an animation web definition.
+	 * Instances that were already created from it keep playing it.
+	 */
+	bool removeAnimationWebDefinition(StringID definitionTag);
+
+	/**
+	 * Create an instance of an animation web definition.
+	 *
+	 * \param target: the object changed by value animations that are not bound to an object themselves.
+	 * \returns whether the instance was created.
+	 */
+	bool addAnimationWebInstance(StringID definitionTag, StringID instanceTag, void* target);
 
-	bool removeAnimationWeb(const std::string& tag);
+	/**
+	 * Remove an animation web instance.
+	 */
+	bool removeAnimationWeb(StringID tag);
+
+	void setAnimationWebParameter(StringID animationWebTag, StringID parameterTag, bool value);
 
-	void setAnimationWebParameter(const std::string& animationWebTag, const std::string& parameterTag, bool value);
+	/**
+	 * Set whether the instances are updated on the worker threads.
+	 * Only safe when the value animations and animation functions of all webs
+	 * only change objects that are not changed by other instances or threads.
+	 */
+	void setMultithreaded(bool multithreaded);
 
 	/**
 	 * Update all active animations webs.
@@ -1,18 +1,242 @@
 #include "AudioEngine.h"
 
 #include <Root/AudioSource.h>
+#include <Root/AudioStream.h>
+#include <Root/SoundBank.h>
+#include <Root/Time.h>
+#include <Root/Transform.h>
+#include <Root/rendering/Camera.h>
+#include <Root/components/AudioEmitter.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
 
 namespace AudioEngine
 {
 	namespace
 	{
-		std::map<std::string, unsigned int> soundBufferIDs;
+		/**
+		 * A sound loaded into a buffer, with the rules for playing it with playSound().
+		 */
+		struct Sound
+		{
+			// 0 while the sound bank of the sound is still uploading
+			unsigned int buffer;
+			// Voices of sounds with a higher priority can take over voices of sounds with a lower one
+			int priority{ 0 };
+			// The number of voices that can play this sound at the same time, 0 for no limit
+			unsigned int maxInstances{ 0 };
+			// The number of seconds after playing this sound before it can be played again
+			float cooldown{ 0.0f };
 
+			// The length in seconds
+			float length{ 0.0f };
+
+			unsigned int activeInstances{ 0 };
+			float lastPlayTime{ -1000000.0f };
+		};
+
+		std::unordered_map<StringID, Sound> sounds;
+
+		/**
+		 * A source that plays sounds started with playSound(), or the sound of an audio emitter.
+		 * The sources are created once, so playing a sound never creates or deletes one.
+		 */
+		struct Voice
+		{
+			ALuint source{ 0 };
+			Sound* sound{ nullptr };
+			int priority{ 0 };
+			// When the voice started playing, to find the oldest voice
+			std::uint64_t startOrder{ 0 };
+			// Changes every time the voice is given to a new sound, so handles to the previous one become invalid
+			std::uint32_t generation{ 0 };
+		};
+
+		const unsigned int voiceCount{ 32 };
+		Voice voices[voiceCount];
+		std::uint64_t nextStartOrder{ 0 };
+
+		// Sounds that were not played because of their rules, or because all voices played more important sounds
+		unsigned int skippedSounds{ 0 };
+		unsigned int stolenVoices{ 0 };
+
+		std::vector<AudioEmitter*> emitters;
+		// Emitters that are audible but have no voice, kept between frames so finding them does not allocate
+		std::vector<AudioEmitter*> emittersWaitingForVoice;
+		float emitterGainThreshold{ 0.01f };
+		float lastEmitterUpdateTime{ 0.0f };
+
+		// Streamed sounds started with playSound(), which need their own source
 		std::forward_list<std::shared_ptr<AudioSource>> activeAudioSources;
 
+		std::unordered_map<StringID, std::string> streamedSoundPaths;
+
+		// Sound banks that are being uploaded on their loader threads, registered when they are done
+		std::vector<std::unique_ptr<SoundBank>> loadingSoundBanks;
+
+		// The streams are refilled on their own thread, so they keep playing when a frame takes long.
+		// OpenAL calls are thread safe, so the streams can use their sources from there.
+		std::thread streamingThread;
+		std::mutex streamsMutex;
+		std::condition_variable streamingCondition;
+		std::vector<AudioStream*> streams;
+		bool stopStreaming{ false };
+
+		void runStreamingThread()
+		{
+			std::unique_lock<std::mutex> lock{ streamsMutex };
+
+			while (!stopStreaming)
+			{
+				for (AudioStream* stream : streams)
+				{
+					stream->update();
+				}
+
+				// Much shorter than the audio in the queued buffers, so they are refilled in time
+				streamingCondition.wait_for(lock, std::chrono::milliseconds{ 10 });
+			}
+		}
+
 		ALCcontext* context{ nullptr };
 		ALCdevice* device{ nullptr };
 
+		void freeVoice(Voice& voice)
+		{
+			if (voice.sound == nullptr)
+				return;
+
+			voice.sound->activeInstances--;
+			voice.sound = nullptr;
+		}
+
+		/**
+		 * Find the voice to play a sound on.
+		 * A free voice if there is one, otherwise the oldest voice playing the least important sound
+		 * that is not more important than the new one.
+		 *
+		 * \param takeEqualPriority: whether voices playing a sound with the same priority can be taken over.
+		 * \returns the voice, or nullptr if every voice plays a more important sound.
+		 */
+		Voice* findVoice(const Sound& sound, bool takeEqualPriority)
+		{
+			Voice* bestVoice{ nullptr };
+
+			for (Voice& voice : voices)
+			{
+				if (voice.source == 0)
+					continue;
+
+				// A sound that reached its instance limit replaces its own oldest instance
+				if (takeEqualPriority && sound.maxInstances > 0 && sound.activeInstances >= sound.maxInstances)
+				{
+					if (voice.sound == &sound && (bestVoice == nullptr || voice.startOrder < bestVoice->startOrder))
+						bestVoice = &voice;
+					continue;
+				}
+
+				if (voice.sound == nullptr)
+					return &voice;
+
+				if (voice.priority > sound.priority || (!takeEqualPriority && voice.priority == sound.priority))
+					continue;
+
+				if (bestVoice == nullptr
+					|| voice.priority < bestVoice->priority
+					|| (voice.priority == bestVoice->priority && voice.startOrder < bestVoice->startOrder))
+					bestVoice = &voice;
+			}
+
+			return bestVoice;
+		}
+
+		/**
+		 * Give a voice to a new sound, taking it over from the sound it played.
+		 */
+		void assignVoice(Voice& voice, Sound& sound)
+		{
+			if (voice.sound != nullptr)
+			{
+				stolenVoices++;
+				alSourceStop(voice.source);
+				freeVoice(voice);
+			}
+
+			voice.sound = &sound;
+			voice.priority = sound.priority;
+			voice.startOrder = nextStartOrder++;
+			voice.generation++;
+			sound.activeInstances++;
+
+			alSourcei(voice.source, AL_BUFFER, sound.buffer);
+		}
+
+		void updateEmitters()
+		{
+			// Audio plays in real time, so the time scale is not used
+			float time{ Time::getTime() };
+			float deltaTime{ time - lastEmitterUpdateTime };
+			lastEmitterUpdateTime = time;
+
+			// The listener follows the active camera
+			Camera* camera{ RootEngine::getActiveCamera() };
+			glm::vec2 listenerPosition{ camera != nullptr ? camera->getTransform()->getPosition() : glm::vec2{ 0.0f } };
+
+			emittersWaitingForVoice.clear();
+			unsigned int realEmitters{ 0 };
+
+			for (AudioEmitter* emitter : emitters)
+			{
+				emitter->internal_updateAudio(listenerPosition, deltaTime, emitterGainThreshold);
+
+				if (emitter->hasVoice())
+					realEmitters++;
+				else if (emitter->internal_wantsVoice(emitterGainThreshold))
+					emittersWaitingForVoice.push_back(emitter);
+			}
+
+			// The loudest emitters get the voices that are left first
+			std::sort(emittersWaitingForVoice.begin(), emittersWaitingForVoice.end(),
+				[](AudioEmitter* a, AudioEmitter* b) { return a->getAudibleGain() > b->getAudibleGain(); });
+
+			for (AudioEmitter* emitter : emittersWaitingForVoice)
+			{
+				if (emitter->internal_acquireVoice(listenerPosition))
+					realEmitters++;
+			}
+
+			Profiler::setCounter("Audio emitters (real)", realEmitters);
+			Profiler::setCounter("Audio emitters (virtual)", emitters.size() - realEmitters);
+		}
+
+		Sound* findSound(StringID name)
+		{
+			auto iterator{ sounds.find(name) };
+
+			if (iterator != sounds.end())
+				return &iterator->second;
+
+			Logger::logError("Sound was not loaded: " + StringInterner::lookup(name));
+			return nullptr;
+		}
+
+		/**
+		 * Make sure the buffer of a sound can be used, waiting for its sound bank if it is still uploading.
+		 *
+		 * \returns whether the sound has a buffer.
+		 */
+		bool waitForBuffer(const Sound& sound)
+		{
+			if (sound.buffer == 0)
+				registerLoadedSoundBanks(true);
+
+			return sound.buffer != 0;
+		}
+
 		ALenum convertFileToOpenALFormat(const AudioFile<float>& audioFile) {
 			int bitDepth = audioFile.getBitDepth();
 			if (bitDepth == 16)
@@ -43,19 +267,61 @@ namespace AudioEngine
 			return;
 		}
 
-		// Creating a listener
+		// Creating a listener.
+		// It stays at the origin: emitters are positioned relative to the active camera instead.
+		// Looking into the screen, so that x is left to right and y is down to up.
 		alListener3f(AL_POSITION, 0, 0, 0);
 		alListener3f(AL_VELOCITY, 0, 0, 0);
 		ALfloat forwardAndUpVectors[] = {
-			1.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, -1.0f,
 			0.0f, 1.0f, 0.0f
 		};
 		alListenerfv(AL_ORIENTATION, forwardAndUpVectors);
+
+		// Clearing earlier errors, to find out when no more sources can be created
+		alGetError();
+		for (Voice& voice : voices)
+		{
+			alGenSources(1, &voice.source);
+			if (alGetError() != AL_NO_ERROR)
+			{
+				Logger::logWarning("OpenAL: Could only create " + std::to_string(&voice - voices) + " voices.");
+				voice.source = 0;
+				break;
+			}
+		}
+
+		streamingThread = std::thread{ runStreamingThread };
 	}
 
 	void update()
 	{
-		// Deleting all audio sources that are done
+		PROFILE_FUNCTION();
+
+		// Making the voices that finished playing available again
+		unsigned int activeVoices{ 0 };
+		for (Voice& voice : voices)
+		{
+			if (voice.sound == nullptr)
+				continue;
+
+			ALint state;
+			alGetSourcei(voice.source, AL_SOURCE_STATE, &state);
+
+			if (state == AL_STOPPED)
+				freeVoice(voice);
+			else
+				activeVoices++;
+		}
+
+		updateEmitters();
+		registerLoadedSoundBanks(false);
+
+		Profiler::setCounter("Audio voices active", activeVoices);
+		Profiler::setCounter("Audio voices stolen", stolenVoices);
+		Profiler::setCounter("Sounds skipped", skippedSounds);
+
+		// Deleting all streamed audio sources that are done
 		std::forward_list<std::shared_ptr<AudioSource>>::iterator before = activeAudioSources.before_begin();
 
 		for (std::forward_list<std::shared_ptr<AudioSource>>::iterator 
@@ -65,7 +331,6 @@ namespace AudioEngine
 			// If the audio source we are checking is done, delete it
 			if (it->get()->isDone())
 			{
-				Logger::log("Deleting audio source");
 				it = activeAudioSources.erase_after(before);
 			}
 			else
@@ -80,23 +345,84 @@ namespace AudioEngine
 
 	void terminate()
 	{
+		if (streamingThread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock{ streamsMutex };
+				stopStreaming = true;
+			}
+			streamingCondition.notify_one();
+			streamingThread.join();
+		}
+
+		// Deleting the sources while the context still exists
+		activeAudioSources.clear();
+
+		// Waiting for the loaders, so their buffers can be deleted below
+		registerLoadedSoundBanks(true);
+
+		// Deleting the voices first, since buffers cannot be deleted while a source uses them
+		for (Voice& voice : voices)
+		{
+			if (voice.source == 0)
+				continue;
+
+			alSourceStop(voice.source);
+			alDeleteSources(1, &voice.source);
+			voice.source = 0;
+			voice.sound = nullptr;
+			// Emitters that are destroyed later must not use the deleted source
+			voice.generation++;
+		}
+
 		// Deleting all buffers
-		for (std::pair<std::string, unsigned int> buffer : soundBufferIDs)
+		for (std::pair<const StringID, Sound>& sound : sounds)
 		{
-			alDeleteBuffers(1, &buffer.second);
+			alDeleteBuffers(1, &sound.second.buffer);
 		}
 		alcMakeContextCurrent(nullptr);
 		alcDestroyContext(context);
 		alcCloseDevice(device);
 	}
 
-	void playSound(const std::string& name)
+	void playSound(StringID name)
 	{
-		unsigned int buffer{ findBufferByName(name) };
-		if (buffer == 0)
+		auto iterator{ sounds.find(name) };
+		if (iterator != sounds.end() && waitForBuffer(iterator->second))
+		{
+			Sound& sound{ iterator->second };
+
+			float time{ Time::getTime() };
+			if (time - sound.lastPlayTime < sound.cooldown)
+			{
+				skippedSounds++;
+				return;
+			}
+
+			Voice* voice{ findVoice(sound, true) };
+			if (voice == nullptr)
+			{
+				skippedSounds++;
+				return;
+			}
+
+			assignVoice(*voice, sound);
+			sound.lastPlayTime = time;
+
+			// The voice may have played an emitter before, so resetting everything the emitter changes
+			alSourcei(voice->source, AL_SOURCE_RELATIVE, AL_TRUE);
+			alSource3f(voice->source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+			alSourcef(voice->source, AL_GAIN, 1.0f);
+			alSourcef(voice->source, AL_PITCH, 1.0f);
+			alSourcei(voice->source, AL_LOOPING, AL_FALSE);
+			alSourcePlay(voice->source);
+			return;
+		}
+
+		if (findStreamedSoundPath(name) == nullptr)
 		{
 			// No audio clip was found with the given name
-			Logger::logError("Tried to play sound with name that was not loaded: " + name);
+			Logger::logError("Tried to play sound with name that was not loaded: " + StringInterner::lookup(name));
 			return;
 		}
 
@@ -110,11 +436,28 @@ namespace AudioEngine
 
 	void loadSound(const std::string& path, const std::string& name)
 	{
+		StringID id{ StringInterner::intern(name) };
+
+		// Sounds in a sound bank do not have to be decoded, they only have to wait for the bank
+		for (std::unique_ptr<SoundBank>& bank : loadingSoundBanks)
+		{
+			if (bank->contains(id))
+			{
+				registerLoadedSoundBanks(true);
+				return;
+			}
+		}
+		if (sounds.find(id) != sounds.end())
+			return;
+
+		std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+
 		AudioFile<float> soundFile;
 
 		if (!soundFile.load(path))
 		{
 			Logger::logError("AudioFile: Failed to load sound at " + path);
+			return;
 		}
 
 		std::vector<uint8_t> PCMDataBytes;
@@ -130,16 +473,218 @@ namespace AudioEngine
 			soundFile.getSampleRate());
 
 		// Saving the buffer ID
-		soundBufferIDs.emplace(name, bufferID);
+		Sound sound{ bufferID };
+		sound.length = static_cast<float>(soundFile.getLengthInSeconds());
+		sounds.emplace(id, sound);
+
+		float milliseconds{ std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() };
+		ROOT_LOG("Decoded sound " + name + " in " + std::to_string(milliseconds) + " ms, consider putting it in a sound bank");
 	}
 
-	unsigned int findBufferByName(const std::string& name)
+	void loadSoundBank(const std::string& path)
 	{
-		std::map<std::string, unsigned int>::iterator iterator = soundBufferIDs.find(name);
+		std::unique_ptr<SoundBank> bank{ SoundBank::open(path) };
+		if (!bank)
+			return;
+
+		ROOT_LOG("Opened sound bank " + path + " with " + std::to_string(bank->getClips().size())
+			+ " sounds in " + std::to_string(bank->getOpenMilliseconds()) + " ms");
+
+		// The lengths are known from the table already, so emitters and the rules for the sounds
+		// can be set up before the buffers are uploaded
+		for (const SoundBank::Clip& clip : bank->getClips())
+		{
+			if (sounds.find(clip.name) != sounds.end())
+				continue;
 
-		if (iterator != soundBufferIDs.end())
-			return iterator->second;
+			Sound sound{ 0 };
+			sound.length = clip.length;
+			sounds.emplace(clip.name, sound);
+		}
+
+		bank->startLoading();
+		loadingSoundBanks.push_back(std::move(bank));
+	}
+
+	bool cookSoundBank(const std::vector<SoundBankClip>& clips, const std::string& bankPath)
+	{
+		return SoundBank::cook(clips, bankPath);
+	}
+
+	void registerLoadedSoundBanks(bool wait)
+	{
+		for (std::size_t i{ 0 }; i < loadingSoundBanks.size(); )
+		{
+			SoundBank& bank{ *loadingSoundBanks[i] };
+			if (!wait && !bank.isLoaded())
+			{
+				i++;
+				continue;
+			}
+
+			bank.finishLoading();
+
+			for (const SoundBank::Clip& clip : bank.getClips())
+			{
+				// The sound was registered when the bank was opened, but a sound that was loaded before keeps its buffer
+				auto iterator{ sounds.find(clip.name) };
+				if (iterator != sounds.end() && iterator->second.buffer == 0)
+				{
+					iterator->second.buffer = clip.buffer;
+					continue;
+				}
+
+				alDeleteBuffers(1, &clip.buffer);
+			}
+
+			ROOT_LOG("Loaded sound bank " + bank.getPath() + ": " + std::to_string(bank.getClips().size()) + " sounds, "
+				+ std::to_string(static_cast<float>(bank.getDataSize()) / (1024.0f * 1024.0f)) + " MB uploaded in "
+				+ std::to_string(bank.getUploadMilliseconds()) + " ms on the loader thread");
+
+			loadingSoundBanks.erase(loadingSoundBanks.begin() + i);
+		}
+	}
+
+	unsigned int findBufferByName(StringID name)
+	{
+		std::unordered_map<StringID, Sound>::iterator iterator = sounds.find(name);
+
+		if (iterator != sounds.end() && waitForBuffer(iterator->second))
+			return iterator->second.buffer;
 
 		return 0;
 	}
-}; 
\ No newline at end of file
+
+	void setSoundPriority(StringID name, int priority)
+	{
+		Sound* sound{ findSound(name) };
+		if (sound != nullptr)
+			sound->priority = priority;
+	}
+
+	void setSoundInstanceLimit(StringID name, unsigned int maxInstances)
+	{
+		Sound* sound{ findSound(name) };
+		if (sound != nullptr)
+			sound->maxInstances = maxInstances;
+	}
+
+	void setSoundCooldown(StringID name, float cooldown)
+	{
+		Sound* sound{ findSound(name) };
+		if (sound != nullptr)
+			sound->cooldown = cooldown;
+	}
+
+	void loadStreamedSound(const std::string& path, const std::string& name)
+	{
+		if (!AudioStream::canStream(path))
+			return;
+
+		streamedSoundPaths[StringInterner::intern(name)] = path;
+	}
+
+	const std::string* findStreamedSoundPath(StringID name)
+	{
+		auto iterator{ streamedSoundPaths.find(name) };
+
+		if (iterator != streamedSoundPaths.end())
+			return &iterator->second;
+
+		return nullptr;
+	}
+
+	void registerStream(AudioStream* stream)
+	{
+		std::lock_guard<std::mutex> lock{ streamsMutex };
+		streams.push_back(stream);
+	}
+
+	void unregisterStream(AudioStream* stream)
+	{
+		std::lock_guard<std::mutex> lock{ streamsMutex };
+		streams.erase(std::remove(streams.begin(), streams.end(), stream), streams.end());
+	}
+
+	void wakeStreamingThread()
+	{
+		streamingCondition.notify_one();
+	}
+
+	float getSoundLength(StringID name)
+	{
+		auto iterator{ sounds.find(name) };
+		return iterator != sounds.end() ? iterator->second.length : 0.0f;
+	}
+
+	bool acquireVoice(StringID name, VoiceHandle& handle)
+	{
+		auto iterator{ sounds.find(name) };
+		if (iterator == sounds.end())
+			return false;
+
+		Sound& sound{ iterator->second };
+
+		// The emitter stays virtual until the sound bank of the sound is uploaded
+		if (sound.buffer == 0)
+			return false;
+
+		// Emitters do not restart instances of the sound, they stay virtual until an instance stops
+		if (sound.maxInstances > 0 && sound.activeInstances >= sound.maxInstances)
+			return false;
+
+		// Only taking voices of less important sounds, so that emitters do not keep taking voices from each other
+		Voice* voice{ findVoice(sound, false) };
+		if (voice == nullptr)
+			return false;
+
+		assignVoice(*voice, sound);
+
+		handle.index = static_cast<unsigned int>(voice - voices);
+		handle.generation = voice->generation;
+		return true;
+	}
+
+	VoiceState getVoiceState(VoiceHandle handle)
+	{
+		const Voice& voice{ voices[handle.index] };
+
+		if (voice.generation != handle.generation)
+			return VoiceState::LOST;
+		if (voice.sound == nullptr)
+			return VoiceState::FINISHED;
+		return VoiceState::PLAYING;
+	}
+
+	unsigned int getVoiceSource(VoiceHandle handle)
+	{
+		return voices[handle.index].source;
+	}
+
+	void releaseVoice(VoiceHandle handle)
+	{
+		Voice& voice{ voices[handle.index] };
+		if (voice.generation != handle.generation)
+			return;
+
+		alSourceStop(voice.source);
+		freeVoice(voice);
+		// Making the handle invalid
+		voice.generation++;
+	}
+
+	void registerEmitter(AudioEmitter* emitter)
+	{
+		emitters.push_back(emitter);
+	}
+
+	void unregisterEmitter(AudioEmitter* emitter)
+	{
+		emitters.erase(std::remove(emitters.begin(), emitters.end(), emitter), emitters.end());
+	}
+
+	void setEmitterGainThreshold(float threshold)
+	{
+		emitterGainThreshold = threshold;
+	}
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Root/Logger.h>
+#include <Root/StringID.h>
+#include <Root/SoundBank.h>
 #include <simpleprofiler/Profiler.h>
 
 #include <AL/al.h>
@@ -10,21 +12,162 @@
 
 #include <iostream>
 
-#include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <forward_list>
+#include <cstdint>
+
+class AudioStream;
+class AudioEmitter;
 
 namespace AudioEngine
 {
+	/**
+	 * Refers to a voice given to an audio emitter.
+	 * Stops referring to it when the voice is given to another sound.
+	 */
+	struct VoiceHandle
+	{
+		unsigned int index{ 0 };
+		std::uint32_t generation{ 0 };
+	};
+
+	enum class VoiceState
+	{
+		PLAYING,
+		// The sound ended, and the voice was made available again
+		FINISHED,
+		// The voice was given to another sound
+		LOST
+	};
+
 	void initialise();
 
 	void update();
 
 	void terminate();
 
+	/**
+	 * Load a sound by decoding its file, or from a sound bank that contains a sound with the same name.
+	 */
 	void loadSound(const std::string& path, const std::string& name);
 
-	void playSound(const std::string& name);
+	/**
+	 * Open a sound bank and start uploading its sounds on a background thread.
+	 * The sounds can be played once update() has registered them, or right away after loadSound() is called for them.
+	 * Their lengths and rules can be used right away, and emitters playing them stay virtual until they are uploaded.
+	 */
+	void loadSoundBank(const std::string& path);
+
+	/**
+	 * Decode sounds and write them to a sound bank file.
+	 *
+	 * \returns whether the bank was written.
+	 */
+	bool cookSoundBank(const std::vector<SoundBankClip>& clips, const std::string& bankPath);
+
+	/**
+	 * Register the sounds of the sound banks that finished uploading.
+	 *
+	 * \param wait: whether to wait for the banks that are still uploading.
+	 */
+	void registerLoadedSoundBanks(bool wait);
+
+	void playSound(StringID name);
+
+	unsigned int findBufferByName(StringID name);
+
+	/**
+	 * Set how important a sound is.
+	 * When all voices are playing, playSound() takes over the oldest voice playing the least important sound,
+	 * as long as that sound is not more important than the new one.
+	 *
+	 * \param priority: the priority, 0 by default.
+	 */
+	void setSoundPriority(StringID name, int priority);
+
+	/**
+	 * Set how many voices can play a sound at the same time.
+	 * When the limit is reached, playSound() restarts the oldest instance of the sound.
+	 *
+	 * \param maxInstances: the maximum number of instances, 0 for no limit.
+	 */
+	void setSoundInstanceLimit(StringID name, unsigned int maxInstances);
+
+	/**
+	 * Set how long after playing a sound playSound() ignores it.
+	 *
+	 * \param cooldown: the number of seconds, 0 by default.
+	 */
+	void setSoundCooldown(StringID name, float cooldown);
+
+	/**
+	 * Register a sound that is streamed from its file while it plays, instead of being loaded at once.
+	 * Only checks the file, so this is fast and uses no memory for the samples.
+	 */
+	void loadStreamedSound(const std::string& path, const std::string& name);
+
+	/**
+	 * Find the file of a streamed sound.
+	 *
+	 * \returns the path of the file, or nullptr if no streamed sound has the given name.
+	 */
+	const std::string* findStreamedSoundPath(StringID name);
+
+	/**
+	 * Start refilling the buffers of the stream on the streaming thread.
+	 */
+	void registerStream(AudioStream* stream);
+
+	/**
+	 * Stop refilling the buffers of the stream.
+	 * Waits until the streaming thread is not using the stream.
+	 */
+	void unregisterStream(AudioStream* stream);
+
+	/**
+	 * Make the streaming thread refill buffers now instead of on its next update.
+	 */
+	void wakeStreamingThread();
+
+	/**
+	 * Get the length of a loaded sound.
+	 *
+	 * \returns the length in seconds, or 0 if no sound was loaded with the given name.
+	 */
+	float getSoundLength(StringID name);
+
+	/**
+	 * Get a voice to play a sound on, with the sound's buffer already set.
+	 * Only takes a free voice or a voice playing a less important sound,
+	 * and no voice if the sound reached its instance limit.
+	 *
+	 * \param handle: set to the voice that was found.
+	 * \returns whether a voice was found.
+	 */
+	bool acquireVoice(StringID name, VoiceHandle& handle);
+
+	VoiceState getVoiceState(VoiceHandle handle);
+
+	unsigned int getVoiceSource(VoiceHandle handle);
+
+	/**
+	 * Stop the voice and make it available again, if it was not given to another sound.
+	 */
+	void releaseVoice(VoiceHandle handle);
+
+	/**
+	 * Start updating the audio emitter every frame.
+	 */
+	void registerEmitter(AudioEmitter* emitter);
+
+	void unregisterEmitter(AudioEmitter* emitter);
 
-	unsigned int findBufferByName(const std::string& name);
+	/**
+	 * Set the gain below which audio emitters have no voice.
+	 *
+	 * \param threshold: the gain, 0.01 by default.
+	 */
+	void setEmitterGainThreshold(float threshold);
 };
@@ -40,6 +40,8 @@ namespace ComponentEngine
 
     void updateScripts()
     {
+        PROFILE_FUNCTION();
+
         startScripts();
 
         // Calling all script update() functions
@@ -71,20 +73,18 @@ namespace ComponentEngine
 
     void updateRigidbodiesTransforms()
     {
-        // Calling all components' update() functions
-        for (std::shared_ptr<Transform>& transform : RootEngine::getTransforms())
-        {
-            RigidbodyPointer rigidbody{ transform->getAttachedRigidbody() };
+        PROFILE_FUNCTION();
 
-            if (rigidbody != nullptr)
-                rigidbody->updateTransform();
-        }
+        // Only bodies that moved are synchronised, straight from the physics world
+        PhysicsEngine::syncRigidbodyTransforms();
 
         Profiler::addCheckpoint("Rigidbody updates");
     }
 
     void renderComponents()
     {
+        PROFILE_FUNCTION();
+
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
@@ -1,228 +1,396 @@
 #include "InputEngine.h"
 
 #include <Root/Input.h>
+#include <Root/Logger.h>
+
+#include <bitset>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
 
 namespace InputEngine
 {
 	namespace
 	{
-		std::vector<int> keysDownThisFrame;
-		std::vector<int> keysDownLastFrame;
-		glm::vec2 mousePosition;
-		glm::vec2 deltaMousePosition;
-
-		const int ALL_KEYS[] {
-			KEY_SPACE,
-			KEY_APOSTROPHE,
-			KEY_COMMA,
-			KEY_MINUS,
-			KEY_PERIOD,
-			KEY_SLASH,
-			KEY_0,
-			KEY_1,
-			KEY_2,
-			KEY_3,
-			KEY_4,
-			KEY_5,
-			KEY_6,
-			KEY_7,
-			KEY_8,
-			KEY_9,
-			KEY_SEMICOLON,
-			KEY_EQUAL,
-			KEY_A,
-			KEY_B,
-			KEY_C,
-			KEY_D,
-			KEY_E,
-			KEY_F,
-			KEY_G,
-			KEY_H,
-			KEY_I,
-			KEY_J,
-			KEY_K,
-			KEY_L,
-			KEY_M,
-			KEY_N,
-			KEY_O,
-			KEY_P,
-			KEY_Q,
-			KEY_R,
-			KEY_S,
-			KEY_T,
-			KEY_U,
-			KEY_V,
-			KEY_W,
-			KEY_X,
-			KEY_Y,
-			KEY_Z,
-			KEY_LEFT_BRACKET,
-			KEY_BACKSLASH,
-			KEY_RIGHT_BRACKET,
-			KEY_GRAVE_ACCENT,
-			KEY_WORLD_1,
-			KEY_WORLD_2,
-
-
-			KEY_ESCAPE,
-			KEY_ENTER,
-			KEY_TAB,
-			KEY_BACKSPACE,
-			KEY_INSERT,
-			KEY_DELETE,
-			KEY_RIGHT,
-			KEY_LEFT,
-			KEY_DOWN,
-			KEY_UP,
-			KEY_PAGE_UP,
-			KEY_PAGE_DOWN,
-			KEY_HOME,
-			KEY_END,
-			KEY_CAPS_LOCK,
-			KEY_SCROLL_LOCK,
-			KEY_NUM_LOCK,
-			KEY_PRINT_SCREEN,
-			KEY_PAUSE,
-			KEY_F1,
-			KEY_F2,
-			KEY_F3,
-			KEY_F4,
-			KEY_F5,
-			KEY_F6,
-			KEY_F7,
-			KEY_F8,
-			KEY_F9,
-			KEY_F10,
-			KEY_F11,
-			KEY_F12,
-			KEY_F13,
-			KEY_F14,
-			KEY_F15,
-			KEY_F16,
-			KEY_F17,
-			KEY_F18,
-			KEY_F19,
-			KEY_F20,
-			KEY_F21,
-			KEY_F22,
-			KEY_F23,
-			KEY_F24,
-			KEY_F25,
-
-
-			KEY_KP_0,
-			KEY_KP_1,
-			KEY_KP_2,
-			KEY_KP_3,
-			KEY_KP_4,
-			KEY_KP_5,
-			KEY_KP_6,
-			KEY_KP_7,
-			KEY_KP_8,
-			KEY_KP_9,
-			KEY_KP_DECIMAL,
-			KEY_KP_DIVIDE,
-			KEY_KP_MULTIPLY,
-			KEY_KP_SUBTRACT,
-			KEY_KP_ADD,
-			KEY_KP_ENTER,
-			KEY_KP_EQUAL,
-			KEY_LEFT_SHIFT,
-			KEY_LEFT_CONTROL,
-			KEY_LEFT_ALT,
-			KEY_LEFT_SUPER,
-			KEY_RIGHT_SHIFT,
-			KEY_RIGHT_CONTROL,
-			KEY_RIGHT_ALT,
-			KEY_RIGHT_SUPER,
-			KEY_MENU
-		};
-
-
-		const int ALL_MOUSE_BUTTONS[]{
-			MOUSE_LEFT,
-			MOUSE_RIGHT,
-			MOUSE_MIDDLE,
-			MOUSE_BUTTON_1,
-			MOUSE_BUTTON_2,
-			MOUSE_BUTTON_3,
-			MOUSE_BUTTON_4,
-			MOUSE_BUTTON_5,
-			MOUSE_BUTTON_6,
-			MOUSE_BUTTON_7,
-			MOUSE_BUTTON_8
-		};
-
-		bool find(std::vector<int>& v, int s)
-		{
-			for (int i : v)
+		// Every GLFW key and mouse button is a single bit
+		typedef std::bitset<GLFW_KEY_LAST + 1> KeySet;
+		typedef std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> MouseButtonSet;
+
+		// Changed by the GLFW callbacks while events are polled
+		KeySet keysDown;
+		MouseButtonSet mouseButtonsDown;
+		glm::vec2 cursorPosition{ 0.0f };
+		// Remembers presses since the last frame, so that a key pressed and released between two frames is still seen
+		KeySet keysPressedSinceLastFrame;
+		MouseButtonSet mouseButtonsPressedSinceLastFrame;
+
+		KeySet keysDownThisFrame;
+		KeySet keysDownLastFrame;
+		MouseButtonSet mouseButtonsDownThisFrame;
+		MouseButtonSet mouseButtonsDownLastFrame;
+		// What changed since the last frame, found by XOR of this frame and the last one
+		KeySet keysPressedThisFrame;
+		KeySet keysReleasedThisFrame;
+		MouseButtonSet mouseButtonsPressedThisFrame;
+		MouseButtonSet mouseButtonsReleasedThisFrame;
+		glm::vec2 mousePosition{ 0.0f };
+		glm::vec2 mousePositionLastFrame{ 0.0f };
+		glm::vec2 deltaMousePosition{ 0.0f };
+		double frameTime{ 0.0 };
+		// The time given to the last update(), and what to add to it so that time does not jump back after a replay
+		double lastUpdateTime{ 0.0 };
+		double frameTimeOffset{ 0.0 };
+
+		GLFWkeyfun previousKeyCallback{ nullptr };
+		GLFWmousebuttonfun previousMouseButtonCallback{ nullptr };
+		GLFWcursorposfun previousCursorPositionCallback{ nullptr };
+		GLFWwindowfocusfun previousWindowFocusCallback{ nullptr };
+
+		/*
+		 * A recording is a header followed by one entry per frame:
+		 * the frame time since the start of the recording (double), the mouse position (2 floats),
+		 * the mouse buttons that are down (one bit each, uint8), the number of keys that changed since the previous frame (uint16)
+		 * and the codes of those keys (uint16 each).
+		 * Most frames change no keys, so they take 19 bytes.
+		 */
+		const char recordingMagic[4]{ 'R', 'I', 'N', 'P' };
+		const std::uint32_t recordingVersion{ 1 };
+
+		std::ofstream recordingFile;
+		double recordingStartTime{ 0.0 };
+		// The keys that were down in the last recorded frame
+		KeySet recordedKeys;
+
+		bool replaying{ false };
+		std::vector<char> replayData;
+		std::size_t replayOffset{ 0 };
+		double replayStartTime{ 0.0 };
+		KeySet replayedKeys;
+
+		bool isKey(int key)
+		{
+			return key >= 0 && key <= GLFW_KEY_LAST;
+		}
+
+		bool isMouseButton(int mouseButton)
+		{
+			return mouseButton >= 0 && mouseButton <= GLFW_MOUSE_BUTTON_LAST;
+		}
+
+		void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+		{
+			if (previousKeyCallback != nullptr)
+				previousKeyCallback(window, key, scancode, action, mods);
+
+			if (!isKey(key))
+				return;
+
+			if (action == GLFW_PRESS)
 			{
-				if (i == s)
-					return true;
+				keysDown.set(key);
+				keysPressedSinceLastFrame.set(key);
 			}
-			return false;
+			else if (action == GLFW_RELEASE)
+			{
+				keysDown.reset(key);
+			}
+		}
+
+		void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+		{
+			if (previousMouseButtonCallback != nullptr)
+				previousMouseButtonCallback(window, button, action, mods);
+
+			if (!isMouseButton(button))
+				return;
+
+			if (action == GLFW_PRESS)
+			{
+				mouseButtonsDown.set(button);
+				mouseButtonsPressedSinceLastFrame.set(button);
+			}
+			else if (action == GLFW_RELEASE)
+			{
+				mouseButtonsDown.reset(button);
+			}
+		}
+
+		void cursorPositionCallback(GLFWwindow* window, double x, double y)
+		{
+			if (previousCursorPositionCallback != nullptr)
+				previousCursorPositionCallback(window, x, y);
+
+			cursorPosition = glm::vec2(x, y);
+		}
+
+		void windowFocusCallback(GLFWwindow* window, int focused)
+		{
+			if (previousWindowFocusCallback != nullptr)
+				previousWindowFocusCallback(window, focused);
+
+			// Releases are not sent to unfocused windows, so keys would otherwise stay down
+			if (focused == GLFW_FALSE)
+			{
+				keysDown.reset();
+				mouseButtonsDown.reset();
+			}
+		}
+
+		template<typename T>
+		void writeValue(std::ofstream& file, const T& value)
+		{
+			file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		bool readReplayValue(T& value)
+		{
+			if (replayOffset + sizeof(T) > replayData.size())
+				return false;
+
+			std::memcpy(&value, replayData.data() + replayOffset, sizeof(T));
+			replayOffset += sizeof(T);
+			return true;
+		}
+
+		void writeRecordingFrame()
+		{
+			writeValue(recordingFile, frameTime - recordingStartTime);
+			writeValue(recordingFile, mousePosition.x);
+			writeValue(recordingFile, mousePosition.y);
+			writeValue(recordingFile, static_cast<std::uint8_t>(mouseButtonsDownThisFrame.to_ulong()));
+
+			KeySet changedKeys{ keysDownThisFrame ^ recordedKeys };
+			writeValue(recordingFile, static_cast<std::uint16_t>(changedKeys.count()));
+
+			if (changedKeys.any())
+			{
+				for (std::uint16_t key{ 0 }; key <= GLFW_KEY_LAST; key++)
+				{
+					if (changedKeys.test(key))
+						writeValue(recordingFile, key);
+				}
+			}
+
+			recordedKeys = keysDownThisFrame;
+		}
+
+		/**
+		 * Read the input of the next frame of the recording being replayed.
+		 *
+		 * \returns false if the recording ended.
+		 */
+		bool readReplayFrame()
+		{
+			double time;
+			glm::vec2 position;
+			std::uint8_t mouseButtons;
+			std::uint16_t changedKeyCount;
+
+			if (!readReplayValue(time) || !readReplayValue(position.x) || !readReplayValue(position.y)
+				|| !readReplayValue(mouseButtons) || !readReplayValue(changedKeyCount))
+				return false;
+
+			for (std::uint16_t i{ 0 }; i < changedKeyCount; i++)
+			{
+				std::uint16_t key;
+				if (!readReplayValue(key) || !isKey(key))
+					return false;
+
+				replayedKeys.flip(key);
+			}
+
+			frameTime = replayStartTime + time;
+			mousePosition = position;
+			mouseButtonsDownThisFrame = MouseButtonSet{ mouseButtons };
+			keysDownThisFrame = replayedKeys;
+
+			return true;
 		}
 	}
 
 	void initialise()
 	{
+		GLFWwindow* window{ RootEngine::getActiveWindow() };
+
+		previousKeyCallback = glfwSetKeyCallback(window, keyCallback);
+		previousMouseButtonCallback = glfwSetMouseButtonCallback(window, mouseButtonCallback);
+		previousCursorPositionCallback = glfwSetCursorPosCallback(window, cursorPositionCallback);
+		previousWindowFocusCallback = glfwSetWindowFocusCallback(window, windowFocusCallback);
+
+		double mouseX, mouseY;
+		glfwGetCursorPos(window, &mouseX, &mouseY);
+		cursorPosition = glm::vec2(mouseX, mouseY);
+		mousePosition = cursorPosition;
+		mousePositionLastFrame = cursorPosition;
 	}
 
-	void update()
+	void update(double time)
 	{
-		for (int key : ALL_KEYS)
+		if (replaying && !readReplayFrame())
 		{
-			if (glfwGetKey(RootEngine::getActiveWindow(), key) == GLFW_PRESS)
-				keysDownThisFrame.push_back(key);
+			Logger::log("Finished replaying input recording.");
+			stopReplay();
 		}
-		for (int button : ALL_MOUSE_BUTTONS)
+
+		if (!replaying)
 		{
-			if (glfwGetMouseButton(RootEngine::getActiveWindow(), button) == GLFW_PRESS)
-				keysDownThisFrame.push_back(button);
+			keysDownThisFrame = keysDown | keysPressedSinceLastFrame;
+			mouseButtonsDownThisFrame = mouseButtonsDown | mouseButtonsPressedSinceLastFrame;
+
+			mousePosition = cursorPosition;
+			frameTime = time + frameTimeOffset;
 		}
-		double mouseX, mouseY;
-		glfwGetCursorPos(RootEngine::getActiveWindow(), &mouseX, &mouseY);
-		mousePosition = glm::vec2(mouseX, mouseY);
+
+		lastUpdateTime = time;
+
+		// Also while replaying, so that presses during the replay are not seen when it ends
+		keysPressedSinceLastFrame.reset();
+		mouseButtonsPressedSinceLastFrame.reset();
+
+		KeySet changedKeys{ keysDownThisFrame ^ keysDownLastFrame };
+		keysPressedThisFrame = changedKeys & keysDownThisFrame;
+		keysReleasedThisFrame = changedKeys & keysDownLastFrame;
+
+		MouseButtonSet changedMouseButtons{ mouseButtonsDownThisFrame ^ mouseButtonsDownLastFrame };
+		mouseButtonsPressedThisFrame = changedMouseButtons & mouseButtonsDownThisFrame;
+		mouseButtonsReleasedThisFrame = changedMouseButtons & mouseButtonsDownLastFrame;
+
+		deltaMousePosition = mousePosition - mousePositionLastFrame;
+
+		if (recordingFile.is_open())
+			writeRecordingFrame();
 	}
 
 	void newFrame()
 	{
 		keysDownLastFrame = keysDownThisFrame;
-		keysDownThisFrame.clear();
+		mouseButtonsDownLastFrame = mouseButtonsDownThisFrame;
+		mousePositionLastFrame = mousePosition;
+	}
+
+	double getFrameTime()
+	{
+		return frameTime;
+	}
+
+	bool startRecording(const std::string& path)
+	{
+		stopRecording();
+
+		recordingFile.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!recordingFile.is_open())
+		{
+			Logger::logError("Could not open file " + path + " to record input to.");
+			return false;
+		}
+
+		recordingFile.write(recordingMagic, sizeof(recordingMagic));
+		writeValue(recordingFile, recordingVersion);
+
+		recordingStartTime = frameTime;
+		recordedKeys.reset();
+
+		return true;
+	}
+
+	void stopRecording()
+	{
+		if (recordingFile.is_open())
+			recordingFile.close();
+	}
+
+	bool startReplay(const std::string& path)
+	{
+		stopReplay();
+
+		std::ifstream file{ path, std::ios::in | std::ios::binary | std::ios::ate };
+		if (!file.is_open())
+		{
+			Logger::logError("Could not open input recording " + path + ".");
+			return false;
+		}
+
+		std::streamsize size{ file.tellg() };
+		file.seekg(0, std::ios::beg);
+
+		replayData.resize(static_cast<std::size_t>(size));
+		if (!file.read(replayData.data(), size))
+		{
+			Logger::logError("Could not read input recording " + path + ".");
+			replayData.clear();
+			return false;
+		}
+
+		replayOffset = 0;
+
+		char magic[sizeof(recordingMagic)];
+		std::uint32_t version;
+		if (!readReplayValue(magic) || std::memcmp(magic, recordingMagic, sizeof(recordingMagic)) != 0
+			|| !readReplayValue(version) || version != recordingVersion)
+		{
+			Logger::logError(path + " is not an input recording, or was made by a different version.");
+			replayData.clear();
+			return false;
+		}
+
+		replayStartTime = frameTime;
+		replayedKeys.reset();
+		replaying = true;
+
+		return true;
+	}
+
+	void stopReplay()
+	{
+		// Continuing from the last replayed frame time
+		if (replaying)
+			frameTimeOffset = frameTime - lastUpdateTime;
+
+		replaying = false;
+		replayData.clear();
+		replayData.shrink_to_fit();
+		replayOffset = 0;
+	}
+
+	bool isReplaying()
+	{
+		return replaying;
 	}
 
 	bool getKey(int key)
 	{
-		return find(keysDownThisFrame, key);
+		return isKey(key) && keysDownThisFrame.test(key);
 	}
 
 	bool getKeyPressed(int key)
 	{
 		// Key must be pressed now but not last frame
-		return find(keysDownThisFrame, key) && !find(keysDownLastFrame, key);
+		return isKey(key) && keysPressedThisFrame.test(key);
 	}
 
 	bool getKeyReleased(int key)
 	{
 		// Key must not be pressed now but last frame
-		return !find(keysDownThisFrame, key) && find(keysDownLastFrame, key);
+		return isKey(key) && keysReleasedThisFrame.test(key);
 	}
 
 	bool getMouseButton(int mouseButton)
 	{
-		return find(keysDownThisFrame, mouseButton);
+		return isMouseButton(mouseButton) && mouseButtonsDownThisFrame.test(mouseButton);
 	}
 
 	bool getMouseButtonPressed(int mouseButton)
 	{
-		// Key must be pressed now but not last frame
-		return find(keysDownThisFrame, mouseButton) && !find(keysDownLastFrame, mouseButton);
+		// Button must be pressed now but not last frame
+		return isMouseButton(mouseButton) && mouseButtonsPressedThisFrame.test(mouseButton);
 	}
 
 	bool getMouseButtonReleased(int mouseButton)
 	{
-		// Key must not be pressed now but last frame
-		return !find(keysDownThisFrame, mouseButton) && find(keysDownLastFrame, mouseButton);
+		// Button must not be pressed now but last frame
+		return isMouseButton(mouseButton) && mouseButtonsReleasedThisFrame.test(mouseButton);
 	}
 
 	glm::vec2 getMousePosition()
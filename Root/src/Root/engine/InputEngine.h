@@ -6,27 +6,74 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
-#include <vector>
+#include <string>
 
 namespace InputEngine
 {
 	/**
 	 * Initialise the input engine.
+	 * Sets the GLFW input callbacks of the active window, calling the callbacks that were set before.
 	 */
 	void initialise();
 
 	/**
 	 * Update the input engine.
-	 * Sets variables to enable key detection.
+	 * Takes the input received since the last frame, or the next frame of the recording when replaying one.
+	 *
+	 * \param time: the current time.
 	 */
-	void update();
+	void update(double time);
 
 	/**
 	 * Indicate a new frame.
-	 * Resets variables for input detection
+	 * Remembers the input of this frame to detect presses and releases in the next one.
 	 */
 	void newFrame();
 
+	/**
+	 * Get the time of the current frame.
+	 * This is the time given to update(), unless a recording is being replayed.
+	 *
+	 * \returns the time of the current frame.
+	 */
+	double getFrameTime();
+
+	/**
+	 * Start writing the input of every frame to a file.
+	 * Stops the recording that was running.
+	 *
+	 * \param path: the path of the file to write to.
+	 * \returns whether the file could be opened.
+	 */
+	bool startRecording(const std::string& path);
+
+	/**
+	 * Stop writing input to the recording file.
+	 */
+	void stopRecording();
+
+	/**
+	 * Use the input of a recording instead of the actual input, starting next frame.
+	 * The frame times are also replayed, so that the replay is deterministic.
+	 * Goes back to the actual input when the recording ends.
+	 *
+	 * \param path: the path of the recording.
+	 * \returns whether the recording could be loaded.
+	 */
+	bool startReplay(const std::string& path);
+
+	/**
+	 * Stop replaying the recording and go back to the actual input.
+	 */
+	void stopReplay();
+
+	/**
+	 * Get whether a recording is being replayed.
+	 *
+	 * \returns whether a recording is being replayed.
+	 */
+	bool isReplaying();
+
 	/**
 	 * Get whether the key is currently pressed.
 	 * Returns true on every frame the key is down.
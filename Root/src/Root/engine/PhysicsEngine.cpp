@@ -1,5 +1,11 @@
 #include "PhysicsEngine.h"
 
+#include <Root/rendering/PhysicsDebugRenderer.h>
+
+#include <fstream>
+#include <memory>
+#include <algorithm>
+
 
 namespace PhysicsEngine
 {
@@ -10,22 +16,514 @@ namespace PhysicsEngine
 		int32 velocityIterations{ 6 };
 		int32 positionIterations{ 2 };
 		float timeStep{ 1.0f / 60.0f };
-		b2Body* body;
 		bool debugModeEnabled{ false };
+		// Created on first use, when there is an OpenGL context
+		PhysicsDebugRenderer* debugRenderer{ nullptr };
+		uint32 debugCategories{ PHYSICS_DEBUG_SHAPES };
 
-		// Initialise the world without gravity
-		b2World world{ b2World(b2Vec2(0.0f, -10.0f)) };
-
-		std::vector<b2Body*> bodiesToDestroy;
-		std::queue<BodyEnabledStateChange> bodyEnabledStateChanges;
-		std::queue<BodyPositionChange> bodyPositionChanges;
+		// The gravity of every world, also given to worlds created later
+		b2Vec2 worldGravity{ 0.0f, -10.0f };
 
 		CollisionCallbackHandler collisionCallbackHandler;
+
+		/**
+		 * A Box2D world, with the changes to its bodies that must wait until it is no longer stepping.
+		 */
+		struct PhysicsWorld
+		{
+			PhysicsWorld(StringID name)
+				: name(name)
+				, world(worldGravity)
+			{
+				world.SetContactListener(&collisionCallbackHandler);
+				collisionCallbackHandler.addWorld(&world);
+			}
+
+			StringID name;
+			b2World world;
+
+			std::vector<b2Body*> bodiesToDestroy;
+			std::queue<BodyEnabledStateChange> bodyEnabledStateChanges;
+			std::queue<BodyPositionChange> bodyPositionChanges;
+		};
+
+		std::vector<std::unique_ptr<PhysicsWorld>> createDefaultWorlds()
+		{
+			std::vector<std::unique_ptr<PhysicsWorld>> defaultWorlds;
+			// The name is set in initialise(), since the string interner may not exist yet
+			defaultWorlds.push_back(std::make_unique<PhysicsWorld>(EMPTY_STRING_ID));
+			return defaultWorlds;
+		}
+
+		// All worlds, indexed by their IDs. The default world is always the first.
+		// Stored as pointers, since the contact listener refers to the b2World by address.
+		std::vector<std::unique_ptr<PhysicsWorld>> worlds{ createDefaultWorlds() };
+
+		PhysicsWorld* findWorld(const b2World* world)
+		{
+			for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+			{
+				if (&physicsWorld->world == world)
+					return physicsWorld.get();
+			}
+			return nullptr;
+		}
+
+		bool isAnyWorldLocked()
+		{
+			for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+			{
+				if (physicsWorld->world.IsLocked())
+					return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Make Box2D fill in its global table of contact functions.
+		 * Box2D does this without synchronisation on the first contact it creates,
+		 * so it must happen before worlds are stepped on several threads.
+		 */
+		void initialiseContactRegisters()
+		{
+			b2World warmUpWorld{ b2Vec2(0.0f, 0.0f) };
+
+			b2CircleShape circle;
+			circle.m_radius = 1.0f;
+
+			b2BodyDef bodyDef;
+			warmUpWorld.CreateBody(&bodyDef)->CreateFixture(&circle, 1.0f);
+			bodyDef.type = b2_dynamicBody;
+			warmUpWorld.CreateBody(&bodyDef)->CreateFixture(&circle, 1.0f);
+
+			// The overlapping bodies create a contact during the step
+			warmUpWorld.Step(timeStep, velocityIterations, positionIterations);
+		}
+
+		// The names of the 16 layers
+		StringID layerNames[16]{};
+		// For each layer, the layers it may collide with
+		LayerMask layerCollisionMatrix[16]{
+			LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL,
+			LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL, LAYER_ALL };
+
+		struct RigidbodySlot
+		{
+			Rigidbody* rigidbody;
+			std::uint32_t generation;
+		};
+
+		// All rigidbodies, indexed by their handles
+		std::vector<RigidbodySlot> rigidbodySlots;
+		std::vector<std::uint32_t> freeRigidbodySlots;
+
+		void refilterAllFixtures()
+		{
+			for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+			{
+				for (b2Body* body{ physicsWorld->world.GetBodyList() }; body != nullptr; body = body->GetNext())
+				{
+					for (b2Fixture* fixture{ body->GetFixtureList() }; fixture != nullptr; fixture = fixture->GetNext())
+					{
+						FixtureData* fixtureData{ reinterpret_cast<FixtureData*>(fixture->GetUserData().pointer) };
+						if (fixtureData == nullptr)
+							continue;
+
+						fixture->SetFilterData(createFilter(fixture->GetFilterData().categoryBits, fixtureData->interactionLayerMask));
+					}
+				}
+			}
+		}
+
+		struct TransformWrite
+		{
+			Rigidbody* rigidbody;
+			glm::vec2 position;
+			float rotation;
+		};
+
+		// Kept between frames so that synchronising does not allocate
+		std::vector<TransformWrite> transformWrites;
+		TransformSyncStats transformSyncStats{};
+
+		// Off by default, since measuring a step walks every body and contact
+		bool profilingEnabled{ false };
+
+		// The number of physics steps kept in the profile history
+		const unsigned int profileHistorySize{ 120 };
+		// Ring buffer of the most recent steps, nextProfileIndex is the oldest once it is full
+		std::vector<PhysicsStepProfile> profileHistory;
+		unsigned int nextProfileIndex{ 0 };
+
+		// Kept between steps so that counting islands does not allocate.
+		// The island index of each awake body, sorted by body so it can be searched
+		std::vector<std::pair<b2Body*, unsigned int>> islandIndices;
+		std::vector<unsigned int> islandParents;
+
+		/**
+		 * Find the island index of a body.
+		 *
+		 * \returns whether the body has an island index, which static, sleeping and disabled bodies do not.
+		 */
+		bool findIslandIndex(b2Body* body, unsigned int& index)
+		{
+			auto position{ std::lower_bound(islandIndices.begin(), islandIndices.end(), body,
+				[](const std::pair<b2Body*, unsigned int>& entry, b2Body* body) { return entry.first < body; }) };
+
+			if (position == islandIndices.end() || position->first != body)
+				return false;
+
+			index = position->second;
+			return true;
+		}
+
+		unsigned int findIsland(unsigned int index)
+		{
+			while (islandParents[index] != index)
+			{
+				// Halving the path on the way up
+				islandParents[index] = islandParents[islandParents[index]];
+				index = islandParents[index];
+			}
+			return index;
+		}
+
+		void joinIslands(b2Body* bodyA, b2Body* bodyB, unsigned int& islandCount)
+		{
+			// Static, sleeping and disabled bodies are not part of any island
+			unsigned int indexA;
+			unsigned int indexB;
+			if (!findIslandIndex(bodyA, indexA) || !findIslandIndex(bodyB, indexB))
+				return;
+
+			unsigned int islandA{ findIsland(indexA) };
+			unsigned int islandB{ findIsland(indexB) };
+			if (islandA == islandB)
+				return;
+
+			islandParents[islandA] = islandB;
+			islandCount--;
+		}
+
+		/**
+		 * Count the groups of awake bodies that touch or are jointed, like Box2D builds its islands.
+		 */
+		unsigned int countIslands(b2World& world)
+		{
+			islandIndices.clear();
+			islandParents.clear();
+
+			for (b2Body* body{ world.GetBodyList() }; body != nullptr; body = body->GetNext())
+			{
+				if (body->GetType() == b2_staticBody || !body->IsAwake() || !body->IsEnabled())
+					continue;
+
+				islandIndices.emplace_back(body, static_cast<unsigned int>(islandParents.size()));
+				islandParents.push_back(static_cast<unsigned int>(islandParents.size()));
+			}
+
+			std::sort(islandIndices.begin(), islandIndices.end(),
+				[](const std::pair<b2Body*, unsigned int>& a, const std::pair<b2Body*, unsigned int>& b) { return a.first < b.first; });
+
+			// Every body starts out as its own island
+			unsigned int islandCount{ static_cast<unsigned int>(islandParents.size()) };
+
+			for (b2Contact* contact{ world.GetContactList() }; contact != nullptr; contact = contact->GetNext())
+			{
+				if (!contact->IsTouching() || !contact->IsEnabled()
+					|| contact->GetFixtureA()->IsSensor() || contact->GetFixtureB()->IsSensor())
+					continue;
+
+				joinIslands(contact->GetFixtureA()->GetBody(), contact->GetFixtureB()->GetBody(), islandCount);
+			}
+
+			for (b2Joint* joint{ world.GetJointList() }; joint != nullptr; joint = joint->GetNext())
+			{
+				joinIslands(joint->GetBodyA(), joint->GetBodyB(), islandCount);
+			}
+
+			return islandCount;
+		}
+
+		/**
+		 * Add the measurements of the step a world just took to the profile.
+		 */
+		void measureWorld(b2World& world, PhysicsStepProfile& profile)
+		{
+			const b2Profile& box2DProfile{ world.GetProfile() };
+			profile.step += box2DProfile.step;
+			profile.collide += box2DProfile.collide;
+			profile.solve += box2DProfile.solve;
+			profile.solveInit += box2DProfile.solveInit;
+			profile.solveVelocity += box2DProfile.solveVelocity;
+			profile.solvePosition += box2DProfile.solvePosition;
+			profile.broadphase += box2DProfile.broadphase;
+			profile.solveTOI += box2DProfile.solveTOI;
+
+			profile.bodyCount += static_cast<unsigned int>(world.GetBodyCount());
+			profile.contactCount += static_cast<unsigned int>(world.GetContactCount());
+			profile.proxyCount += static_cast<unsigned int>(world.GetProxyCount());
+			profile.jointCount += static_cast<unsigned int>(world.GetJointCount());
+
+			for (b2Body* body{ world.GetBodyList() }; body != nullptr; body = body->GetNext())
+			{
+				if (body->GetType() != b2_staticBody && body->IsAwake() && body->IsEnabled())
+					profile.awakeBodyCount++;
+			}
+
+			for (b2Contact* contact{ world.GetContactList() }; contact != nullptr; contact = contact->GetNext())
+			{
+				if (contact->IsTouching())
+					profile.touchingContactCount++;
+			}
+
+			profile.islandCount += countIslands(world);
+		}
+
+		void publishProfile(const PhysicsStepProfile& profile)
+		{
+			Profiler::setTiming("Physics collide", profile.collide);
+			Profiler::setTiming("Physics solve", profile.solve);
+			Profiler::setTiming("Physics broad-phase", profile.broadphase);
+			Profiler::setTiming("Physics TOI", profile.solveTOI);
+			Profiler::setTiming("Physics queues", profile.queues);
+
+			Profiler::setCounter("Bodies (awake)", profile.awakeBodyCount);
+			Profiler::setCounter("Bodies (total)", profile.bodyCount);
+			Profiler::setCounter("Contacts (touching)", profile.touchingContactCount);
+			Profiler::setCounter("Contacts (total)", profile.contactCount);
+			Profiler::setCounter("Proxies", profile.proxyCount);
+			Profiler::setCounter("Islands", profile.islandCount);
+			Profiler::setCounter("Queued body changes",
+				profile.bodiesToDestroy + profile.bodyEnabledStateChanges + profile.bodyPositionChanges);
+
+			// Only building the graph when the profiler window is going to be updated
+			if (!Profiler::enabled || Profiler::timeSinceUpdate != 0)
+				return;
+
+			std::vector<float> stepTimes;
+			stepTimes.reserve(profileHistory.size());
+			for (const PhysicsStepProfile& recordedProfile : getProfileHistory())
+			{
+				stepTimes.push_back(recordedProfile.step);
+			}
+			Profiler::setGraph("Physics step (ms)", stepTimes);
+		}
+
+		/**
+		 * Apply the changes that were made to the bodies of a world while it was locked.
+		 */
+		void applyQueuedChanges(PhysicsWorld& physicsWorld)
+		{
+			// First we delete all bodies waiting to be destroyed
+			for (b2Body*& body : physicsWorld.bodiesToDestroy)
+			{
+				physicsWorld.world.DestroyBody(body);
+			}
+			physicsWorld.bodiesToDestroy.clear();
+
+			// Then we update all the enabled states
+			while (!physicsWorld.bodyEnabledStateChanges.empty())
+			{
+				BodyEnabledStateChange enabledStateChangeInfo = physicsWorld.bodyEnabledStateChanges.front();
+				enabledStateChangeInfo.body->SetEnabled(enabledStateChangeInfo.flag);
+				physicsWorld.bodyEnabledStateChanges.pop();
+			}
+
+			// Then we apply all the position changes
+			while (!physicsWorld.bodyPositionChanges.empty())
+			{
+				BodyPositionChange bodyPositionChange = physicsWorld.bodyPositionChanges.front();
+
+				bodyPositionChange.body->SetTransform(
+					b2Vec2(bodyPositionChange.position.x, bodyPositionChange.position.y),
+					bodyPositionChange.body->GetAngle());
+
+				physicsWorld.bodyPositionChanges.pop();
+			}
+		}
+
+		void recordProfile(const PhysicsStepProfile& profile)
+		{
+			if (profileHistory.size() < profileHistorySize)
+			{
+				profileHistory.push_back(profile);
+				return;
+			}
+
+			profileHistory[nextProfileIndex] = profile;
+			nextProfileIndex = (nextProfileIndex + 1) % profileHistorySize;
+		}
+
+		// The rigidbodies with a simulation LOD other than ALWAYS_SIMULATE
+		std::vector<Rigidbody*> lodRigidbodies;
+		SimulationLODStats simulationLODStats{};
+
+		// The number of queries handed to a worker thread at a time in batched queries
+		const unsigned int queryBatchSize{ 16 };
+
+		Rigidbody* getFixtureRigidbody(b2Fixture* fixture)
+		{
+			return reinterpret_cast<Rigidbody*>(fixture->GetBody()->GetUserData().pointer);
+		}
+
+		bool passesQueryFilter(b2Fixture* fixture, LayerMask layerMask)
+		{
+			// Bodies without a rigidbody are waiting to be destroyed
+			return (fixture->GetFilterData().categoryBits & layerMask) != 0
+				&& getFixtureRigidbody(fixture) != nullptr;
+		}
+
+		class ClosestRaycastCallback : public b2RayCastCallback
+		{
+		public:
+			ClosestRaycastCallback(LayerMask layerMask)
+				: layerMask(layerMask)
+			{
+			}
+
+			float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override
+			{
+				// Returning -1 ignores the fixture
+				if (fixture->IsSensor() || !passesQueryFilter(fixture, layerMask))
+					return -1.0f;
+
+				hit = true;
+				closestHit = RaycastHit{ getFixtureRigidbody(fixture), fixture,
+					glm::vec2(point.x, point.y), glm::vec2(normal.x, normal.y), fraction };
+
+				// Clipping the ray to this hit, so only closer fixtures are reported after this
+				return fraction;
+			}
+
+			LayerMask layerMask;
+			bool hit{ false };
+			RaycastHit closestHit{};
+		};
+
+		class AllRaycastCallback : public b2RayCastCallback
+		{
+		public:
+			AllRaycastCallback(LayerMask layerMask)
+				: layerMask(layerMask)
+			{
+			}
+
+			float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override
+			{
+				if (fixture->IsSensor() || !passesQueryFilter(fixture, layerMask))
+					return -1.0f;
+
+				hits.push_back(RaycastHit{ getFixtureRigidbody(fixture), fixture,
+					glm::vec2(point.x, point.y), glm::vec2(normal.x, normal.y), fraction });
+
+				// Continuing along the full ray
+				return 1.0f;
+			}
+
+			LayerMask layerMask;
+			std::vector<RaycastHit> hits;
+		};
+
+		class FixtureQueryCallback : public b2QueryCallback
+		{
+		public:
+			FixtureQueryCallback(LayerMask layerMask)
+				: layerMask(layerMask)
+			{
+			}
+
+			bool ReportFixture(b2Fixture* fixture) override
+			{
+				if (passesQueryFilter(fixture, layerMask))
+					fixtures.push_back(fixture);
+
+				// Continuing the query
+				return true;
+			}
+
+			LayerMask layerMask;
+			std::vector<b2Fixture*> fixtures;
+		};
+
+		bool raycastClosest(glm::vec2 origin, glm::vec2 end, RaycastHit& hit, LayerMask layerMask)
+		{
+			// Box2D asserts on zero length rays
+			if (origin == end)
+				return false;
+
+			bool anyHit{ false };
+			float closestFraction{ 1.0f };
+
+			for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+			{
+				ClosestRaycastCallback callback{ layerMask };
+				physicsWorld->world.RayCast(&callback, b2Vec2(origin.x, origin.y), b2Vec2(end.x, end.y));
+
+				// Keeping the closest hit over all worlds
+				if (callback.hit && callback.closestHit.fraction <= closestFraction)
+				{
+					anyHit = true;
+					closestFraction = callback.closestHit.fraction;
+					hit = callback.closestHit;
+				}
+			}
+
+			return anyHit;
+		}
+
+		void overlapShape(const b2Shape& shape, const b2Transform& shapeTransform,
+			LayerMask layerMask, std::vector<Rigidbody*>& result)
+		{
+			// Finding the candidates with the broad-phase
+			b2AABB aabb;
+			shape.ComputeAABB(&aabb, shapeTransform, 0);
+
+			FixtureQueryCallback callback{ layerMask };
+			for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+			{
+				physicsWorld->world.QueryAABB(&callback, aabb);
+			}
+
+			// Then testing the actual shapes
+			for (b2Fixture* fixture : callback.fixtures)
+			{
+				Rigidbody* rigidbody{ getFixtureRigidbody(fixture) };
+
+				// Only adding each rigidbody once
+				if (std::find(result.begin(), result.end(), rigidbody) != result.end())
+					continue;
+
+				const b2Shape* fixtureShape{ fixture->GetShape() };
+				for (int32 child{ 0 }; child < fixtureShape->GetChildCount(); child++)
+				{
+					if (b2TestOverlap(fixtureShape, child, &shape, 0,
+						fixture->GetBody()->GetTransform(), shapeTransform))
+					{
+						result.push_back(rigidbody);
+						break;
+					}
+				}
+			}
+		}
+
+		void overlapCircleInto(glm::vec2 center, float radius, LayerMask layerMask, std::vector<Rigidbody*>& result)
+		{
+			b2CircleShape circle;
+			circle.m_radius = radius;
+
+			b2Transform transform;
+			transform.Set(b2Vec2(center.x, center.y), 0.0f);
+
+			overlapShape(circle, transform, layerMask, result);
+		}
 	}
 
 	void initialise()
 	{
-		world.SetContactListener(&collisionCallbackHandler);
+		worlds[DEFAULT_PHYSICS_WORLD]->name = StringInterner::intern("default");
+
+		initialiseContactRegisters();
 	}
 
 	void simulate()
@@ -55,69 +553,468 @@ namespace PhysicsEngine
 
 	void step(float deltaTime)
 	{
-		// First we delete all bodies waiting to be destroyed
-		for (b2Body*& body : bodiesToDestroy)
+		PROFILE_FUNCTION();
+
+		updateSimulationLOD();
+
+		PhysicsStepProfile profile{};
+
+		auto queuesStart{ std::chrono::steady_clock::now() };
+
+		for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
 		{
-			world.DestroyBody(body);
+			profile.bodiesToDestroy += static_cast<unsigned int>(physicsWorld->bodiesToDestroy.size());
+			profile.bodyEnabledStateChanges += static_cast<unsigned int>(physicsWorld->bodyEnabledStateChanges.size());
+			profile.bodyPositionChanges += static_cast<unsigned int>(physicsWorld->bodyPositionChanges.size());
+
+			applyQueuedChanges(*physicsWorld);
 		}
 
-		// Then we update all the enabled states
-		while (!bodyEnabledStateChanges.empty())
+		profile.queues = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - queuesStart).count();
+
+		// The worlds share no bodies, so they can all be stepped at the same time.
+		// Each world records its contacts into its own buffer in the collision callback handler.
+		WorkerPool::parallelFor(static_cast<unsigned int>(worlds.size()), 1,
+			[deltaTime](unsigned int begin, unsigned int end)
+			{
+				for (unsigned int i{ begin }; i < end; i++)
+				{
+					PROFILE_ZONE("Physics world step");
+					worlds[i]->world.Step(deltaTime, velocityIterations, positionIterations);
+				}
+			});
+
+		Profiler::addCheckpoint("Physics step");
+
+		if (profilingEnabled)
 		{
-			BodyEnabledStateChange enabledStateChangeInfo = bodyEnabledStateChanges.front();
-			enabledStateChangeInfo.body->SetEnabled(enabledStateChangeInfo.flag);
-			bodyEnabledStateChanges.pop();
+			for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+			{
+				measureWorld(physicsWorld->world, profile);
+			}
+			recordProfile(profile);
+			publishProfile(profile);
 		}
 
-		// Then we apply all the position changes
-		while (!bodyPositionChanges.empty())
+		// The worlds are unlocked again, so listeners can safely change them
+		collisionCallbackHandler.dispatchEvents();
+
+		Profiler::addCheckpoint("Collision callbacks");
+	}
+
+	void renderDebugView()
+	{
+		PROFILE_FUNCTION();
+
+		if (!debugModeEnabled)
+			return;
+
+		Camera* camera{ RootEngine::getActiveCamera() };
+
+		if (camera == nullptr)
+			return;
+
+		PROFILE_GPU_ZONE("Physics debug view");
+
+		if (debugRenderer == nullptr)
 		{
-			BodyPositionChange bodyPositionChange = bodyPositionChanges.front();
+			debugRenderer = new PhysicsDebugRenderer;
+		}
+		debugRenderer->SetFlags(debugCategories);
+
+		glm::mat4 view{ camera->getTransform()->getInverseTransformMatrix() };
+		glm::mat4 projection{ camera->getProjectionMatrix() };
 
-			bodyPositionChange.body->SetTransform(
-				b2Vec2(bodyPositionChange.position.x, bodyPositionChange.position.y),
-				bodyPositionChange.body->GetAngle());
+		// Finding the visible area by transforming the corners of the screen back to the world
+		glm::mat4 screenToWorld{ glm::inverse(projection * view) };
+
+		b2AABB viewBounds;
+		viewBounds.lowerBound = b2Vec2(FLT_MAX, FLT_MAX);
+		viewBounds.upperBound = b2Vec2(-FLT_MAX, -FLT_MAX);
+
+		for (glm::vec2 corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) })
+		{
+			glm::vec4 worldCorner{ screenToWorld * glm::vec4(corner, 0.0f, 1.0f) };
+			b2Vec2 point{ worldCorner.x, worldCorner.y };
 
-			bodyPositionChanges.pop();
+			viewBounds.lowerBound = b2Min(viewBounds.lowerBound, point);
+			viewBounds.upperBound = b2Max(viewBounds.upperBound, point);
 		}
 
+		float pixelSize{ (viewBounds.upperBound.y - viewBounds.lowerBound.y) / (float)RootEngine::getScreenHeight() };
 
-		bodiesToDestroy.clear();
+		for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+		{
+			debugRenderer->collect(physicsWorld->world, viewBounds, pixelSize);
+		}
+		debugRenderer->render(RootEngine::getPhysicsDebugRenderShader(), view, projection);
 
-		world.Step(deltaTime, velocityIterations, positionIterations);
+		Profiler::setCounter("Physics debug vertices", debugRenderer->getLastVertexCount());
+	}
 
-		Profiler::addCheckpoint("Physics step");
+	void setDebugCategories(uint32 categories)
+	{
+		debugCategories = categories;
 	}
 
-	void renderDebugView()
+	uint32 getDebugCategories()
 	{
-		if (!debugModeEnabled)
+		return debugCategories;
+	}
+
+	bool raycast(glm::vec2 origin, glm::vec2 end, RaycastHit& hit, LayerMask layerMask)
+	{
+		return raycastClosest(origin, end, hit, layerMask);
+	}
+
+	std::vector<RaycastHit> raycastAll(glm::vec2 origin, glm::vec2 end, LayerMask layerMask)
+	{
+		if (origin == end)
+			return std::vector<RaycastHit>{};
+
+		AllRaycastCallback callback{ layerMask };
+		for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+		{
+			physicsWorld->world.RayCast(&callback, b2Vec2(origin.x, origin.y), b2Vec2(end.x, end.y));
+		}
+
+		// Box2D reports fixtures in no particular order
+		std::sort(callback.hits.begin(), callback.hits.end(),
+			[](const RaycastHit& a, const RaycastHit& b) { return a.fraction < b.fraction; });
+
+		return callback.hits;
+	}
+
+	std::vector<Rigidbody*> overlapAABB(glm::vec2 min, glm::vec2 max, LayerMask layerMask)
+	{
+		std::vector<Rigidbody*> result;
+
+		glm::vec2 halfExtents{ (max - min) * 0.5f };
+		glm::vec2 center{ (max + min) * 0.5f };
+
+		// A box must have a size to be tested against
+		if (halfExtents.x <= 0.0f || halfExtents.y <= 0.0f)
+			return result;
+
+		b2PolygonShape box;
+		box.SetAsBox(halfExtents.x, halfExtents.y);
+
+		b2Transform transform;
+		transform.Set(b2Vec2(center.x, center.y), 0.0f);
+
+		overlapShape(box, transform, layerMask, result);
+		return result;
+	}
+
+	std::vector<Rigidbody*> overlapCircle(glm::vec2 center, float radius, LayerMask layerMask)
+	{
+		std::vector<Rigidbody*> result;
+		overlapCircleInto(center, radius, layerMask, result);
+		return result;
+	}
+
+	bool shapeCast(const b2Shape& shape,
+		glm::vec2 position,
+		float rotation,
+		glm::vec2 translation,
+		ShapeCastHit& hit,
+		LayerMask layerMask)
+	{
+		b2Transform startTransform;
+		startTransform.Set(b2Vec2(position.x, position.y), glm::radians(rotation));
+
+		b2Transform endTransform{ startTransform };
+		endTransform.p += b2Vec2(translation.x, translation.y);
+
+		// Finding the candidates with the broad-phase, using the AABB of the whole sweep
+		b2AABB startAABB;
+		b2AABB endAABB;
+		shape.ComputeAABB(&startAABB, startTransform, 0);
+		shape.ComputeAABB(&endAABB, endTransform, 0);
+
+		b2AABB sweptAABB;
+		sweptAABB.Combine(startAABB, endAABB);
+
+		FixtureQueryCallback callback{ layerMask };
+		for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+		{
+			physicsWorld->world.QueryAABB(&callback, sweptAABB);
+		}
+
+		bool anyHit{ false };
+		float closestFraction{ 1.0f };
+
+		for (b2Fixture* fixture : callback.fixtures)
+		{
+			if (fixture->IsSensor())
+				continue;
+
+			const b2Shape* fixtureShape{ fixture->GetShape() };
+			for (int32 child{ 0 }; child < fixtureShape->GetChildCount(); child++)
+			{
+				b2ShapeCastInput input;
+				input.proxyA.Set(fixtureShape, child);
+				input.proxyB.Set(&shape, 0);
+				input.transformA = fixture->GetBody()->GetTransform();
+				input.transformB = startTransform;
+				input.translationB = b2Vec2(translation.x, translation.y);
+
+				b2ShapeCastOutput output;
+				if (!b2ShapeCast(&output, &input) || output.lambda > closestFraction)
+					continue;
+
+				anyHit = true;
+				closestFraction = output.lambda;
+				hit = ShapeCastHit{ getFixtureRigidbody(fixture), fixture,
+					glm::vec2(output.point.x, output.point.y),
+					glm::vec2(output.normal.x, output.normal.y),
+					output.lambda };
+			}
+		}
+
+		return anyHit;
+	}
+
+	void raycastBatch(const std::vector<RaycastQuery>& queries, std::vector<RaycastResult>& results)
+	{
+		results.resize(queries.size());
+
+		auto job{ [&](unsigned int begin, unsigned int end)
+		{
+			for (unsigned int i{ begin }; i < end; i++)
+			{
+				const RaycastQuery& query{ queries[i] };
+				results[i].hit = raycastClosest(query.origin, query.end, results[i].closestHit, query.layerMask);
+			}
+		} };
+
+		// The broad-phase may only be read from several threads while nothing changes it
+		if (isAnyWorldLocked())
+		{
+			job(0, static_cast<unsigned int>(queries.size()));
 			return;
+		}
+
+		WorkerPool::parallelFor(static_cast<unsigned int>(queries.size()), queryBatchSize, job);
+	}
 
-		b2Body* body{ world.GetBodyList() };
+	void overlapCircleBatch(const std::vector<OverlapCircleQuery>& queries, std::vector<OverlapResult>& results)
+	{
+		results.resize(queries.size());
 
-		for (unsigned int i{ 0 }; i < world.GetBodyCount(); i++)
+		auto job{ [&](unsigned int begin, unsigned int end)
 		{
-			// Retrieving the fixture data
-			FixtureData* fixtureData{ 
-				reinterpret_cast<FixtureData*>(
-					body->GetFixtureList()->GetUserData().pointer
-				)
-			};
+			for (unsigned int i{ begin }; i < end; i++)
+			{
+				const OverlapCircleQuery& query{ queries[i] };
+				results[i].rigidbodies.clear();
+				overlapCircleInto(query.center, query.radius, query.layerMask, results[i].rigidbodies);
+			}
+		} };
 
-			if (fixtureData == nullptr)
+		// The broad-phase may only be read from several threads while nothing changes it
+		if (isAnyWorldLocked())
+		{
+			job(0, static_cast<unsigned int>(queries.size()));
+			return;
+		}
+
+		WorkerPool::parallelFor(static_cast<unsigned int>(queries.size()), queryBatchSize, job);
+	}
+
+	void syncRigidbodyTransforms()
+	{
+		PROFILE_FUNCTION();
+
+		transformSyncStats = TransformSyncStats{};
+		transformWrites.clear();
+
+		// First reading every body that changed, without touching any transforms
+		for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+		{
+			for (b2Body* body{ physicsWorld->world.GetBodyList() }; body != nullptr; body = body->GetNext())
 			{
-				body = body->GetNext();
-				continue;
+				Rigidbody* rigidbody{ reinterpret_cast<Rigidbody*>(body->GetUserData().pointer) };
+
+				// The rigidbody was destroyed, but the body is still waiting to be destroyed
+				if (rigidbody == nullptr)
+					continue;
+
+				bool inactive{ !rigidbody->isEnabled()
+					|| (!rigidbody->isTransformSyncRequested()
+						&& (body->GetType() == b2_staticBody || !body->IsAwake())) };
+
+				if (inactive)
+				{
+					transformSyncStats.skippedInactive++;
+					continue;
+				}
+
+				if (!rigidbody->pollBodyTransformChange())
+				{
+					transformSyncStats.skippedUnchanged++;
+					continue;
+				}
+
+				const b2Vec2& position{ body->GetPosition() };
+				transformWrites.push_back(TransformWrite{
+					rigidbody, glm::vec2(position.x, position.y), glm::degrees(body->GetAngle()) });
 			}
+		}
+
+		// Then writing all changes to the transforms at once
+		for (TransformWrite& transformWrite : transformWrites)
+		{
+			transformWrite.rigidbody->applyBodyTransform(transformWrite.position, transformWrite.rotation);
+		}
+
+		transformSyncStats.synced = static_cast<unsigned int>(transformWrites.size());
+
+		Profiler::setCounter("Rigidbodies synced", transformSyncStats.synced);
+		Profiler::setCounter("Rigidbodies skipped (inactive)", transformSyncStats.skippedInactive);
+		Profiler::setCounter("Rigidbodies skipped (unchanged)", transformSyncStats.skippedUnchanged);
+	}
+
+	TransformSyncStats getTransformSyncStats()
+	{
+		return transformSyncStats;
+	}
+
+	void setProfilingEnabled(bool enabled)
+	{
+		profilingEnabled = enabled;
+	}
+
+	std::vector<PhysicsStepProfile> getProfileHistory()
+	{
+		// Rotating the ring buffer so that the oldest step comes first
+		std::vector<PhysicsStepProfile> history;
+		history.reserve(profileHistory.size());
+		history.insert(history.end(), profileHistory.begin() + nextProfileIndex, profileHistory.end());
+		history.insert(history.end(), profileHistory.begin(), profileHistory.begin() + nextProfileIndex);
+		return history;
+	}
+
+	bool writeProfileHistory(const std::string& path)
+	{
+		std::ofstream file{ path };
+
+		if (!file.is_open())
+		{
+			Logger::logError("Could not open file " + path + " to write the physics profile to.");
+			return false;
+		}
+
+		file << "{\n\t\"steps\": [";
+
+		std::vector<PhysicsStepProfile> history{ getProfileHistory() };
+		for (unsigned int i{ 0 }; i < history.size(); i++)
+		{
+			const PhysicsStepProfile& profile{ history[i] };
+
+			file << (i == 0 ? "\n" : ",\n") << "\t\t{"
+				<< "\"step\": " << profile.step
+				<< ", \"collide\": " << profile.collide
+				<< ", \"solve\": " << profile.solve
+				<< ", \"solveInit\": " << profile.solveInit
+				<< ", \"solveVelocity\": " << profile.solveVelocity
+				<< ", \"solvePosition\": " << profile.solvePosition
+				<< ", \"broadphase\": " << profile.broadphase
+				<< ", \"solveTOI\": " << profile.solveTOI
+				<< ", \"queues\": " << profile.queues
+				<< ", \"bodiesToDestroy\": " << profile.bodiesToDestroy
+				<< ", \"bodyEnabledStateChanges\": " << profile.bodyEnabledStateChanges
+				<< ", \"bodyPositionChanges\": " << profile.bodyPositionChanges
+				<< ", \"bodyCount\": " << profile.bodyCount
+				<< ", \"awakeBodyCount\": " << profile.awakeBodyCount
+				<< ", \"contactCount\": " << profile.contactCount
+				<< ", \"touchingContactCount\": " << profile.touchingContactCount
+				<< ", \"proxyCount\": " << profile.proxyCount
+				<< ", \"jointCount\": " << profile.jointCount
+				<< ", \"islandCount\": " << profile.islandCount
+				<< "}";
+		}
+
+		file << "\n\t]\n}\n";
+		return true;
+	}
 
-			// Retrieving the rigidbody
-			Rigidbody* rigidbody{ fixtureData->rigidbody };
+	void setSimulationLODEnabled(Rigidbody* rigidbody, bool enabled)
+	{
+		auto position{ std::find(lodRigidbodies.begin(), lodRigidbodies.end(), rigidbody) };
+		bool registered{ position != lodRigidbodies.end() };
 
-			rigidbody->renderDebugView();
+		if (enabled && !registered)
+		{
+			lodRigidbodies.push_back(rigidbody);
+		}
+		else if (!enabled && registered)
+		{
+			// The order does not matter, so the last rigidbody takes its place
+			*position = lodRigidbodies.back();
+			lodRigidbodies.pop_back();
+		}
+	}
 
-			body = body->GetNext();
+	void updateSimulationLOD()
+	{
+		PROFILE_FUNCTION();
+
+		simulationLODStats = SimulationLODStats{};
+
+		Camera* camera{ RootEngine::getActiveCamera() };
+
+		// Without a camera there is nothing to measure the distance to, so everything stays as it is
+		if (camera == nullptr)
+			return;
+
+		glm::vec2 cameraPosition{ camera->getTransform()->getPosition() };
+
+		for (Rigidbody* rigidbody : lodRigidbodies)
+		{
+			const SimulationLOD& lod{ rigidbody->getSimulationLOD() };
+
+			const b2Vec2& bodyPosition{ rigidbody->getBody()->GetPosition() };
+			glm::vec2 offset{ bodyPosition.x - cameraPosition.x, bodyPosition.y - cameraPosition.y };
+			float distanceSquared{ glm::dot(offset, offset) };
+
+			if (rigidbody->isSimulationActive())
+			{
+				if (distanceSquared > lod.radius * lod.radius)
+				{
+					rigidbody->setSimulationActive(false);
+					simulationLODStats.deactivated++;
+				}
+			}
+			else
+			{
+				// The body must come closer than it was when it was deactivated
+				float activationRadius{ std::max(lod.radius - lod.hysteresis, 0.0f) };
+
+				if (distanceSquared < activationRadius * activationRadius)
+				{
+					rigidbody->setSimulationActive(true);
+					simulationLODStats.activated++;
+				}
+				else if (rigidbody->sleepIfWoken())
+				{
+					simulationLODStats.reslept++;
+				}
+			}
+
+			if (rigidbody->isSimulationActive())
+				simulationLODStats.active++;
+			else
+				simulationLODStats.inactive++;
 		}
+
+		Profiler::setCounter("Rigidbodies simulated (LOD)", simulationLODStats.active);
+		Profiler::setCounter("Rigidbodies deactivated (LOD)", simulationLODStats.inactive);
+	}
+
+	SimulationLODStats getSimulationLODStats()
+	{
+		return simulationLODStats;
 	}
 
 	void enableDebugMode()
@@ -132,7 +1029,12 @@ namespace PhysicsEngine
 
 	void setGravity(float x, float y)
 	{
-		world.SetGravity(b2Vec2(x, y));
+		worldGravity = b2Vec2(x, y);
+
+		for (std::unique_ptr<PhysicsWorld>& physicsWorld : worlds)
+		{
+			physicsWorld->world.SetGravity(worldGravity);
+		}
 	}
 
 	void setCollisionListener(CollisionListener* contactListener)
@@ -140,24 +1042,283 @@ namespace PhysicsEngine
 		collisionCallbackHandler.setCollisionListener(contactListener);
 	}
 
-	b2Body* addBody(b2BodyDef* definition)
+	void addLayerCollisionListener(LayerMask layers, CollisionListener* listener)
+	{
+		collisionCallbackHandler.addLayerCollisionListener(layers, listener);
+	}
+
+	bool removeLayerCollisionListener(CollisionListener* listener)
+	{
+		return collisionCallbackHandler.removeLayerCollisionListener(listener);
+	}
+
+	void setLayerName(unsigned int layerIndex, StringID name)
+	{
+		if (layerIndex >= 16)
+		{
+			Logger::logError("Cannot name layer " + std::to_string(layerIndex) + "; there are only 16 layers.");
+			return;
+		}
+
+		layerNames[layerIndex] = name;
+	}
+
+	LayerMask getLayerByName(StringID name)
+	{
+		// The empty name belongs to every unnamed layer
+		if (name == EMPTY_STRING_ID)
+			return 0;
+
+		for (unsigned int i{ 0 }; i < 16; i++)
+		{
+			if (layerNames[i] == name)
+				return static_cast<LayerMask>(1u << i);
+		}
+
+		return 0;
+	}
+
+	StringID getLayerName(unsigned int layerIndex)
+	{
+		if (layerIndex >= 16)
+			return EMPTY_STRING_ID;
+
+		return layerNames[layerIndex];
+	}
+
+	void setLayersCollide(LayerMask layersA, LayerMask layersB, bool collide)
+	{
+		for (unsigned int i{ 0 }; i < 16; i++)
+		{
+			LayerMask layer{ static_cast<LayerMask>(1u << i) };
+
+			// Setting both directions, so that the matrix stays symmetric
+			LayerMask other{ 0 };
+			if (layersA & layer)
+				other |= layersB;
+			if (layersB & layer)
+				other |= layersA;
+
+			if (collide)
+				layerCollisionMatrix[i] |= other;
+			else
+				layerCollisionMatrix[i] &= ~other;
+		}
+
+		refilterAllFixtures();
+	}
+
+	LayerMask getLayerCollisionMask(LayerMask layers)
 	{
-		body = world.CreateBody(definition);
-		return body;
+		// A collider on several layers collides with anything any of its layers collides with
+		LayerMask mask{ 0 };
+		for (unsigned int i{ 0 }; i < 16; i++)
+		{
+			if (layers & (1u << i))
+				mask |= layerCollisionMatrix[i];
+		}
+		return mask;
+	}
+
+	b2Filter createFilter(LayerMask selfLayerMask, LayerMask interactionLayerMask)
+	{
+		b2Filter filter;
+		filter.categoryBits = selfLayerMask;
+		filter.maskBits = interactionLayerMask & getLayerCollisionMask(selfLayerMask);
+		return filter;
+	}
+
+	RigidbodyHandle registerRigidbody(Rigidbody* rigidbody)
+	{
+		std::uint32_t index;
+
+		// Reusing a free slot if there is one
+		if (!freeRigidbodySlots.empty())
+		{
+			index = freeRigidbodySlots.back();
+			freeRigidbodySlots.pop_back();
+		}
+		else
+		{
+			index = static_cast<std::uint32_t>(rigidbodySlots.size());
+			// Generation 0 is never used, so that default handles are always invalid
+			rigidbodySlots.push_back(RigidbodySlot{ nullptr, 1 });
+		}
+
+		rigidbodySlots[index].rigidbody = rigidbody;
+		return RigidbodyHandle{ index, rigidbodySlots[index].generation };
+	}
+
+	void unregisterRigidbody(RigidbodyHandle handle)
+	{
+		if (getRigidbody(handle) == nullptr)
+			return;
+
+		RigidbodySlot& slot{ rigidbodySlots[handle.index] };
+		slot.rigidbody = nullptr;
+		slot.generation++;
+		freeRigidbodySlots.push_back(handle.index);
+	}
+
+	Rigidbody* getRigidbody(RigidbodyHandle handle)
+	{
+		if (handle.index >= rigidbodySlots.size())
+			return nullptr;
+
+		const RigidbodySlot& slot{ rigidbodySlots[handle.index] };
+		if (slot.generation != handle.generation)
+			return nullptr;
+
+		return slot.rigidbody;
+	}
+
+	PhysicsWorldID createWorld(StringID name)
+	{
+		if (getWorldByName(name) != INVALID_PHYSICS_WORLD)
+		{
+			Logger::logError("Cannot create physics world " + StringInterner::lookup(name) + "; a world with this name already exists.");
+			return INVALID_PHYSICS_WORLD;
+		}
+
+		if (isAnyWorldLocked())
+		{
+			Logger::logError("Cannot create physics world " + StringInterner::lookup(name) + " while the physics worlds are stepping.");
+			return INVALID_PHYSICS_WORLD;
+		}
+
+		worlds.push_back(std::make_unique<PhysicsWorld>(name));
+		return static_cast<PhysicsWorldID>(worlds.size() - 1);
+	}
+
+	PhysicsWorldID getWorldByName(StringID name)
+	{
+		for (unsigned int i{ 0 }; i < worlds.size(); i++)
+		{
+			if (worlds[i]->name == name)
+				return i;
+		}
+		return INVALID_PHYSICS_WORLD;
+	}
+
+	StringID getWorldName(PhysicsWorldID world)
+	{
+		if (world >= worlds.size())
+			return EMPTY_STRING_ID;
+
+		return worlds[world]->name;
+	}
+
+	unsigned int getWorldCount()
+	{
+		return static_cast<unsigned int>(worlds.size());
+	}
+
+	PhysicsWorldID getBodyWorld(const b2Body* body)
+	{
+		for (unsigned int i{ 0 }; i < worlds.size(); i++)
+		{
+			if (&worlds[i]->world == body->GetWorld())
+				return i;
+		}
+		return INVALID_PHYSICS_WORLD;
+	}
+
+	b2Body* addBody(b2BodyDef* definition, PhysicsWorldID world)
+	{
+		if (world >= worlds.size())
+		{
+			Logger::logError("Physics world " + std::to_string(world) + " does not exist; adding the body to the default world instead.");
+			world = DEFAULT_PHYSICS_WORLD;
+		}
+
+		return worlds[world]->world.CreateBody(definition);
+	}
+
+	b2Body* moveBody(b2Body* body, PhysicsWorldID world)
+	{
+		if (world >= worlds.size())
+		{
+			Logger::logError("Cannot move body to physics world " + std::to_string(world) + "; the world does not exist.");
+			return nullptr;
+		}
+
+		PhysicsWorld* source{ findWorld(body->GetWorld()) };
+		PhysicsWorld& target{ *worlds[world] };
+
+		if (source == &target)
+			return body;
+
+		if (source->world.IsLocked() || target.world.IsLocked())
+		{
+			Logger::logError("Cannot move a body to another physics world while the physics worlds are stepping.");
+			return nullptr;
+		}
+
+		// Box2D cannot move bodies between worlds, so an identical body is created in the target world
+		b2BodyDef bodyDef;
+		bodyDef.type = body->GetType();
+		bodyDef.position = body->GetPosition();
+		bodyDef.angle = body->GetAngle();
+		bodyDef.linearVelocity = body->GetLinearVelocity();
+		bodyDef.angularVelocity = body->GetAngularVelocity();
+		bodyDef.linearDamping = body->GetLinearDamping();
+		bodyDef.angularDamping = body->GetAngularDamping();
+		bodyDef.allowSleep = body->IsSleepingAllowed();
+		bodyDef.awake = body->IsAwake();
+		bodyDef.fixedRotation = body->IsFixedRotation();
+		bodyDef.bullet = body->IsBullet();
+		bodyDef.enabled = body->IsEnabled();
+		bodyDef.userData = body->GetUserData();
+		bodyDef.gravityScale = body->GetGravityScale();
+
+		b2Body* movedBody{ target.world.CreateBody(&bodyDef) };
+
+		// Box2D lists the newest fixture first, so the fixtures are copied in reverse to keep their order
+		std::vector<b2Fixture*> fixtures;
+		for (b2Fixture* fixture{ body->GetFixtureList() }; fixture != nullptr; fixture = fixture->GetNext())
+		{
+			fixtures.push_back(fixture);
+		}
+
+		for (auto fixture{ fixtures.rbegin() }; fixture != fixtures.rend(); fixture++)
+		{
+			b2FixtureDef fixtureDef;
+			fixtureDef.shape = (*fixture)->GetShape();
+			fixtureDef.userData = (*fixture)->GetUserData();
+			fixtureDef.friction = (*fixture)->GetFriction();
+			fixtureDef.restitution = (*fixture)->GetRestitution();
+			fixtureDef.restitutionThreshold = (*fixture)->GetRestitutionThreshold();
+			fixtureDef.density = (*fixture)->GetDensity();
+			fixtureDef.isSensor = (*fixture)->IsSensor();
+			fixtureDef.filter = (*fixture)->GetFilterData();
+
+			b2Fixture* movedFixture{ movedBody->CreateFixture(&fixtureDef) };
+
+			FixtureData* fixtureData{ reinterpret_cast<FixtureData*>(fixtureDef.userData.pointer) };
+			if (fixtureData != nullptr)
+				fixtureData->mFixture = movedFixture;
+		}
+
+		// Ending the contacts in the old world, which are reported to the collision listeners
+		source->world.DestroyBody(body);
+
+		return movedBody;
 	}
 
 	bool destroyBody(b2Body* bodyToDestroy)
 	{
+		PhysicsWorld* physicsWorld{ findWorld(bodyToDestroy->GetWorld()) };
+
 		// If the world is not locked, we can destroy the body immediately
-		if (!world.IsLocked())
+		if (!physicsWorld->world.IsLocked())
 		{
-			world.DestroyBody(bodyToDestroy);
+			physicsWorld->world.DestroyBody(bodyToDestroy);
 			return true;
 		}
 		else
 		{
 			// Add it to the queue to be destroyed later
-			bodiesToDestroy.push_back(bodyToDestroy);
+			physicsWorld->bodiesToDestroy.push_back(bodyToDestroy);
 			return false;
 		}
 	}
@@ -170,8 +1331,10 @@ namespace PhysicsEngine
 			return true;
 		}
 
+		PhysicsWorld* physicsWorld{ findWorld(body->GetWorld()) };
+
 		// If the world is not locked, we can change the state immediately
-		if (!world.IsLocked())
+		if (!physicsWorld->world.IsLocked())
 		{
 			body->SetEnabled(flag);
 			return true;
@@ -179,7 +1342,7 @@ namespace PhysicsEngine
 		else
 		{
 			// Add it to the queue to be changed later
-			bodyEnabledStateChanges.emplace(body, flag);
+			physicsWorld->bodyEnabledStateChanges.emplace(body, flag);
 
 			// Body's state is changed later
 			return false;
@@ -194,8 +1357,10 @@ namespace PhysicsEngine
 			return true;
 		}
 
+		PhysicsWorld* physicsWorld{ findWorld(body->GetWorld()) };
+
 		// If the world is not locked, we can change the position immediately
-		if (!world.IsLocked())
+		if (!physicsWorld->world.IsLocked())
 		{
 			body->SetTransform(b2Vec2(position.x, position.y), body->GetAngle());
 			return true;
@@ -203,7 +1368,7 @@ namespace PhysicsEngine
 		else
 		{
 			// Add it to the queue to be changed later
-			bodyPositionChanges.emplace(body, position);
+			physicsWorld->bodyPositionChanges.emplace(body, position);
 
 			// Body's position is changed later
 			return false;
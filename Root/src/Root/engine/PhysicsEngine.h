@@ -3,8 +3,15 @@
 #include "Root/engine/RootEngine.h"
 
 #include <Root/CollisionCallbackHandler.h>
+#include <Root/PhysicsQuery.h>
+#include <Root/PhysicsProfile.h>
+#include <Root/PhysicsWorldID.h>
+#include <Root/RigidbodyHandle.h>
+#include <Root/StringID.h>
+#include <Root/engine/WorkerPool.h>
 
 #include <box2d/box2d.h>
+#include <box2d/b2_distance.h>
 
 #include <iostream>
 #include <ctime>
@@ -12,6 +19,7 @@
 #include <chrono>
 
 #include <queue>
+#include <algorithm>
 
 namespace PhysicsEngine
 {
@@ -27,6 +35,35 @@ namespace PhysicsEngine
 		glm::vec2 position;
 	};
 
+	/**
+	 * The number of bodies handled by the last rigidbody transform synchronisation.
+	 */
+	struct TransformSyncStats
+	{
+		// Bodies whose transform was written
+		unsigned int synced;
+		// Bodies that were skipped because they are static, asleep or disabled
+		unsigned int skippedInactive;
+		// Awake bodies that were skipped because they did not move
+		unsigned int skippedUnchanged;
+	};
+
+	/**
+	 * The number of rigidbodies handled by the last simulation LOD update.
+	 */
+	struct SimulationLODStats
+	{
+		// Rigidbodies with a simulation LOD that are being simulated
+		unsigned int active;
+		// Rigidbodies that are deactivated for being far from the camera
+		unsigned int inactive;
+		// Rigidbodies that were activated or deactivated in the last update
+		unsigned int activated;
+		unsigned int deactivated;
+		// Deactivated rigidbodies that a contact woke up, and that were put back to sleep
+		unsigned int reslept;
+	};
+
 	void initialise();
 
 	void simulate();
@@ -35,15 +72,224 @@ namespace PhysicsEngine
 
 	void renderDebugView();
 
+	/**
+	 * Write the position and rotation of every awake, moved body back to its rigidbody's transform.
+	 * Static, sleeping and disabled bodies are skipped, unless a rigidbody requested a synchronisation.
+	 */
+	void syncRigidbodyTransforms();
+
+	/**
+	 * Get the number of synchronised and skipped bodies of the last transform synchronisation.
+	 *
+	 * \returns the statistics of the last synchronisation.
+	 */
+	TransformSyncStats getTransformSyncStats();
+
+	/**
+	 * Set whether each physics step is measured and recorded into the profile history.
+	 * Off by default, since measuring a step walks every body and contact in every world.
+	 *
+	 * \param enabled: whether to profile the physics steps.
+	 */
+	void setProfilingEnabled(bool enabled);
+
+	/**
+	 * Get the measurements of the most recent physics steps.
+	 *
+	 * \returns the recorded steps, oldest first.
+	 */
+	std::vector<PhysicsStepProfile> getProfileHistory();
+
+	/**
+	 * Write the recorded physics steps to a JSON file, for viewing outside of the engine.
+	 *
+	 * \param path: the path of the file to write.
+	 * \returns whether the file was written.
+	 */
+	bool writeProfileHistory(const std::string& path);
+
+	/**
+	 * Add or remove a rigidbody from the rigidbodies whose simulation LOD is updated every step.
+	 *
+	 * \param rigidbody: the rigidbody to add or remove.
+	 * \param enabled: whether to add the rigidbody.
+	 */
+	void setSimulationLODEnabled(Rigidbody* rigidbody, bool enabled);
+
+	/**
+	 * Activate the rigidbodies that came close enough to the active camera,
+	 * and deactivate the ones that moved too far away.
+	 * Called at the start of every step.
+	 */
+	void updateSimulationLOD();
+
+	/**
+	 * Get the number of active and inactive rigidbodies of the last simulation LOD update.
+	 *
+	 * \returns the statistics of the last update.
+	 */
+	SimulationLODStats getSimulationLODStats();
+
 	void enableDebugMode();
 
 	void disableDebugMode();
 
+	/**
+	 * Set which categories the debug view draws.
+	 *
+	 * \param categories: the categories to draw, e.g. PHYSICS_DEBUG_SHAPES | PHYSICS_DEBUG_CONTACTS.
+	 */
+	void setDebugCategories(uint32 categories);
+
+	/**
+	 * Get which categories the debug view draws.
+	 *
+	 * \returns the categories that are drawn.
+	 */
+	uint32 getDebugCategories();
+
 	void setGravity(float x, float y);
 
 	void setCollisionListener(CollisionListener* contactListener);
 
-	b2Body* addBody(b2BodyDef* definition);
+	void addLayerCollisionListener(LayerMask layers, CollisionListener* listener);
+
+	bool removeLayerCollisionListener(CollisionListener* listener);
+
+	/**
+	 * Give one of the 16 layers a name.
+	 *
+	 * \param layerIndex: the index of the layer (0 for LAYER_0, up to 15).
+	 * \param name: the name of the layer.
+	 */
+	void setLayerName(unsigned int layerIndex, StringID name);
+
+	/**
+	 * Get the layer with a given name.
+	 *
+	 * \param name: the name of the layer.
+	 * \returns the layer mask of the layer with the given name, or 0 if no layer has the name.
+	 */
+	LayerMask getLayerByName(StringID name);
+
+	/**
+	 * Get the name of a layer.
+	 *
+	 * \param layerIndex: the index of the layer (0 for LAYER_0, up to 15).
+	 * \returns the name of the layer, or the empty string if it has no name.
+	 */
+	StringID getLayerName(unsigned int layerIndex);
+
+	/**
+	 * Set whether colliders on the given layers may collide with each other.
+	 * Applied symmetrically, and immediately to all existing colliders.
+	 *
+	 * \param layersA: the first layer(s).
+	 * \param layersB: the second layer(s).
+	 * \param collide: whether the layers collide.
+	 */
+	void setLayersCollide(LayerMask layersA, LayerMask layersB, bool collide);
+
+	/**
+	 * Get the layers which colliders on the given layers may collide with, according to the layer matrix.
+	 *
+	 * \param layers: the layer(s) to get the collision mask for.
+	 * \returns the layers which any of the given layers collide with.
+	 */
+	LayerMask getLayerCollisionMask(LayerMask layers);
+
+	/**
+	 * Create the Box2D filter for a fixture, combining its own masks with the layer matrix.
+	 *
+	 * \param selfLayerMask: the layer(s) the fixture is on.
+	 * \param interactionLayerMask: the layers the fixture wants to interact with.
+	 * \returns the filter to give the fixture.
+	 */
+	b2Filter createFilter(LayerMask selfLayerMask, LayerMask interactionLayerMask);
+
+	/**
+	 * Register a rigidbody so that handles can refer to it.
+	 *
+	 * \param rigidbody: the rigidbody to register.
+	 * \returns the handle of the rigidbody.
+	 */
+	RigidbodyHandle registerRigidbody(Rigidbody* rigidbody);
+
+	/**
+	 * Unregister a rigidbody, invalidating all handles to it.
+	 *
+	 * \param handle: the handle of the rigidbody.
+	 */
+	void unregisterRigidbody(RigidbodyHandle handle);
+
+	/**
+	 * Get the rigidbody a handle refers to.
+	 *
+	 * \param handle: the handle to resolve.
+	 * \returns the rigidbody, or nullptr if it was destroyed.
+	 */
+	Rigidbody* getRigidbody(RigidbodyHandle handle);
+
+	/**
+	 * Create a new, empty physics world.
+	 * Worlds are stepped in parallel, and their bodies never collide with bodies in other worlds.
+	 *
+	 * \param name: the name of the world.
+	 * \returns the ID of the new world, or INVALID_PHYSICS_WORLD if a world with the name already exists.
+	 */
+	PhysicsWorldID createWorld(StringID name);
+
+	/**
+	 * Get the world with a given name.
+	 *
+	 * \param name: the name of the world.
+	 * \returns the ID of the world, or INVALID_PHYSICS_WORLD if no world has the name.
+	 */
+	PhysicsWorldID getWorldByName(StringID name);
+
+	/**
+	 * Get the name of a world.
+	 *
+	 * \param world: the ID of the world.
+	 * \returns the name of the world, or the empty string if the world does not exist.
+	 */
+	StringID getWorldName(PhysicsWorldID world);
+
+	/**
+	 * Get the number of worlds, including the default world.
+	 *
+	 * \returns the number of worlds.
+	 */
+	unsigned int getWorldCount();
+
+	/**
+	 * Get the world a body is in.
+	 *
+	 * \param body: the body to get the world of.
+	 * \returns the ID of the world the body is in.
+	 */
+	PhysicsWorldID getBodyWorld(const b2Body* body);
+
+	/**
+	 * Add a body to a world.
+	 *
+	 * \param definition: the definition of the body.
+	 * \param world: the world to add the body to. If it does not exist, the default world is used.
+	 * \returns the new body.
+	 */
+	b2Body* addBody(b2BodyDef* definition, PhysicsWorldID world = DEFAULT_PHYSICS_WORLD);
+
+	/**
+	 * Move a body to another world, keeping its fixtures, velocity and user data.
+	 * The body is replaced by a new one: joints attached to it are destroyed,
+	 * and its contacts in the old world end.
+	 * Cannot be done while the worlds are stepping.
+	 *
+	 * \param body: the body to move. Is destroyed if the body was moved.
+	 * \param world: the world to move the body to.
+	 * \returns the body in the new world, or nullptr if the body could not be moved.
+	 */
+	b2Body* moveBody(b2Body* body, PhysicsWorldID world);
 
 	/**
 	 * Destroy a particular body.
@@ -72,6 +318,39 @@ namespace PhysicsEngine
 	 * or false if the body was put into queue for position changing.
 	 */
 	bool setBodyPosition(b2Body* body, glm::vec2 position);
+
+	bool raycast(glm::vec2 origin, glm::vec2 end, RaycastHit& hit, LayerMask layerMask);
+
+	std::vector<RaycastHit> raycastAll(glm::vec2 origin, glm::vec2 end, LayerMask layerMask);
+
+	std::vector<Rigidbody*> overlapAABB(glm::vec2 min, glm::vec2 max, LayerMask layerMask);
+
+	std::vector<Rigidbody*> overlapCircle(glm::vec2 center, float radius, LayerMask layerMask);
+
+	bool shapeCast(const b2Shape& shape,
+		glm::vec2 position,
+		float rotation,
+		glm::vec2 translation,
+		ShapeCastHit& hit,
+		LayerMask layerMask);
+
+	/**
+	 * Run many raycasts at once, spread over the worker threads.
+	 * Falls back to the calling thread if the world is locked (e.g. inside a collision callback).
+	 *
+	 * \param queries: the raycasts to run.
+	 * \param results: will be resized to hold one result per query, in the same order.
+	 */
+	void raycastBatch(const std::vector<RaycastQuery>& queries, std::vector<RaycastResult>& results);
+
+	/**
+	 * Run many circle overlap tests at once, spread over the worker threads.
+	 * Falls back to the calling thread if the world is locked (e.g. inside a collision callback).
+	 *
+	 * \param queries: the overlap tests to run.
+	 * \param results: will be resized to hold one result per query, in the same order.
+	 */
+	void overlapCircleBatch(const std::vector<OverlapCircleQuery>& queries, std::vector<OverlapResult>& results);
 };
 
 
@@ -179,6 +179,8 @@ namespace RendererEngine
 
     void displayFrame()
     {
+        PROFILE_GPU_ZONE("Display frame");
+
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
         // Clearing the screen
@@ -209,10 +211,15 @@ namespace RendererEngine
 
     void runScreenSpaceEffects()
     {
+        PROFILE_FUNCTION();
+
         for (ScreenSpaceEffectPointer& screenSpaceEffect : screenSpaceEffects)
         {
-            if (screenSpaceEffect->isEnabled())
-                runScreenSpaceEffect(screenSpaceEffect);
+            if (!screenSpaceEffect->isEnabled())
+                continue;
+
+            PROFILE_GPU_ZONE("Screen space effect");
+            runScreenSpaceEffect(screenSpaceEffect);
         }
 
         Profiler::addCheckpoint("Screen space effects");
@@ -11,11 +11,15 @@ namespace RootEngine
         unsigned int WINDOW_SIZE_X, WINDOW_SIZE_Y;
 
         std::vector<std::shared_ptr<Transform>> transforms;
+        // Lookup of all transforms in the scene by their tag
+        std::unordered_map<StringID, std::vector<Transform*>> transformsByTag;
+        const std::vector<Transform*> noTransforms{};
         std::vector<std::shared_ptr<Script>> scripts;
 
         Shader* spriteRenderShader;
         Shader* particleRenderShader;
         Shader* debugRenderShader;
+        Shader* physicsDebugRenderShader;
         Shader* tileRenderShader;
 
         Camera* activeCamera{ nullptr };
@@ -23,6 +27,25 @@ namespace RootEngine
 
         bool physicsSimulationActive{ true };
 
+        void removeFromTagLookup(Transform* transform, StringID tagID)
+        {
+            auto iterator{ transformsByTag.find(tagID) };
+            if (iterator == transformsByTag.end())
+                return;
+
+            std::vector<Transform*>& tagged{ iterator->second };
+            for (unsigned int i{ 0 }; i < tagged.size(); i++)
+            {
+                if (tagged[i] == transform)
+                {
+                    // Order does not matter, so swapping with the last one is enough
+                    tagged[i] = tagged.back();
+                    tagged.pop_back();
+                    break;
+                }
+            }
+        }
+
         void initialiseGLFW()
         {
             // Initialising GLFW
@@ -88,6 +111,10 @@ namespace RootEngine
             "include/Root/default_shader_source/debugVertex.shader",
             "include/Root/default_shader_source/debugFragment.shader");
 
+        physicsDebugRenderShader = new Shader(
+            "include/Root/default_shader_source/physicsDebugVertex.shader",
+            "include/Root/default_shader_source/physicsDebugFragment.shader");
+
         particleRenderShader = new Shader(
             "include/Root/default_shader_source/particleVertex.shader",
             "include/Root/default_shader_source/particleFragment.shader",
@@ -104,6 +131,8 @@ namespace RootEngine
         // makes sure objects get drawn on top of each other in the correct order
         glEnable(GL_DEPTH_TEST);
 
+        WorkerPool::initialise();
+
         AudioEngine::initialise();
 
         RendererEngine::initialise(WINDOW_SIZE_X, WINDOW_SIZE_Y);
@@ -120,10 +149,18 @@ namespace RootEngine
 
         while (!glfwWindowShouldClose(window))
         {
+            // Collecting the zones of the previous frame, before any thread starts recording new ones
+            PROFILE_END_GPU_FRAME();
+            PROFILE_END_FRAME();
+            PROFILE_ZONE("Frame");
+
             Profiler::addCheckpoint("Start of frame");
 
+            // Updating the input engine, which gives the recorded frame time when replaying input
+            InputEngine::update(glfwGetTime());
+
             // Updating the variables in Time
-            Time::update(glfwGetTime());
+            Time::update(static_cast<float>(InputEngine::getFrameTime()));
 
             // Getting viewport size
             glfwGetWindowSize(window, (int*)&WINDOW_SIZE_X, (int*)&WINDOW_SIZE_Y);
@@ -133,9 +170,6 @@ namespace RootEngine
             // Setting viewport size
             glViewport(0, 0, WINDOW_SIZE_X, WINDOW_SIZE_Y);
 
-            // Updating the input engine
-            InputEngine::update();
-
             RootGUIInternal::update(InputEngine::getMouseNormalizedScreenPosition(), InputEngine::getMouseButton(MOUSE_LEFT));
 
             // Calling all component and script start() and update() functions
@@ -149,8 +183,6 @@ namespace RootEngine
 
             ComponentEngine::updateRigidbodiesTransforms();
 
-            TileGridEngine::update();
-
             // Input
             //processInput(window);
 
@@ -167,8 +199,17 @@ namespace RootEngine
             glEnable(GL_DEPTH_TEST);
             glDepthFunc(GL_LEQUAL);
 
+            // Sprite sheet and tile animations are played by their shaders, based on the time of the frame
+            spriteRenderShader->use();
+            spriteRenderShader->setFloat("time", Time::getScaledTime());
+            tileRenderShader->use();
+            tileRenderShader->setFloat("time", Time::getScaledTime());
+
             // Calling all component render() functions
-            ComponentEngine::renderComponents();
+            {
+                PROFILE_GPU_ZONE("Scene render");
+                ComponentEngine::renderComponents();
+            }
 
             RendererEngine::runScreenSpaceEffects();
 
@@ -204,8 +245,12 @@ namespace RootEngine
 
         RendererEngine::terminate();
 
+        Profiler::terminateGPUZones();
+
         AudioEngine::terminate();
 
+        WorkerPool::terminate();
+
         Logger::stop();
 
         glfwTerminate();
@@ -223,6 +268,11 @@ namespace RootEngine
         return debugRenderShader;
     }
 
+    Shader* getPhysicsDebugRenderShader()
+    {
+        return physicsDebugRenderShader;
+    }
+
     Shader* getParticleRenderShader()
     {
         return particleRenderShader;
@@ -247,6 +297,7 @@ namespace RootEngine
     void addTransform(std::shared_ptr<Transform> transform)
     {
         transforms.push_back(transform);
+        transformsByTag[transform->getTagID()].push_back(transform.get());
     }
 
     void removeTransform(Transform* transformToRemove)
@@ -255,6 +306,7 @@ namespace RootEngine
         {
             if (transforms[i].get() == transformToRemove)
             {
+                removeFromTagLookup(transformToRemove, transformToRemove->getTagID());
                 transforms.erase(transforms.begin() + i);
                 return;
             }
@@ -268,17 +320,36 @@ namespace RootEngine
 
     TransformPointer getTransformByName(std::string& name)
     {
-        // Comparing each transform's name with the input name
+        // A name that was never interned cannot belong to any transform
+        StringID nameID{ StringInterner::find(name) };
+        if (nameID == INVALID_STRING_ID)
+            return nullptr;
+
+        // Comparing each transform's name ID with the input name ID
         for (std::shared_ptr<Transform>& transform : transforms)
         {
             // If it matches, return its pointer
-            if (transform->getName() == name)
+            if (transform->getNameID() == nameID)
                 return transform.get();
         }
-        // If no transform was found with teh given name, return a nullptr
+        // If no transform was found with the given name, return a nullptr
         return nullptr;
     }
 
+    const std::vector<Transform*>& getTransformsWithTag(StringID tagID)
+    {
+        auto iterator{ transformsByTag.find(tagID) };
+        if (iterator == transformsByTag.end())
+            return noTransforms;
+        return iterator->second;
+    }
+
+    void updateTransformTag(Transform* transform, StringID oldTagID, StringID newTagID)
+    {
+        removeFromTagLookup(transform, oldTagID);
+        transformsByTag[newTagID].push_back(transform);
+    }
+
     void setActiveCamera(Camera* camera)
     {
         activeCamera = camera;
@@ -313,6 +384,7 @@ namespace RootEngine
             transform->removeAllChildren();
         }
         transforms.clear();
+        transformsByTag.clear();
     }
 
     bool isPhysicsSimulationActive()
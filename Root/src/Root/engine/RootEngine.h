@@ -14,6 +14,7 @@
 #include "Root/shaders/Shader.h"
 
 #include "Root/Time.h"
+#include "Root/StringID.h"
 #include "Root/engine/RendererEngine.h"
 #include "simpleprofiler/Profiler.h"
 
@@ -27,6 +28,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <thread>
+#include <unordered_map>
 
 
 // ImGui
@@ -76,6 +78,13 @@ namespace RootEngine
 	 */
 	Shader* getDebugRenderShader();
 
+	/**
+	 * Get a pointer to the shader used for the physics debug view.
+	 *
+	 * \returns a pointer to the shader used for the physics debug view.
+	 */
+	Shader* getPhysicsDebugRenderShader();
+
 	/**
 	 * Get a pointer to the shader used for particle rendering.
 	 *
@@ -133,6 +142,24 @@ namespace RootEngine
 	 */
 	TransformPointer getTransformByName(std::string& name);
 
+	/**
+	 * Get all transforms with the given tag ID.
+	 *
+	 * \param tagID: the interned ID of the tag to look for.
+	 * \returns the transforms with the given tag.
+	 */
+	const std::vector<Transform*>& getTransformsWithTag(StringID tagID);
+
+	/**
+	 * Move a transform to a different tag in the tag lookup.
+	 * Should not be called by the user, Transform::setTag() does this.
+	 *
+	 * \param transform: the transform which changed its tag.
+	 * \param oldTagID: the ID of the tag it had.
+	 * \param newTagID: the ID of the tag it has now.
+	 */
+	void updateTransformTag(Transform* transform, StringID oldTagID, StringID newTagID);
+
 	/**
 	 * Set a camera as the one used for all rendering.
 	 *
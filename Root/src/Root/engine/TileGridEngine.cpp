@@ -4,31 +4,27 @@ namespace TileGridEngine
 {
     namespace
     {
-        std::map<std::string, std::shared_ptr<TileSet>> tileSets;
+        std::unordered_map<StringID, std::shared_ptr<TileSet>> tileSets;
     }
 
-	void update()
-	{
-		// Create a map iterator and point to beginning of map
-		std::map<std::string, std::shared_ptr<TileSet>>::iterator it = tileSets.begin();
-
-		// Iterate over the map using Iterator till end
-		while (it != tileSets.end())
-		{
-			it->second->update();
-			// Increment the Iterator to point to next entry
-			it++;
-		}
-	}
-
     void addTileSet(std::shared_ptr<TileSet> tileSet, const std::string& name)
+    {
+        addTileSet(tileSet, StringInterner::intern(name));
+    }
+
+    void addTileSet(std::shared_ptr<TileSet> tileSet, StringID name)
     {
         tileSets.emplace(name, tileSet);
     }
 
 	TileSet* getTileSet(const std::string& name)
 	{
-		std::map<std::string, std::shared_ptr<TileSet>>::iterator it = tileSets.find(name);
+		return getTileSet(StringInterner::find(name));
+	}
+
+	TileSet* getTileSet(StringID name)
+	{
+		std::unordered_map<StringID, std::shared_ptr<TileSet>>::iterator it = tileSets.find(name);
 
 		if (it != tileSets.end())
 		{
@@ -1,19 +1,22 @@
 #pragma once
 
 #include <Root/tilegrids/TileSet.h>
+#include <Root/StringID.h>
 
 #include <memory>
 #include <string>
-#include <map>
+#include <unordered_map>
 
 namespace TileGridEngine
 {
-	void update();
-
 	void addTileSet(std::shared_ptr<TileSet> tileSet, const std::string& name);
 
+	void addTileSet(std::shared_ptr<TileSet> tileSet, StringID name);
+
 	TileSet* getTileSet(const std::string& name);
 
+	TileSet* getTileSet(StringID name);
+
 	bool isNumber(char c);
 
 	unsigned int readNumber(std::ifstream* file, char first);
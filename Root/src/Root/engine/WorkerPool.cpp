@@ -0,0 +1,148 @@
+#include "WorkerPool.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+namespace WorkerPool
+{
+	namespace
+	{
+		std::vector<std::thread> threads;
+
+		std::mutex mutex;
+		std::condition_variable jobAvailable;
+		std::condition_variable jobFinished;
+
+		// Only one job can be running at a time
+		std::mutex submitMutex;
+
+		const std::function<void(unsigned int, unsigned int)>* currentJob{ nullptr };
+		unsigned int jobCount{ 0 };
+		unsigned int jobBatchSize{ 1 };
+		std::atomic<unsigned int> nextIndex{ 0 };
+
+		// Incremented for every job, so that workers can tell a new job apart from a spurious wake-up
+		unsigned int generation{ 0 };
+		unsigned int finishedWorkers{ 0 };
+		bool stopping{ false };
+
+		void runBatches()
+		{
+			while (true)
+			{
+				unsigned int begin{ nextIndex.fetch_add(jobBatchSize) };
+				if (begin >= jobCount)
+					return;
+
+				(*currentJob)(begin, std::min(begin + jobBatchSize, jobCount));
+			}
+		}
+
+		void workerLoop()
+		{
+			unsigned int seenGeneration{ 0 };
+
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock{ mutex };
+					jobAvailable.wait(lock, [&] { return stopping || generation != seenGeneration; });
+
+					if (stopping)
+						return;
+
+					seenGeneration = generation;
+				}
+
+				runBatches();
+
+				{
+					std::lock_guard<std::mutex> lock{ mutex };
+					finishedWorkers++;
+					if (finishedWorkers == threads.size())
+						jobFinished.notify_one();
+				}
+			}
+		}
+	}
+
+	void initialise(unsigned int threadCount)
+	{
+		if (!threads.empty())
+			return;
+
+		if (threadCount == 0)
+		{
+			unsigned int hardwareThreads{ std::thread::hardware_concurrency() };
+			threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		stopping = false;
+		for (unsigned int i{ 0 }; i < threadCount; i++)
+		{
+			threads.emplace_back(workerLoop);
+		}
+	}
+
+	void terminate()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			stopping = true;
+		}
+		jobAvailable.notify_all();
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		threads.clear();
+	}
+
+	unsigned int getThreadCount()
+	{
+		return static_cast<unsigned int>(threads.size());
+	}
+
+	void parallelFor(unsigned int count,
+		unsigned int batchSize,
+		const std::function<void(unsigned int begin, unsigned int end)>& job)
+	{
+		if (count == 0)
+			return;
+
+		batchSize = std::max(batchSize, 1u);
+
+		// Not worth waking the workers for
+		if (threads.empty() || count <= batchSize)
+		{
+			job(0, count);
+			return;
+		}
+
+		std::lock_guard<std::mutex> submitLock{ submitMutex };
+
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			currentJob = &job;
+			jobCount = count;
+			jobBatchSize = batchSize;
+			nextIndex = 0;
+			finishedWorkers = 0;
+			generation++;
+		}
+		jobAvailable.notify_all();
+
+		// The calling thread helps out instead of waiting idly
+		runBatches();
+
+		// Every worker must be done with this job before its state can be reused
+		std::unique_lock<std::mutex> lock{ mutex };
+		jobFinished.wait(lock, [] { return finishedWorkers == threads.size(); });
+		currentJob = nullptr;
+	}
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <functional>
+
+namespace WorkerPool
+{
+	/**
+	 * Start the worker threads.
+	 *
+	 * \param threadCount: the number of worker threads to start.
+	 * If this is 0, one thread less than the number of hardware threads is used,
+	 * since the calling thread also takes part in the work.
+	 */
+	void initialise(unsigned int threadCount = 0);
+
+	/**
+	 * Stop and join all worker threads.
+	 */
+	void terminate();
+
+	/**
+	 * Get the number of worker threads, not including the calling thread.
+	 *
+	 * \returns the number of worker threads.
+	 */
+	unsigned int getThreadCount();
+
+	/**
+	 * Run a job over the range [0, count) on the worker threads and the calling thread.
+	 * The range is handed out in batches, so the job is called with sub-ranges [begin, end).
+	 * Blocks until the whole range is done.
+	 * If the pool was not initialised, or the range fits in one batch,
+	 * the job is run on the calling thread.
+	 * Must not be called from within a job.
+	 *
+	 * \param count: the number of items to process.
+	 * \param batchSize: the number of items handed to a thread at a time.
+	 * \param job: the function to call for each batch.
+	 */
+	void parallelFor(unsigned int count,
+		unsigned int batchSize,
+		const std::function<void(unsigned int begin, unsigned int end)>& job);
+};
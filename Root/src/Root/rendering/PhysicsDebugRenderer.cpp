@@ -0,0 +1,380 @@
+#include "PhysicsDebugRenderer.h"
+
+#include <box2d/b2_body.h>
+#include <box2d/b2_fixture.h>
+#include <box2d/b2_contact.h>
+#include <box2d/b2_circle_shape.h>
+#include <box2d/b2_edge_shape.h>
+#include <box2d/b2_polygon_shape.h>
+#include <box2d/b2_chain_shape.h>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace
+{
+	// The number of segments used to draw a circle
+	const int32 circleSegments{ 16 };
+
+	// Collects the fixture proxies that overlap the view, straight from the broad-phase,
+	// so that only the visible edges of a chain shape are drawn instead of the whole chain
+	class ViewQueryCallback
+	{
+	public:
+
+		ViewQueryCallback(const b2BroadPhase& broadPhase, std::vector<b2FixtureProxy*>& proxies)
+			: broadPhase(broadPhase)
+			, proxies(proxies) { }
+
+		bool QueryCallback(int32 proxyId)
+		{
+			proxies.push_back(static_cast<b2FixtureProxy*>(broadPhase.GetUserData(proxyId)));
+			return true;
+		}
+
+	private:
+
+		const b2BroadPhase& broadPhase;
+		std::vector<b2FixtureProxy*>& proxies;
+	};
+
+	bool isInView(const b2AABB& viewBounds, const b2Vec2& point)
+	{
+		return point.x >= viewBounds.lowerBound.x && point.x <= viewBounds.upperBound.x
+			&& point.y >= viewBounds.lowerBound.y && point.y <= viewBounds.upperBound.y;
+	}
+}
+
+PhysicsDebugRenderer::PhysicsDebugRenderer()
+{
+	SetFlags(PHYSICS_DEBUG_SHAPES);
+}
+
+PhysicsDebugRenderer::~PhysicsDebugRenderer()
+{
+	glDeleteBuffers(1, &VBO);
+	glDeleteVertexArrays(1, &VAO);
+}
+
+void PhysicsDebugRenderer::collect(b2World& world, const b2AABB& viewBounds, float pixelSize)
+{
+	this->pixelSize = pixelSize;
+
+	uint32 flags{ GetFlags() };
+
+	// Finding everything that overlaps the view
+	std::vector<b2FixtureProxy*> proxies;
+	const b2BroadPhase& broadPhase{ world.GetContactManager().m_broadPhase };
+	ViewQueryCallback callback{ broadPhase, proxies };
+	broadPhase.Query(&callback, viewBounds);
+
+	visibleBodies.clear();
+
+	for (b2FixtureProxy* proxy : proxies)
+	{
+		b2Body* body{ proxy->fixture->GetBody() };
+
+		if (flags & PHYSICS_DEBUG_SHAPES)
+		{
+			drawFixtureChild(proxy->fixture, proxy->childIndex, getBodyColor(body));
+		}
+
+		if (flags & PHYSICS_DEBUG_AABBS)
+		{
+			const b2AABB& aabb{ proxy->aabb };
+			b2Vec2 vertices[4]{
+				aabb.lowerBound,
+				b2Vec2(aabb.upperBound.x, aabb.lowerBound.y),
+				aabb.upperBound,
+				b2Vec2(aabb.lowerBound.x, aabb.upperBound.y)
+			};
+			DrawPolygon(vertices, 4, b2Color(0.9f, 0.3f, 0.9f));
+		}
+
+		if (flags & PHYSICS_DEBUG_CENTERS_OF_MASS)
+		{
+			visibleBodies.push_back(body);
+		}
+	}
+
+	if (flags & PHYSICS_DEBUG_CENTERS_OF_MASS)
+	{
+		// A body with several fixtures in view is only drawn once
+		std::sort(visibleBodies.begin(), visibleBodies.end());
+		visibleBodies.erase(std::unique(visibleBodies.begin(), visibleBodies.end()), visibleBodies.end());
+
+		for (b2Body* body : visibleBodies)
+		{
+			b2Transform transform{ body->GetTransform() };
+			transform.p = body->GetWorldCenter();
+			DrawTransform(transform);
+		}
+	}
+
+	if (flags & PHYSICS_DEBUG_CONTACTS)
+	{
+		for (b2Contact* contact{ world.GetContactList() }; contact != nullptr; contact = contact->GetNext())
+		{
+			if (!contact->IsTouching())
+				continue;
+
+			b2WorldManifold worldManifold;
+			contact->GetWorldManifold(&worldManifold);
+
+			for (int32 i{ 0 }; i < contact->GetManifold()->pointCount; i++)
+			{
+				const b2Vec2& point{ worldManifold.points[i] };
+
+				if (!isInView(viewBounds, point))
+					continue;
+
+				DrawPoint(point, 6.0f, b2Color(1.0f, 0.2f, 0.2f));
+				DrawSegment(point, point + 20.0f * pixelSize * worldManifold.normal, b2Color(1.0f, 0.9f, 0.2f));
+			}
+		}
+	}
+
+	if (flags & PHYSICS_DEBUG_JOINTS)
+	{
+		// Letting Box2D draw the joints, since there are few of them
+		SetFlags(e_jointBit);
+		world.SetDebugDraw(this);
+		world.DebugDraw();
+		world.SetDebugDraw(nullptr);
+		SetFlags(flags);
+	}
+}
+
+void PhysicsDebugRenderer::render(Shader* shader, const glm::mat4& view, const glm::mat4& projection)
+{
+	unsigned int triangleCount{ static_cast<unsigned int>(triangleVertices.size()) };
+	unsigned int lineCount{ static_cast<unsigned int>(lineVertices.size()) };
+
+	lastVertexCount = triangleCount + lineCount;
+
+	if (lastVertexCount == 0)
+		return;
+
+	if (VAO == 0)
+	{
+		generateVAO();
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+	// Growing the buffer if needed, otherwise orphaning it so the driver does not have to wait for the last frame
+	if (lastVertexCount > bufferCapacity)
+	{
+		bufferCapacity = std::max(lastVertexCount, bufferCapacity * 2);
+	}
+	glBufferData(GL_ARRAY_BUFFER, bufferCapacity * sizeof(DebugVertex), nullptr, GL_STREAM_DRAW);
+
+	// Triangles first, then lines, so they are drawn on top
+	glBufferSubData(GL_ARRAY_BUFFER, 0, triangleCount * sizeof(DebugVertex), triangleVertices.data());
+	glBufferSubData(GL_ARRAY_BUFFER, triangleCount * sizeof(DebugVertex), lineCount * sizeof(DebugVertex), lineVertices.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	shader->use();
+	shader->setMat4("view", view);
+	shader->setMat4("projection", projection);
+
+	glBindVertexArray(VAO);
+
+	if (triangleCount > 0)
+	{
+		glDrawArrays(GL_TRIANGLES, 0, triangleCount);
+	}
+	glDrawArrays(GL_LINES, triangleCount, lineCount);
+
+	glBindVertexArray(0);
+
+	triangleVertices.clear();
+	lineVertices.clear();
+}
+
+unsigned int PhysicsDebugRenderer::getLastVertexCount() const
+{
+	return lastVertexCount;
+}
+
+void PhysicsDebugRenderer::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
+{
+	for (int32 i{ 0 }; i < vertexCount; i++)
+	{
+		addLine(vertices[i], vertices[(i + 1) % vertexCount], color);
+	}
+}
+
+void PhysicsDebugRenderer::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
+{
+	// The polygon is convex, so it can be filled with a triangle fan
+	glm::vec4 fillColor{ 0.5f * color.r, 0.5f * color.g, 0.5f * color.b, 0.5f };
+
+	for (int32 i{ 1 }; i < vertexCount - 1; i++)
+	{
+		triangleVertices.push_back({ glm::vec2(vertices[0].x, vertices[0].y), fillColor });
+		triangleVertices.push_back({ glm::vec2(vertices[i].x, vertices[i].y), fillColor });
+		triangleVertices.push_back({ glm::vec2(vertices[i + 1].x, vertices[i + 1].y), fillColor });
+	}
+
+	DrawPolygon(vertices, vertexCount, color);
+}
+
+void PhysicsDebugRenderer::DrawCircle(const b2Vec2& center, float radius, const b2Color& color)
+{
+	b2Vec2 previous{ center + b2Vec2(radius, 0.0f) };
+
+	for (int32 i{ 1 }; i <= circleSegments; i++)
+	{
+		float angle{ (float)i / (float)circleSegments * 2.0f * b2_pi };
+		b2Vec2 next{ center + radius * b2Vec2(cosf(angle), sinf(angle)) };
+
+		addLine(previous, next, color);
+		previous = next;
+	}
+}
+
+void PhysicsDebugRenderer::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color)
+{
+	glm::vec4 fillColor{ 0.5f * color.r, 0.5f * color.g, 0.5f * color.b, 0.5f };
+	glm::vec2 glmCenter{ center.x, center.y };
+
+	glm::vec2 previous{ glmCenter + glm::vec2(radius, 0.0f) };
+
+	for (int32 i{ 1 }; i <= circleSegments; i++)
+	{
+		float angle{ (float)i / (float)circleSegments * 2.0f * b2_pi };
+		glm::vec2 next{ glmCenter + radius * glm::vec2(cosf(angle), sinf(angle)) };
+
+		triangleVertices.push_back({ glmCenter, fillColor });
+		triangleVertices.push_back({ previous, fillColor });
+		triangleVertices.push_back({ next, fillColor });
+		previous = next;
+	}
+
+	DrawCircle(center, radius, color);
+
+	// Showing the rotation
+	addLine(center, center + radius * axis, color);
+}
+
+void PhysicsDebugRenderer::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
+{
+	addLine(p1, p2, color);
+}
+
+void PhysicsDebugRenderer::DrawTransform(const b2Transform& xf)
+{
+	float axisLength{ 20.0f * pixelSize };
+
+	addLine(xf.p, xf.p + axisLength * xf.q.GetXAxis(), b2Color(1.0f, 0.0f, 0.0f));
+	addLine(xf.p, xf.p + axisLength * xf.q.GetYAxis(), b2Color(0.0f, 1.0f, 0.0f));
+}
+
+void PhysicsDebugRenderer::DrawPoint(const b2Vec2& p, float size, const b2Color& color)
+{
+	// Points are drawn as a small cross, so they can go in the same buffer as the lines
+	float halfSize{ 0.5f * size * pixelSize };
+
+	addLine(p - b2Vec2(halfSize, halfSize), p + b2Vec2(halfSize, halfSize), color);
+	addLine(p - b2Vec2(halfSize, -halfSize), p + b2Vec2(halfSize, -halfSize), color);
+}
+
+void PhysicsDebugRenderer::addLine(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
+{
+	glm::vec4 lineColor{ color.r, color.g, color.b, color.a };
+
+	lineVertices.push_back({ glm::vec2(p1.x, p1.y), lineColor });
+	lineVertices.push_back({ glm::vec2(p2.x, p2.y), lineColor });
+}
+
+void PhysicsDebugRenderer::drawFixtureChild(b2Fixture* fixture, int32 childIndex, const b2Color& color)
+{
+	const b2Transform& transform{ fixture->GetBody()->GetTransform() };
+
+	switch (fixture->GetType())
+	{
+		case b2Shape::e_circle:
+		{
+			b2CircleShape* circle{ static_cast<b2CircleShape*>(fixture->GetShape()) };
+
+			DrawSolidCircle(b2Mul(transform, circle->m_p), circle->m_radius, transform.q.GetXAxis(), color);
+			break;
+		}
+
+		case b2Shape::e_edge:
+		{
+			b2EdgeShape* edge{ static_cast<b2EdgeShape*>(fixture->GetShape()) };
+
+			DrawSegment(b2Mul(transform, edge->m_vertex1), b2Mul(transform, edge->m_vertex2), color);
+			break;
+		}
+
+		case b2Shape::e_chain:
+		{
+			// Each edge of a chain has its own proxy, so only the edge in view is drawn
+			b2ChainShape* chain{ static_cast<b2ChainShape*>(fixture->GetShape()) };
+
+			b2EdgeShape edge;
+			chain->GetChildEdge(&edge, childIndex);
+
+			DrawSegment(b2Mul(transform, edge.m_vertex1), b2Mul(transform, edge.m_vertex2), color);
+			break;
+		}
+
+		case b2Shape::e_polygon:
+		{
+			b2PolygonShape* polygon{ static_cast<b2PolygonShape*>(fixture->GetShape()) };
+
+			b2Vec2 vertices[b2_maxPolygonVertices];
+			for (int32 i{ 0 }; i < polygon->m_count; i++)
+			{
+				vertices[i] = b2Mul(transform, polygon->m_vertices[i]);
+			}
+
+			DrawSolidPolygon(vertices, polygon->m_count, color);
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+b2Color PhysicsDebugRenderer::getBodyColor(b2Body* body)
+{
+	// The same colors Box2D uses in its own debug drawing
+	if (body->GetType() == b2_staticBody)
+		return b2Color(0.5f, 0.9f, 0.5f);
+
+	if (body->GetType() == b2_kinematicBody)
+		return b2Color(0.5f, 0.5f, 0.9f);
+
+	if (!body->IsAwake())
+		return b2Color(0.6f, 0.6f, 0.6f);
+
+	return b2Color(0.9f, 0.7f, 0.7f);
+}
+
+void PhysicsDebugRenderer::generateVAO()
+{
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+	// Letting OpenGL know how to interpret the data:
+	// 2 floats for position
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, position));
+	glEnableVertexAttribArray(0);
+	// 4 floats for color
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, color));
+	glEnableVertexAttribArray(1);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Root/shaders/Shader.h"
+
+#include <box2d/b2_draw.h>
+#include <box2d/b2_world.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/**
+ * The categories of the physics debug view, which can be combined with |
+ * E.g. PHYSICS_DEBUG_SHAPES | PHYSICS_DEBUG_CONTACTS
+ */
+#define PHYSICS_DEBUG_SHAPES			0x0001
+#define PHYSICS_DEBUG_JOINTS			0x0002
+#define PHYSICS_DEBUG_AABBS				0x0004
+#define PHYSICS_DEBUG_CENTERS_OF_MASS	0x0010
+#define PHYSICS_DEBUG_CONTACTS			0x0100
+#define PHYSICS_DEBUG_ALL				0x0117
+
+/**
+ * Draws the physics world for debugging.
+ * All lines, shapes and points of a frame are collected in one vertex buffer,
+ * which is uploaded and drawn at once: one draw call for the filled shapes and one for the lines.
+ */
+class PhysicsDebugRenderer : public b2Draw
+{
+public:
+
+	PhysicsDebugRenderer();
+
+	~PhysicsDebugRenderer();
+
+	/**
+	 * Collect everything in the world that lies within the view bounds.
+	 * Only the shapes, or parts of chain shapes, that overlap the view are drawn.
+	 *
+	 * \param world: the world to draw.
+	 * \param viewBounds: the area of the world that is visible.
+	 * \param pixelSize: the size of one pixel in world units, used for the size of points.
+	 */
+	void collect(b2World& world, const b2AABB& viewBounds, float pixelSize);
+
+	/**
+	 * Draw everything that was collected since the last call, and clear it.
+	 *
+	 * \param shader: the shader to draw with.
+	 * \param view: the view matrix of the camera.
+	 * \param projection: the projection matrix of the camera.
+	 */
+	void render(Shader* shader, const glm::mat4& view, const glm::mat4& projection);
+
+	/**
+	 * Get the number of vertices drawn in the last call to render().
+	 *
+	 * \returns the number of vertices.
+	 */
+	unsigned int getLastVertexCount() const;
+
+	void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+
+	void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+
+	void DrawCircle(const b2Vec2& center, float radius, const b2Color& color) override;
+
+	void DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color) override;
+
+	void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) override;
+
+	void DrawTransform(const b2Transform& xf) override;
+
+	void DrawPoint(const b2Vec2& p, float size, const b2Color& color) override;
+
+private:
+
+	struct DebugVertex
+	{
+		glm::vec2 position;
+		glm::vec4 color;
+	};
+
+	void addLine(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color);
+
+	void drawFixtureChild(b2Fixture* fixture, int32 childIndex, const b2Color& color);
+
+	b2Color getBodyColor(b2Body* body);
+
+	void generateVAO();
+
+	// Drawn as GL_LINES
+	std::vector<DebugVertex> lineVertices;
+	// Drawn as GL_TRIANGLES
+	std::vector<DebugVertex> triangleVertices;
+
+	// The bodies that had a fixture in view, for drawing the centres of mass
+	std::vector<b2Body*> visibleBodies;
+
+	unsigned int VAO{ 0 };
+	unsigned int VBO{ 0 };
+	// The number of vertices that fit in the vertex buffer
+	unsigned int bufferCapacity{ 0 };
+
+	unsigned int lastVertexCount{ 0 };
+
+	// The size of one pixel in world units
+	float pixelSize{ 0.01f };
+};
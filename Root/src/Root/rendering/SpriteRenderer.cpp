@@ -1,6 +1,10 @@
 #include "SpriteRenderer.h"
 
 #include <Root/engine/TextureEngine.h>
+#include <Root/Time.h>
+
+#include <algorithm>
+#include <cmath>
 
 SpriteRenderer::SpriteRenderer(unsigned int columnCount, unsigned int rowCount,
 	glm::vec2 offset, glm::vec2 size)
@@ -60,6 +64,16 @@ void SpriteRenderer::render(float renderDepth)
 	spriteRenderShader->setInt("columnIndex", columnIndex);
 	spriteRenderShader->setInt("rowIndex", rowIndex);
 
+	// The shader picks the frame of the animation itself, from the time set once per frame
+	spriteRenderShader->setInt("animationFrameCount", animationPlaying ? animationClip.frameCount : 0);
+	if (animationPlaying)
+	{
+		spriteRenderShader->setInt("animationStartCell", animationClip.startCell.y * columnCount + animationClip.startCell.x);
+		spriteRenderShader->setFloat("animationFramesPerSecond", animationClip.framesPerSecond);
+		spriteRenderShader->setInt("animationLoopMode", static_cast<int>(animationClip.loopMode));
+		spriteRenderShader->setFloat("animationStartTime", animationStartTime);
+	}
+
 	spriteRenderShader->setVector2("offset", offset);
 	spriteRenderShader->setVector2("size", size);
 
@@ -74,6 +88,126 @@ void SpriteRenderer::render(float renderDepth)
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 }
 
+void SpriteRenderer::update()
+{
+	if (!animationPlaying || !onAnimationFrame)
+		return;
+
+	unsigned int frame{ getUnwrappedAnimationFrame() };
+	if (animationClip.loopMode == SpriteAnimationLoopMode::ONCE)
+		frame = std::min(frame, animationClip.frameCount - 1);
+
+	// Calling the callback for every frame since the last update,
+	// but not more than one round of the animation when the game was paused for a long time
+	unsigned int firstFrame{ std::max(lastCallbackFrame + 1, frame >= animationClip.frameCount ? frame - animationClip.frameCount + 1 : 0) };
+	lastCallbackFrame = std::max(lastCallbackFrame, frame);
+
+	for (unsigned int unwrappedFrame{ firstFrame }; unwrappedFrame <= frame; unwrappedFrame++)
+	{
+		onAnimationFrame(wrapAnimationFrame(unwrappedFrame));
+
+		// The callback may have changed the animation
+		if (!animationPlaying)
+			return;
+	}
+}
+
+void SpriteRenderer::playAnimation(const SpriteAnimationClip& clip)
+{
+	if (clip.frameCount == 0 || clip.framesPerSecond <= 0.0f)
+	{
+		Logger::logError("Sprite sheet animation must have at least one frame, and more than 0 frames per second.");
+		return;
+	}
+
+	if (clip.startCell.x < 0 || clip.startCell.y < 0 || clip.startCell.x >= static_cast<int>(columnCount)
+		|| clip.startCell.y * columnCount + clip.startCell.x + clip.frameCount > columnCount * rowCount)
+	{
+		Logger::logError("Sprite sheet animation does not fit in the sprite sheet of "
+			+ std::to_string(columnCount) + " by " + std::to_string(rowCount) + " cells.");
+		return;
+	}
+
+	animationClip = clip;
+	animationStartTime = Time::getScaledTime();
+	animationPlaying = true;
+
+	// The first frame is shown right away, so the callback gets it on the next update
+	lastCallbackFrame = 0;
+	if (onAnimationFrame)
+		onAnimationFrame(0);
+}
+
+void SpriteRenderer::stopAnimation()
+{
+	if (!animationPlaying)
+		return;
+
+	unsigned int cell{ animationClip.startCell.y * columnCount + animationClip.startCell.x + getAnimationFrame() };
+	columnIndex = cell % columnCount;
+	rowIndex = cell / columnCount;
+
+	animationPlaying = false;
+}
+
+bool SpriteRenderer::isAnimationPlaying() const
+{
+	return animationPlaying;
+}
+
+bool SpriteRenderer::isAnimationFinished() const
+{
+	return animationPlaying
+		&& animationClip.loopMode == SpriteAnimationLoopMode::ONCE
+		&& getUnwrappedAnimationFrame() >= animationClip.frameCount;
+}
+
+unsigned int SpriteRenderer::getAnimationFrame() const
+{
+	if (!animationPlaying)
+		return 0;
+
+	return wrapAnimationFrame(getUnwrappedAnimationFrame());
+}
+
+void SpriteRenderer::setOnAnimationFrame(std::function<void(unsigned int frame)> onAnimationFrame)
+{
+	this->onAnimationFrame = onAnimationFrame;
+
+	// Not calling the callback for frames that were shown before it was set
+	if (animationPlaying)
+		lastCallbackFrame = getUnwrappedAnimationFrame();
+}
+
+unsigned int SpriteRenderer::getUnwrappedAnimationFrame() const
+{
+	// Matches getAnimationFrame() in the sprite vertex shader
+	float elapsed{ std::max(Time::getScaledTime() - animationStartTime, 0.0f) };
+	return static_cast<unsigned int>(std::floor(elapsed * animationClip.framesPerSecond));
+}
+
+unsigned int SpriteRenderer::wrapAnimationFrame(unsigned int unwrappedFrame) const
+{
+	switch (animationClip.loopMode)
+	{
+		case SpriteAnimationLoopMode::ONCE:
+			return std::min(unwrappedFrame, animationClip.frameCount - 1);
+
+		case SpriteAnimationLoopMode::PING_PONG:
+		{
+			if (animationClip.frameCount == 1)
+				return 0;
+
+			unsigned int period{ 2 * animationClip.frameCount - 2 };
+			unsigned int frame{ unwrappedFrame % period };
+			return frame < animationClip.frameCount ? frame : period - frame;
+		}
+
+		default:
+			return unwrappedFrame % animationClip.frameCount;
+	}
+}
+
 void SpriteRenderer::setSprite(const std::string& spritePath, bool pixelPerfect)
 {
 	textureID = TextureEngine::loadTexture(spritePath, pixelPerfect);
@@ -90,6 +224,7 @@ void SpriteRenderer::setSpriteSheetColumnIndex(unsigned int column)
 	}
 
 	columnIndex = column;
+	animationPlaying = false;
 }
 
 void SpriteRenderer::setSpriteSheetRowIndex(unsigned int row)
@@ -103,6 +238,7 @@ void SpriteRenderer::setSpriteSheetRowIndex(unsigned int row)
 	}
 
 	rowIndex = row;
+	animationPlaying = false;
 }
 
 void SpriteRenderer::setSpriteSheetIndex(glm::ivec2 index)
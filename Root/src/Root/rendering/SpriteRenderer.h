@@ -12,8 +12,36 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <functional>
+
 #define SpriteRendererPointer SpriteRenderer*
 
+/**
+ * What a sprite sheet animation does when it reaches its last frame.
+ */
+enum class SpriteAnimationLoopMode
+{
+	// Start again from the first frame
+	LOOP,
+	// Stay on the last frame
+	ONCE,
+	// Play backwards to the first frame, then forwards again
+	PING_PONG
+};
+
+/**
+ * A sprite sheet animation: a range of cells in the sheet that are shown one after another.
+ * Cells are counted row by row, so an animation can continue on the next row.
+ */
+struct SpriteAnimationClip
+{
+	// The cell of the first frame (column, row)
+	glm::ivec2 startCell{ 0, 0 };
+	unsigned int frameCount{ 1 };
+	float framesPerSecond{ 12.0f };
+	SpriteAnimationLoopMode loopMode{ SpriteAnimationLoopMode::LOOP };
+};
+
 /**
  * Component for rendering sprites.
  */
@@ -50,6 +78,12 @@ public:
 
 	void render(float renderDepth) override;
 
+	/**
+	 * Call the animation frame callback for the frames the animation reached since the last update.
+	 * Does nothing if no callback is set.
+	 */
+	void update() override;
+
 	/**
 	 * Set the sprite used by this sprite renderer.
 	 * 
@@ -79,6 +113,49 @@ public:
 	 */
 	void setSpriteSheetIndex(glm::ivec2 index);
 
+	/**
+	 * Play a sprite sheet animation.
+	 * The frames are chosen by the sprite shader from the time, so the animation costs no work per frame,
+	 * and stops the sprite sheet index from being set.
+	 *
+	 * \param clip: the animation to play.
+	 */
+	void playAnimation(const SpriteAnimationClip& clip);
+
+	/**
+	 * Stop the sprite sheet animation, keeping the frame it was showing.
+	 */
+	void stopAnimation();
+
+	/**
+	 * Get whether a sprite sheet animation is playing.
+	 * An animation that plays once keeps playing on its last frame until it is stopped.
+	 */
+	bool isAnimationPlaying() const;
+
+	/**
+	 * Get whether an animation that plays once finished showing its last frame.
+	 */
+	bool isAnimationFinished() const;
+
+	/**
+	 * Get the frame the sprite sheet animation is showing.
+	 *
+	 * \returns the index of the frame in the animation, 0 if no animation is playing.
+	 */
+	unsigned int getAnimationFrame() const;
+
+	/**
+	 * Set a function that is called every time the sprite sheet animation shows a new frame,
+	 * e.g. to play a footstep sound on a certain frame.
+	 * If the animation goes past several frames in one update, it is called for each of them.
+	 * Only sprites with a callback do any work for their animation on the CPU.
+	 *
+	 * \param onAnimationFrame: the function, which is given the index of the frame in the animation.
+	 * An empty function removes the callback.
+	 */
+	void setOnAnimationFrame(std::function<void(unsigned int frame)> onAnimationFrame);
+
 	/**
 	 * Set the offset of the rendered sprite relative to the transform center.
 	 * 
@@ -98,6 +175,16 @@ private:
 	SpriteRenderer(unsigned int columnCount, unsigned int rowCount,
 		glm::vec2 offset, glm::vec2 size);
 
+	/**
+	 * Get how many frames the animation has gone through, without wrapping around.
+	 */
+	unsigned int getUnwrappedAnimationFrame() const;
+
+	/**
+	 * Get the frame of the animation that is shown after going through a number of frames.
+	 */
+	unsigned int wrapAnimationFrame(unsigned int unwrappedFrame) const;
+
 	// float height;
 
 	unsigned int textureID{ 0 };
@@ -110,4 +197,13 @@ private:
 
 	glm::vec2 size;
 	glm::vec2 offset;
+
+	bool animationPlaying{ false };
+	SpriteAnimationClip animationClip;
+	// The scaled time at which the animation started
+	float animationStartTime{ 0.0f };
+
+	std::function<void(unsigned int frame)> onAnimationFrame;
+	// The unwrapped frame the callback was last called for
+	unsigned int lastCallbackFrame{ 0 };
 };
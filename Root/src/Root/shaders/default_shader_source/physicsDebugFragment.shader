@@ -0,0 +1,10 @@
+#version 460 core
+
+in vec4 color;
+
+out vec4 fragmentColor;
+
+void main()
+{
+    fragmentColor = color;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#version 460 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec4 vertexColor;
+
+uniform mat4 projection;
+uniform mat4 view;
+
+out vec4 color;
+
+void main()
+{
+    color = vertexColor;
+
+    // Vertices are already in world space
+    gl_Position = projection * view * vec4(position, 0.0, 1.0);
+}
\ No newline at end of file
@@ -14,11 +14,39 @@ uniform int rowCount;
 uniform int columnIndex;
 uniform int rowIndex;
 
+// Sprite sheet animation, played when animationFrameCount is not 0
+uniform int animationFrameCount;
+// The first cell of the animation, counting row by row
+uniform int animationStartCell;
+uniform float animationFramesPerSecond;
+// 0 = loop, 1 = once, 2 = ping pong
+uniform int animationLoopMode;
+uniform float animationStartTime;
+
+uniform float time;
+
 uniform vec2 offset;
 uniform vec2 size;
 
 uniform float renderDepth;
 
+int getAnimationFrame()
+{
+    int frame = int(floor(max(time - animationStartTime, 0.0) * animationFramesPerSecond));
+
+    if (animationLoopMode == 1)
+        return min(frame, animationFrameCount - 1);
+
+    if (animationLoopMode == 2 && animationFrameCount > 1)
+    {
+        int period = 2 * animationFrameCount - 2;
+        frame = frame % period;
+        return frame < animationFrameCount ? frame : period - frame;
+    }
+
+    return frame % animationFrameCount;
+}
+
 void main()
 {
     // Screen position
@@ -35,9 +63,19 @@ void main()
         float spriteWidth = 1.0 / float(columnCount);
         float spriteHeight = 1.0 / float(rowCount);
 
+        int column = columnIndex;
+        int row = rowIndex;
+
+        if (animationFrameCount != 0)
+        {
+            int cell = animationStartCell + getAnimationFrame();
+            column = cell % columnCount;
+            row = cell / columnCount;
+        }
+
         TexCoords = vec2(
-            (float(columnIndex) / float(columnCount)) + (uv.x * spriteWidth),
-            (float(rowIndex) / float(rowCount)) + (uv.y * spriteHeight)
+            (float(column) / float(columnCount)) + (uv.x * spriteWidth),
+            (float(row) / float(rowCount)) + (uv.y * spriteHeight)
         );
     }
 }
\ No newline at end of file
@@ -8,7 +8,9 @@ struct Tile
 	int baseIndex;
 	int tileTextureIndicesStartIndex;
 	int tileTextureIndexCount;
-	bool randomTileIndexOffset;
+	int randomTileIndexOffset;
+	// 0 if the tile does not animate
+	float framesPerSecond;
 };
 
 layout(std430, binding = 0) buffer Tiles
@@ -36,6 +38,8 @@ uniform float tileSize;
 
 uniform int tileIndexRandomisationSeed;
 
+uniform float time;
+
 uniform ivec2 textureGridSize;
 
 float epsilon = 0.001;
@@ -69,8 +73,11 @@ void main()
 
 	int finalTextureIndex = tiles[GeoIn_TileIndex[0]].baseIndex;
 
-	// Adding some random offset to the index
-	if (tiles[GeoIn_TileIndex[0]].randomTileIndexOffset)
+	// Moving to the current frame of the animation
+	finalTextureIndex += int(floor(time * tiles[GeoIn_TileIndex[0]].framesPerSecond));
+
+	// Adding some random offset to the index, so animated tiles are not all on the same frame
+	if (tiles[GeoIn_TileIndex[0]].randomTileIndexOffset != 0)
 	{
 		finalTextureIndex += randInt(tileIndexRandomisationSeed + GeoIn_TileID[0]);
 	}
@@ -2,6 +2,12 @@
 
 layout(location = 0) in int tileIndex;
 
+// The top left grid space and the layer of each chunk, when the tiles are stored in chunks
+layout(std430, binding = 2) buffer ChunkPositions
+{
+    ivec4 chunkPositions[];
+};
+
 uniform mat4 projection;
 uniform mat4 model;
 uniform mat4 view;
@@ -10,6 +16,9 @@ uniform float renderDepth;
 
 uniform ivec2 tileGridSize;
 
+// The width of the chunks the tiles are stored in, or 0 if they are stored layer by layer, row by row
+uniform int chunkSize;
+
 uniform float tileSize;
 
 out int GeoIn_TileIndex;
@@ -20,10 +29,26 @@ void main()
 {
     vec2 position = -vec2(tileGridSize) / 2.0 + vec2(0.5, 0.5);
 
-    int layer = int(gl_VertexID / (tileGridSize.x * tileGridSize.y));
-    int layerIndex = int(mod(gl_VertexID, tileGridSize.x * tileGridSize.y));
-    int x = int(mod(gl_VertexID,tileGridSize.x));
-    int y = int(mod(int(gl_VertexID / tileGridSize.x), tileGridSize.y));
+    int layer;
+    int x;
+    int y;
+
+    if (chunkSize > 0)
+    {
+        int chunkArea = chunkSize * chunkSize;
+        ivec4 chunk = chunkPositions[gl_VertexID / chunkArea];
+        int indexInChunk = gl_VertexID % chunkArea;
+
+        layer = chunk.z;
+        x = chunk.x + indexInChunk % chunkSize;
+        y = chunk.y + indexInChunk / chunkSize;
+    }
+    else
+    {
+        layer = int(gl_VertexID / (tileGridSize.x * tileGridSize.y));
+        x = int(mod(gl_VertexID,tileGridSize.x));
+        y = int(mod(int(gl_VertexID / tileGridSize.x), tileGridSize.y));
+    }
 
     position += vec2(x, y);
 
@@ -34,5 +59,6 @@ void main()
 
     GeoIn_TileIndex = tileIndex;
     GeoIn_LayerIndex = layer;
-    GeoIn_TileID = gl_VertexID;
-}
\ No newline at end of file
+    // The same for every tile however the tiles are stored
+    GeoIn_TileID = (layer * tileGridSize.y + y) * tileGridSize.x + x;
+}
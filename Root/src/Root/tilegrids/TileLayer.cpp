@@ -0,0 +1,102 @@
+#include "TileLayer.h"
+
+#include <algorithm>
+
+namespace
+{
+	const std::uint16_t emptyTile{ 0xFFFF };
+
+	const unsigned int chunkArea{ TILE_GRID_CHUNK_SIZE * TILE_GRID_CHUNK_SIZE };
+}
+
+TileLayer::TileLayer(glm::ivec2 size)
+	: size(size)
+{
+	chunkCount = (size + glm::ivec2(TILE_GRID_CHUNK_SIZE - 1)) / TILE_GRID_CHUNK_SIZE;
+	chunks.resize(chunkCount.x * chunkCount.y);
+	chunkTileCounts.resize(chunkCount.x * chunkCount.y, 0);
+}
+
+int TileLayer::getTile(glm::ivec2 position) const
+{
+	if (position.x < 0 || position.x >= size.x
+		|| position.y < 0 || position.y >= size.y)
+	{
+		return -1;
+	}
+
+	const std::unique_ptr<std::uint16_t[]>& chunk = chunks[getChunkIndex(position)];
+	if (chunk == nullptr)
+		return -1;
+
+	std::uint16_t tile{ chunk[(position.y % TILE_GRID_CHUNK_SIZE) * TILE_GRID_CHUNK_SIZE + position.x % TILE_GRID_CHUNK_SIZE] };
+	return tile == emptyTile ? -1 : tile;
+}
+
+bool TileLayer::setTile(glm::ivec2 position, int tileIndex)
+{
+	std::uint16_t tile{ tileIndex < 0 ? emptyTile : static_cast<std::uint16_t>(tileIndex) };
+
+	unsigned int chunkIndex{ getChunkIndex(position) };
+	std::unique_ptr<std::uint16_t[]>& chunk = chunks[chunkIndex];
+
+	if (chunk == nullptr)
+	{
+		// Empty chunks stay unallocated
+		if (tile == emptyTile)
+			return false;
+
+		chunk.reset(new std::uint16_t[chunkArea]);
+		std::fill(chunk.get(), chunk.get() + chunkArea, emptyTile);
+		occupiedChunkCount++;
+	}
+
+	std::uint16_t& current{ chunk[(position.y % TILE_GRID_CHUNK_SIZE) * TILE_GRID_CHUNK_SIZE + position.x % TILE_GRID_CHUNK_SIZE] };
+
+	if (current == tile)
+		return false;
+
+	if (current == emptyTile)
+		chunkTileCounts[chunkIndex]++;
+	else if (tile == emptyTile)
+		chunkTileCounts[chunkIndex]--;
+
+	current = tile;
+
+	// Releasing the chunk when its last tile is removed
+	if (chunkTileCounts[chunkIndex] == 0)
+	{
+		chunk.reset();
+		occupiedChunkCount--;
+	}
+
+	return true;
+}
+
+const std::uint16_t* TileLayer::getChunk(glm::ivec2 chunk) const
+{
+	return chunks[chunk.y * chunkCount.x + chunk.x].get();
+}
+
+glm::ivec2 TileLayer::getChunkCount() const
+{
+	return chunkCount;
+}
+
+unsigned int TileLayer::getOccupiedChunkCount() const
+{
+	return occupiedChunkCount;
+}
+
+std::size_t TileLayer::getMemoryUsage() const
+{
+	return sizeof(TileLayer)
+		+ chunks.capacity() * sizeof(std::unique_ptr<std::uint16_t[]>)
+		+ chunkTileCounts.capacity() * sizeof(std::uint16_t)
+		+ static_cast<std::size_t>(occupiedChunkCount) * chunkArea * sizeof(std::uint16_t);
+}
+
+unsigned int TileLayer::getChunkIndex(glm::ivec2 position) const
+{
+	return (position.y / TILE_GRID_CHUNK_SIZE) * chunkCount.x + position.x / TILE_GRID_CHUNK_SIZE;
+}
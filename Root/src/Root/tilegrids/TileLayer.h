@@ -0,0 +1,86 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// The width and height in tiles of the chunks that tiles are stored in, and that tile changes are tracked in
+#define TILE_GRID_CHUNK_SIZE 16
+
+// The largest tile index a tile layer can hold: indices are 16 bit and read as signed numbers by the tile shader
+#define TILE_LAYER_MAX_TILE_INDEX 0x7FFE
+
+/**
+ * The tiles of one layer of a tile grid, stored sparsely.
+ * Only chunks with at least one tile in them are allocated, as one 16 bit tile index per grid space,
+ * so mostly empty layers (like decoration) cost next to nothing.
+ */
+class TileLayer
+{
+public:
+
+	/**
+	 * Create an empty tile layer.
+	 *
+	 * \param size: the number of grid spaces horizontally, vertically.
+	 */
+	TileLayer(glm::ivec2 size);
+
+	/**
+	 * Get the tile at a position.
+	 *
+	 * \param position: the position in the grid.
+	 * \returns the index of the tile, or -1 if the space is empty or out of bounds.
+	 */
+	int getTile(glm::ivec2 position) const;
+
+	/**
+	 * Set the tile at a position, allocating or releasing its chunk if needed.
+	 *
+	 * \param position: the position in the grid, which must be inside of the layer.
+	 * \param tileIndex: the index of the tile, at most TILE_LAYER_MAX_TILE_INDEX, or -1 to make the space empty.
+	 * \returns whether the tile changed.
+	 */
+	bool setTile(glm::ivec2 position, int tileIndex);
+
+	/**
+	 * Get the tiles of a chunk, row by row, where empty spaces are 0xFFFF.
+	 *
+	 * \param chunk: the position of the chunk, in chunks.
+	 * \returns the tiles, or nullptr if the chunk is empty.
+	 */
+	const std::uint16_t* getChunk(glm::ivec2 chunk) const;
+
+	/**
+	 * Get the number of chunks horizontally, vertically.
+	 */
+	glm::ivec2 getChunkCount() const;
+
+	/**
+	 * Get the number of chunks that hold at least one tile.
+	 */
+	unsigned int getOccupiedChunkCount() const;
+
+	/**
+	 * Get the number of bytes this layer uses.
+	 */
+	std::size_t getMemoryUsage() const;
+
+private:
+
+	unsigned int getChunkIndex(glm::ivec2 position) const;
+
+	glm::ivec2 size{ glm::ivec2(0) };
+	glm::ivec2 chunkCount{ glm::ivec2(0) };
+
+	// The tiles of each chunk, or nullptr for empty chunks
+	std::vector<std::unique_ptr<std::uint16_t[]>> chunks;
+
+	// The number of tiles in each chunk, so chunks can be released when they become empty
+	std::vector<std::uint16_t> chunkTileCounts;
+
+	unsigned int occupiedChunkCount{ 0 };
+};
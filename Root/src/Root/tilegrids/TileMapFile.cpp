@@ -0,0 +1,527 @@
+#include "TileMapFile.h"
+
+#include <Root/MemoryMappedFile.h>
+#include <Root/Logger.h>
+
+#include <fstream>
+#include <cstring>
+
+namespace TileMapFile
+{
+	namespace
+	{
+		const char binaryMagic[4]{ 'R', 'T', 'M', 'P' };
+		const std::uint32_t binaryVersion{ 1 };
+
+		// The only layer encoding so far: one 16 bit code per grid space
+		const std::uint32_t layerEncodingCodes16{ 0 };
+
+		struct BinaryHeader
+		{
+			char magic[4];
+			std::uint32_t version;
+			std::uint32_t width;
+			std::uint32_t height;
+			std::uint32_t layerCount;
+			std::uint32_t reserved;
+		};
+
+		struct BinaryLayerEntry
+		{
+			std::uint64_t dataOffset;
+			std::uint32_t encoding;
+			std::uint32_t reserved;
+		};
+
+		static_assert(sizeof(BinaryHeader) == 24, "The tile map header must not be padded");
+		static_assert(sizeof(BinaryLayerEntry) == 16, "Tile map layer entries must not be padded");
+
+		bool isNumber(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		bool isTag(char c)
+		{
+			return c >= 'a' && c <= 'z';
+		}
+
+		/**
+		 * Reads characters from a buffer, like a file stream but without any per-character overhead.
+		 * Past the end it returns '\0', which is not valid anywhere in a tile map.
+		 */
+		struct TextReader
+		{
+			const char* position;
+			const char* end;
+
+			bool good() const
+			{
+				return position < end;
+			}
+
+			char get()
+			{
+				return position < end ? *position++ : '\0';
+			}
+
+			void skipLine()
+			{
+				const char* newline{ static_cast<const char*>(std::memchr(position, '\n', end - position)) };
+				position = newline == nullptr ? end : newline + 1;
+			}
+
+			/**
+			 * Read the rest of a number of which the first digit was already read.
+			 */
+			unsigned int readNumber(char first)
+			{
+				unsigned long long number{ static_cast<unsigned long long>(first - '0') };
+
+				while (position < end && isNumber(*position))
+				{
+					number = number * 10 + (*position++ - '0');
+
+					// Clamping instead of overflowing, so the number is always rejected as too large
+					if (number > 0xFFFFFFFFull)
+						number = 0xFFFFFFFFull;
+				}
+
+				return static_cast<unsigned int>(number);
+			}
+
+			/**
+			 * Find the first number, skipping empty lines, comments and other characters.
+			 */
+			bool findNumber(char& first)
+			{
+				while (good())
+				{
+					char c{ get() };
+
+					// Skip entire line after #
+					if (c == '#')
+					{
+						skipLine();
+						continue;
+					}
+
+					if (isNumber(c))
+					{
+						first = c;
+						return true;
+					}
+				}
+				return false;
+			}
+		};
+
+		bool isBinary(const MemoryMappedFile& file)
+		{
+			return file.getSize() >= sizeof(binaryMagic)
+				&& std::memcmp(file.getData(), binaryMagic, sizeof(binaryMagic)) == 0;
+		}
+
+		/**
+		 * Read the header and layer table of a binary tile map, and find where the codes of each layer start.
+		 */
+		bool readBinaryLayout(const MemoryMappedFile& file, const std::string& path,
+			glm::ivec2& mapSize, unsigned int& layerCount, std::vector<const unsigned char*>& layerCodes)
+		{
+			const unsigned char* data{ file.getData() };
+			std::size_t size{ file.getSize() };
+
+			BinaryHeader header;
+			if (size < sizeof(header))
+			{
+				Logger::logError("Cannot read tile grid from '" + path + "'; The header is cut off.");
+				return false;
+			}
+			std::memcpy(&header, data, sizeof(header));
+
+			if (header.version != binaryVersion)
+			{
+				Logger::logError("Cannot read tile grid from '" + path + "'; It was written by a different version.");
+				return false;
+			}
+
+			if (header.width == 0 || header.height == 0 || header.layerCount == 0
+				|| header.width > 0xFFFF || header.height > 0xFFFF || header.layerCount > 0xFFFF)
+			{
+				Logger::logError("Cannot read tile grid from '" + path + "'; Its size is invalid.");
+				return false;
+			}
+
+			std::uint64_t layerSize{ static_cast<std::uint64_t>(header.width) * header.height };
+			std::uint64_t tableEnd{ sizeof(header) + static_cast<std::uint64_t>(header.layerCount) * sizeof(BinaryLayerEntry) };
+			if (tableEnd > size)
+			{
+				Logger::logError("Cannot read tile grid from '" + path + "'; The layer table is cut off.");
+				return false;
+			}
+
+			// Every layer is stored separately, so a file too small to hold all of them is invalid.
+			// Checked before anything is allocated for the layers, so a corrupt header cannot cause a huge allocation.
+			// At most 0xFFFF^3 * 2 bytes, which fits in 64 bits.
+			std::uint64_t codesSize{ static_cast<std::uint64_t>(header.layerCount) * layerSize * sizeof(std::uint16_t) };
+			if (codesSize > size - tableEnd)
+			{
+				Logger::logError("Cannot read tile grid from '" + path + "'; The layers are cut off.");
+				return false;
+			}
+
+			layerCodes.resize(header.layerCount);
+
+			for (std::uint32_t layer{ 0 }; layer < header.layerCount; layer++)
+			{
+				BinaryLayerEntry entry;
+				std::memcpy(&entry, data + sizeof(header) + layer * sizeof(BinaryLayerEntry), sizeof(entry));
+
+				// Written so that a huge offset cannot overflow and pass the check
+				if (entry.encoding != layerEncodingCodes16
+					|| entry.dataOffset > size
+					|| layerSize * sizeof(std::uint16_t) > size - entry.dataOffset)
+				{
+					Logger::logError("Cannot read tile grid from '" + path + "'; Layer " + std::to_string(layer + 1) + " is invalid.");
+					return false;
+				}
+
+				layerCodes[layer] = data + entry.dataOffset;
+			}
+
+			mapSize = glm::ivec2(header.width, header.height);
+			layerCount = header.layerCount;
+			return true;
+		}
+
+		bool loadBinary(const MemoryMappedFile& file, const std::string& path, TileMapData& map)
+		{
+			std::vector<const unsigned char*> layerCodes;
+			if (!readBinaryLayout(file, path, map.size, map.layerCount, layerCodes))
+				return false;
+
+			std::uint64_t layerSize{ static_cast<std::uint64_t>(map.size.x) * map.size.y };
+			map.codes.resize(layerSize * map.layerCount);
+
+			// The codes are stored as they are in the file, so each layer is a single copy
+			for (unsigned int layer{ 0 }; layer < map.layerCount; layer++)
+			{
+				std::memcpy(map.codes.data() + layerSize * layer, layerCodes[layer], layerSize * sizeof(std::uint16_t));
+			}
+
+			return true;
+		}
+	}
+
+	std::uint16_t encodeGridSpace(const GridSpace& gridSpace)
+	{
+		switch (gridSpace.type)
+		{
+			case GridSpaceType::INDEX:
+				return static_cast<std::uint16_t>(gridSpace.index);
+			case GridSpaceType::TAG:
+				return static_cast<std::uint16_t>(TILE_MAP_CODE_TAG + static_cast<unsigned char>(gridSpace.tag));
+			case GridSpaceType::FILL_IN:
+				return TILE_MAP_CODE_FILL_IN;
+			default:
+				return TILE_MAP_CODE_EMPTY;
+		}
+	}
+
+	GridSpace decodeGridSpace(std::uint16_t code)
+	{
+		if (code < TILE_MAP_CODE_TAG)
+			return GridSpace{ GridSpaceType::INDEX, code };
+		if (code == TILE_MAP_CODE_FILL_IN)
+			return GridSpace{ GridSpaceType::FILL_IN };
+
+		char tag{ static_cast<char>(code - TILE_MAP_CODE_TAG) };
+		if (code != TILE_MAP_CODE_EMPTY && isTag(tag))
+			return GridSpace{ GridSpaceType::TAG, 0, tag };
+
+		return GridSpace{ GridSpaceType::EMPTY };
+	}
+
+	bool load(const std::string& path, TileMapData& map)
+	{
+		MemoryMappedFile file;
+		if (!file.open(path))
+		{
+			Logger::logError("Cannot read tile grid from '" + path + "'; File cannot be opened.");
+			return false;
+		}
+
+		if (isBinary(file))
+			return loadBinary(file, path, map);
+
+		return parseText(reinterpret_cast<const char*>(file.getData()), file.getSize(), path, map);
+	}
+
+	bool parseText(const char* data, std::size_t size, const std::string& path, TileMapData& map)
+	{
+		TextReader reader{ data, data + size };
+
+		// Reading the tile grid dimensions: the number of rows, a separator and the number of columns
+		char c;
+		if (reader.findNumber(c))
+		{
+			map.size.y = static_cast<int>(reader.readNumber(c));
+			reader.get();
+			c = reader.get();
+			map.size.x = isNumber(c) ? static_cast<int>(reader.readNumber(c)) : 0;
+		}
+
+		if (map.size.x <= 0 || map.size.y <= 0 || map.size.x > 0xFFFF || map.size.y > 0xFFFF)
+		{
+			Logger::logError("Tile grid size must not be less than 1 in each dimension. (" + path + ")");
+			return false;
+		}
+
+		// Reading the number of layers
+		map.layerCount = reader.findNumber(c) ? reader.readNumber(c) : 0;
+
+		if (map.layerCount <= 0 || map.layerCount > 0xFFFF)
+		{
+			Logger::logError("Tile layer count must not be less than 1. (" + path + ")");
+			return false;
+		}
+
+		std::size_t layerSize{ static_cast<std::size_t>(map.size.x) * map.size.y };
+		map.codes.assign(layerSize * map.layerCount, TILE_MAP_CODE_EMPTY);
+
+		unsigned int currentRowIndex{ 0 };
+		unsigned int currentLayerIndex{ 0 };
+		unsigned int invalidTags{ 0 };
+		unsigned int invalidIndices{ 0 };
+
+		// Reading the grid spaces, one row per line
+		while (reader.good() && currentLayerIndex < map.layerCount)
+		{
+			c = reader.get();
+
+			// Skip empty lines
+			if (c == '\n' || c == '\r')
+				continue;
+
+			// Skip entire line after #
+			if (c == '#')
+			{
+				reader.skipLine();
+				continue;
+			}
+
+			std::uint16_t* row{ map.codes.data() + layerSize * currentLayerIndex + static_cast<std::size_t>(currentRowIndex) * map.size.x };
+
+			// Reached a data line: each grid space is followed by a separator
+			for (int i{ 0 }; i < map.size.x; i++)
+			{
+				// Find the next char except at the beginning
+				if (i != 0)
+					c = reader.get();
+
+				if (isNumber(c))
+				{
+					unsigned int index{ reader.readNumber(c) };
+
+					// Indices that do not fit in a code leave the space empty
+					if (index < TILE_MAP_CODE_TAG)
+					{
+						row[i] = static_cast<std::uint16_t>(index);
+					}
+					else
+					{
+						if (invalidIndices == 0)
+						{
+							Logger::logError("Tile index " + std::to_string(index) + " in layer "
+								+ std::to_string(currentLayerIndex + 1)
+								+ " in column " + std::to_string(i + 1)
+								+ " in row " + std::to_string(currentRowIndex + 1)
+								+ " is too large, it must be below " + std::to_string(TILE_MAP_CODE_TAG) + ". (" + path + ")");
+						}
+						invalidIndices++;
+					}
+				}
+				else if (c == ' ' || c == '-')
+				{
+					row[i] = TILE_MAP_CODE_EMPTY;
+				}
+				else if (c == '+')
+				{
+					row[i] = TILE_MAP_CODE_FILL_IN;
+				}
+				else if (isTag(c))
+				{
+					row[i] = encodeGridSpace(GridSpace{ GridSpaceType::TAG, 0, c });
+				}
+				else
+				{
+					// Disallowed tag: empty space. Only the first one is reported, since one mistake often causes many.
+					if (invalidTags == 0)
+					{
+						Logger::logError(std::string("Invalid tag found in layer ")
+							+ std::to_string(currentLayerIndex + 1)
+							+ " in column " + std::to_string(i + 1)
+							+ " in row " + std::to_string(currentRowIndex + 1)
+							+ ": " + c + " (" + path + ")");
+					}
+					invalidTags++;
+				}
+
+				// Skip the separator
+				reader.get();
+			}
+
+			currentRowIndex++;
+
+			// Move to the next layer
+			if (currentRowIndex >= static_cast<unsigned int>(map.size.y))
+			{
+				currentRowIndex = 0;
+				currentLayerIndex++;
+			}
+		}
+
+		if (invalidTags > 1)
+			Logger::logError(std::to_string(invalidTags) + " invalid tags found in total. (" + path + ")");
+
+		if (invalidIndices > 1)
+			Logger::logError(std::to_string(invalidIndices) + " too large tile indices found in total. (" + path + ")");
+
+		if (currentLayerIndex < map.layerCount)
+			Logger::logWarning("Tile grid '" + path + "' ends in row " + std::to_string(currentRowIndex + 1)
+				+ " of layer " + std::to_string(currentLayerIndex + 1) + ", the rest is left empty.");
+
+		return true;
+	}
+
+	bool writeBinary(const TileMapData& map, const std::string& path)
+	{
+		std::size_t layerSize{ static_cast<std::size_t>(map.size.x) * map.size.y };
+
+		BinaryHeader header{};
+		std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+		header.version = binaryVersion;
+		header.width = static_cast<std::uint32_t>(map.size.x);
+		header.height = static_cast<std::uint32_t>(map.size.y);
+		header.layerCount = map.layerCount;
+
+		std::vector<BinaryLayerEntry> table(map.layerCount);
+		std::uint64_t offset{ sizeof(header) + table.size() * sizeof(BinaryLayerEntry) };
+		for (BinaryLayerEntry& entry : table)
+		{
+			entry = BinaryLayerEntry{ offset, layerEncodingCodes16, 0 };
+			offset += layerSize * sizeof(std::uint16_t);
+		}
+
+		std::ofstream file{ path, std::ios::out | std::ios::binary | std::ios::trunc };
+		if (!file.is_open())
+		{
+			Logger::logError("Cannot write tile grid to '" + path + "'; File cannot be opened.");
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(BinaryLayerEntry));
+		file.write(reinterpret_cast<const char*>(map.codes.data()), map.codes.size() * sizeof(std::uint16_t));
+
+		if (!file)
+		{
+			Logger::logError("Failed to write tile grid to '" + path + "'.");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool convertTextToBinary(const std::string& textPath, const std::string& binaryPath)
+	{
+		TileMapData map;
+		if (!load(textPath, map))
+			return false;
+
+		return writeBinary(map, binaryPath);
+	}
+};
+
+GridSpace TileMapData::getGridSpace(int x, int y, unsigned int layer) const
+{
+	if (x < 0 || x >= size.x || y < 0 || y >= size.y || layer >= layerCount)
+		return GridSpace{ GridSpaceType::OUT_OF_BOUNDS };
+
+	return TileMapFile::decodeGridSpace(codes[(static_cast<std::size_t>(layer) * size.y + y) * size.x + x]);
+}
+
+bool TileMapStream::open(const std::string& path)
+{
+	close();
+
+	if (!file.open(path))
+	{
+		Logger::logError("Cannot stream tile grid from '" + path + "'; File cannot be opened.");
+		return false;
+	}
+
+	if (!TileMapFile::isBinary(file))
+	{
+		Logger::logError("Cannot stream tile grid from '" + path + "'; Only binary tile maps can be streamed, see TileMapFile::convertTextToBinary().");
+		close();
+		return false;
+	}
+
+	if (!TileMapFile::readBinaryLayout(file, path, size, layerCount, layerCodes))
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void TileMapStream::close()
+{
+	file.close();
+	layerCodes.clear();
+	size = glm::ivec2(0);
+	layerCount = 0;
+}
+
+bool TileMapStream::isOpen() const
+{
+	return file.isOpen();
+}
+
+glm::ivec2 TileMapStream::getSize() const
+{
+	return size;
+}
+
+unsigned int TileMapStream::getLayerCount() const
+{
+	return layerCount;
+}
+
+void TileMapStream::readRegion(glm::ivec2 min, glm::ivec2 regionSize, unsigned int layer, GridSpace* gridSpaces) const
+{
+	const unsigned char* codes{ layerCodes[layer] };
+
+	for (int y{ 0 }; y < regionSize.y; y++)
+	{
+		int mapY{ min.y + y };
+
+		for (int x{ 0 }; x < regionSize.x; x++)
+		{
+			int mapX{ min.x + x };
+			GridSpace& gridSpace{ gridSpaces[y * regionSize.x + x] };
+
+			if (mapX < 0 || mapX >= size.x || mapY < 0 || mapY >= size.y)
+			{
+				gridSpace = GridSpace{ GridSpaceType::OUT_OF_BOUNDS };
+				continue;
+			}
+
+			std::uint16_t code;
+			std::memcpy(&code, codes + (static_cast<std::size_t>(mapY) * size.x + mapX) * sizeof(code), sizeof(code));
+			gridSpace = TileMapFile::decodeGridSpace(code);
+		}
+	}
+}
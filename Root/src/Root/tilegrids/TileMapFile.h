@@ -0,0 +1,159 @@
+#pragma once
+
+#include <Root/MemoryMappedFile.h>
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum class GridSpaceType
+{
+	EMPTY,
+	FILL_IN,
+	INDEX,
+	TAG,
+	OUT_OF_BOUNDS
+};
+
+struct GridSpace
+{
+	GridSpaceType type;
+	unsigned int index; // For index grid spaces
+	char tag; // For tag grid spaces
+};
+
+/**
+ * The contents of a tile map file, before the tiles are chosen from a tile set.
+ */
+struct TileMapData
+{
+	// The number of grid spaces horizontally, vertically
+	glm::ivec2 size{ glm::ivec2(0) };
+	unsigned int layerCount{ 0 };
+	// All grid spaces as 16 bit codes (see TileMapFile), layer by layer, each layer row by row
+	std::vector<std::uint16_t> codes;
+
+	/**
+	 * Get a grid space, decoded from its code.
+	 *
+	 * \param x: the column of the grid space.
+	 * \param y: the row of the grid space.
+	 * \param layer: the layer of the grid space.
+	 * \returns the grid space, or an OUT_OF_BOUNDS grid space if the position is outside of the tile map.
+	 */
+	GridSpace getGridSpace(int x, int y, unsigned int layer) const;
+};
+
+/**
+ * Reading and writing tile maps.
+ *
+ * Tile maps can be stored as text, which is easy to edit by hand, or in a binary format,
+ * which is memory mapped and decoded without any parsing:
+ * - a header: "RTMP", the version, the width, the height and the number of layers (all 32 bit),
+ * - a table with the offset of each layer's grid spaces in the file (64 bit) and its encoding (32 bit),
+ * - per layer, one 16 bit code per grid space, row by row.
+ * Codes below 0xFF00 are tile indices, 0xFF00 + a letter is a tag, and the codes
+ * TILE_MAP_CODE_FILL_IN and TILE_MAP_CODE_EMPTY are fill-in and empty grid spaces.
+ */
+namespace TileMapFile
+{
+	const std::uint16_t TILE_MAP_CODE_TAG{ 0xFF00 };
+	const std::uint16_t TILE_MAP_CODE_FILL_IN{ 0xFFFE };
+	const std::uint16_t TILE_MAP_CODE_EMPTY{ 0xFFFF };
+
+	/**
+	 * Pack a grid space into a 16 bit code.
+	 * Tile indices must be below TILE_MAP_CODE_TAG.
+	 */
+	std::uint16_t encodeGridSpace(const GridSpace& gridSpace);
+
+	/**
+	 * Unpack a grid space from a 16 bit code. Unknown codes are empty grid spaces.
+	 */
+	GridSpace decodeGridSpace(std::uint16_t code);
+
+	/**
+	 * Read a tile map, in either the text or the binary format.
+	 *
+	 * \param path: the path of the tile map file.
+	 * \param map: the tile map to read into.
+	 * \returns whether the tile map could be read.
+	 */
+	bool load(const std::string& path, TileMapData& map);
+
+	/**
+	 * Parse a tile map in the text format.
+	 *
+	 * \param data: the text.
+	 * \param size: the number of characters in the text.
+	 * \param path: the path the text was read from, for error messages.
+	 * \param map: the tile map to read into.
+	 * \returns whether the tile map could be parsed.
+	 */
+	bool parseText(const char* data, std::size_t size, const std::string& path, TileMapData& map);
+
+	/**
+	 * Write a tile map in the binary format.
+	 *
+	 * \param map: the tile map to write.
+	 * \param path: the path of the file to write.
+	 * \returns whether the file was written.
+	 */
+	bool writeBinary(const TileMapData& map, const std::string& path);
+
+	/**
+	 * Convert a tile map from the text format to the binary format.
+	 *
+	 * \param textPath: the path of the text tile map.
+	 * \param binaryPath: the path of the binary tile map to write.
+	 * \returns whether the tile map was converted.
+	 */
+	bool convertTextToBinary(const std::string& textPath, const std::string& binaryPath);
+};
+
+/**
+ * A binary tile map that stays memory mapped, so that parts of it can be read without loading all of it.
+ * Reading regions is thread safe, as long as the stream is not opened or closed at the same time.
+ */
+class TileMapStream
+{
+public:
+	/**
+	 * Map a tile map file in the binary format.
+	 *
+	 * \param path: the path of the tile map file.
+	 * \returns whether the tile map could be mapped.
+	 */
+	bool open(const std::string& path);
+
+	void close();
+
+	bool isOpen() const;
+
+	/**
+	 * Get the number of grid spaces horizontally, vertically.
+	 */
+	glm::ivec2 getSize() const;
+
+	unsigned int getLayerCount() const;
+
+	/**
+	 * Decode a rectangle of grid spaces of one layer.
+	 * Grid spaces outside of the tile map are OUT_OF_BOUNDS.
+	 *
+	 * \param min: the top left grid space of the rectangle, may lie outside of the tile map.
+	 * \param regionSize: the number of grid spaces horizontally, vertically.
+	 * \param layer: the layer to read.
+	 * \param gridSpaces: the grid spaces to read into, row by row.
+	 */
+	void readRegion(glm::ivec2 min, glm::ivec2 regionSize, unsigned int layer, GridSpace* gridSpaces) const;
+
+private:
+	MemoryMappedFile file;
+	glm::ivec2 size{ glm::ivec2(0) };
+	unsigned int layerCount{ 0 };
+	// Where the codes of each layer start in the mapped file
+	std::vector<const unsigned char*> layerCodes;
+};
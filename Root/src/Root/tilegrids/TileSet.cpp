@@ -175,44 +175,6 @@ Tile TileSet::createTile(char tag,
 	};
 }
 
-void TileSet::update()
-{
-	bool anyTileUpdated{ false };
-
-	// Updating every tile
-	for (Tile& tile : tiles) {
-		// Must have at least 2 texture indices to animate
-		if (tile.textureIndices.size() <= 1) {
-			continue;
-		}
-
-		if (tile.multipleTextureIndexUsage == MultipleTextureIndexUsage::ANIMATION)
-		{
-			// Check if an update is timely
-			if (tile.timeSinceAnimationChange > 1.0f / tile.animationSpeed)
-			{
-				// Moving to the next texture index
-				if (tile.textureIndex >= tile.textureIndices.size() - 1)
-					tile.textureIndex = 0;
-				else
-					tile.textureIndex++;
-
-				// At least one tile was updated
-				anyTileUpdated = true;
-
-				// Reset update timer
-				tile.timeSinceAnimationChange = 0.0f;
-			}
-
-			tile.timeSinceAnimationChange += Time::getDeltaTime() * animationSpeed;
-		}
-	}
-
-	// Updating the SSBO
-	if (anyTileUpdated)
-		generateTileInformationSSBO();
-}
-
 /*
 Tile TileSet::readTile(std::ifstream& file)
 {
@@ -493,7 +455,11 @@ void TileSet::generateTileInformationSSBO()
 		shaderTiles[i].tileTextureIndexCount = tile.textureIndices.size();
 
 		// Whether to use random index offsets
-		shaderTiles[i].randomTileIndexOffset = tile.randomIndexOffset;
+		shaderTiles[i].randomTileIndexOffset = tile.randomIndexOffset ? 1 : 0;
+
+		// Must have at least 2 texture indices to animate
+		bool animated{ tile.multipleTextureIndexUsage == MultipleTextureIndexUsage::ANIMATION && tile.textureIndices.size() > 1 };
+		shaderTiles[i].framesPerSecond = animated ? tile.animationSpeed * animationSpeed : 0.0f;
 
 		index += tile.textureIndices.size();
 	}
@@ -514,6 +480,47 @@ std::vector<Tile>& TileSet::getTiles()
 	return tiles;
 }
 
+int TileSet::chooseTile(char requiredTag, const bool neighbourEmpty[8]) const
+{
+	for (unsigned int tileIndex{ 0 }; tileIndex < tiles.size(); tileIndex++)
+	{
+		const Tile& tile = tiles[tileIndex];
+
+		// If the required tag is not '-', it must match the tile
+		if (requiredTag != '-' && tile.tag != requiredTag)
+			continue;
+
+		bool ruleBroken{ false };
+
+		// Checking all rules for this tile
+		for (unsigned int i{ 0 }; i < 8 && !ruleBroken; i++)
+		{
+			char rule = tile.rules[i];
+
+			// A '~' means that there is no rule set for that neighbouring grid space.
+			if (rule == NO_RULE)
+				continue;
+
+			// A '+' means that the rule is satisfied if a tile exists there.
+			if (rule == EXISTS)
+			{
+				ruleBroken = neighbourEmpty[i];
+				continue;
+			}
+
+			// A '-' means that the rule is satisfied if no tile exists there,
+			// and a letter is (for now) checked in the same way.
+			ruleBroken = !neighbourEmpty[i];
+		}
+
+		// The first non-rule breaking tile is the tile for the spot
+		if (!ruleBroken)
+			return tileIndex;
+	}
+
+	return -1;
+}
+
 void TileSet::bindSSBO()
 {
 	glBindBuffer(GL_SHADER_STORAGE_BUFFER, tilesSSBO);
@@ -52,17 +52,24 @@ struct Tile
 	// Whether to offset each tile individually to a random texture index in the animation
 	bool randomIndexOffset;
 
+	// The number of texture indices shown per second when animating
 	float animationSpeed;
-	float timeSinceAnimationChange{ 0.0f };
 	unsigned int textureIndicesStartIndex{ 0 }; // What index to start the texture indexing at
 };
 
+/**
+ * A tile as it is stored in the tile set SSBO.
+ * Never changes after the tile set is created: the tile shader picks the animation frame from the time.
+ */
 struct ShaderTile
 {
 	int baseIndex;
 	int tileTextureIndicesStartIndex;
 	int tileTextureIndexCount;
-	bool randomTileIndexOffset;
+	// An int because a bool in an SSBO takes 4 bytes
+	int randomTileIndexOffset;
+	// The number of texture indices shown per second, 0 if the tile does not animate
+	float framesPerSecond;
 };
 
 class TileSet
@@ -106,8 +113,6 @@ public:
 		char bottomMiddleRule,
 		char bottomRightRule);
 
-	void update();
-
 	/**
 	 * Set a tile rule on a specific tile
 	 */
@@ -122,6 +127,19 @@ public:
 	 */
 	std::vector<Tile>& getTiles();
 
+	/**
+	 * Choose the tile for an auto-filled grid space: the first tile with a matching tag whose rules
+	 * are satisfied by the neighbouring grid spaces.
+	 * Only reads the tile set, so it can be called from multiple threads while the tile set is not changed.
+	 *
+	 * \param requiredTag: the tag the tile must have, or '-' for any tag.
+	 * \param neighbourEmpty: for each neighbouring grid space, in the order of the rules
+	 * (top left, top middle, top right, middle left, middle right, bottom left, bottom middle, bottom right),
+	 * whether it is empty.
+	 * \returns the index of the tile in this tile set, or -1 if no tile fits.
+	 */
+	int chooseTile(char requiredTag, const bool neighbourEmpty[8]) const;
+
 	/**
 	 * Bind the shader buffer.
 	 */
@@ -66,27 +66,9 @@ RootGUIComponent::Image::~Image()
 {
 }
 
-void RootGUIComponent::Image::render(unsigned int guiShader, unsigned int textShader)
+void RootGUIComponent::Image::appendVertices(GUIBatch& batch)
 {
-	Item::render(guiShader, textShader);
-
-	glUseProgram(guiShader);
-
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, textureID);
-
-	// Setting the uniforms
-	glm::vec2 screenPosition{ getPosition() };
-	glUniform2f(glGetUniformLocation(guiShader, "position"), screenPosition.x, screenPosition.y);
-	glUniform1i(glGetUniformLocation(guiShader, "useTexture"), 1); // Use the texture
-	glUniform1i(glGetUniformLocation(guiShader, "textureSampler"), 0);
-
-	// Draw call
-	glBindVertexArray(RootGUI::getQuadVAO());
-
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-
-	glBindVertexArray(0);
+	batch.addImage(getQuadMatrix(), color * colorDifferenceOnInteract.sample(), textureID);
 }
 
 float RootGUIComponent::Image::loadImage(const char* imagePath)
@@ -43,8 +43,9 @@ namespace RootGUIComponent
 
 		~Image();
 
-		// Render this GUI image
-		void render(unsigned int guiShader, unsigned int textShader);
+	protected:
+
+		void appendVertices(GUIBatch& batch) override;
 
 	private:
 
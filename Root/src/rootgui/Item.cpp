@@ -16,14 +16,35 @@ RootGUIComponent::Item::~Item()
 	std::cout << "Item destroyed." << std::endl;
 }
 
+void RootGUIComponent::Item::addToBatch(GUIBatch& batch)
+{
+	appendVertices(batch);
+	dirty = false;
+}
+
+bool RootGUIComponent::Item::isDirty()
+{
+	// Recalculating the matrices marks the item as dirty if anything about the transform changed
+	updateTransformMatrices();
+
+	return dirty;
+}
+
+void RootGUIComponent::Item::markDirty()
+{
+	dirty = true;
+}
+
 void RootGUIComponent::Item::setVerticalScreenAnchorPoint(VerticalAnchorPoint newVerticalScreenAnchorPoint)
 {
 	this->verticalAnchorPoint = newVerticalScreenAnchorPoint;
+	transformUpdated = true;
 }
 
 void RootGUIComponent::Item::setHorizontalScreenAnchorPoint(HorizontalAnchorPoint newHorizontalScreenAnchorPoint)
 {
 	this->horizontalAnchorPoint = newHorizontalScreenAnchorPoint;
+	transformUpdated = true;
 }
 
 float RootGUIComponent::Item::getVerticalScreenAnchor()
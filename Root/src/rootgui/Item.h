@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Root/base/TransformBase.h>
+#include <rootgui/internal/GUIBatch.h>
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -31,9 +32,24 @@ namespace RootGUIComponent
 	public:
 		~Item();
 
-		// Render this GUI item
-		virtual void render(unsigned int guiShader, unsigned int textShader) {
-		}
+		/**
+		 * Add the vertices of this GUI item to the GUI batch, after which it is no longer dirty.
+		 *
+		 * \param batch: the batch to add the vertices to.
+		 */
+		void addToBatch(GUIBatch& batch);
+
+		/**
+		 * Get whether this item looks different than when it was last added to the GUI batch.
+		 *
+		 * \returns whether the GUI batch has to be made again.
+		 */
+		virtual bool isDirty();
+
+		/**
+		 * Mark this item as changed, so the GUI batch is made again before the next frame.
+		 */
+		void markDirty();
 
 		glm::vec2 getPosition();
 
@@ -51,17 +67,24 @@ namespace RootGUIComponent
 		float getVerticalScreenAnchor();
 		float getHorizontalScreenAnchor();
 
+		// Add the vertices of this GUI item
+		virtual void appendVertices(GUIBatch& batch) {}
+
 		bool enabled{ true };
 
+		// Whether the item changed since it was last added to the GUI batch
+		bool dirty{ true };
+
 		// Where on the screen this rectangle should be placed relative to
 		VerticalAnchorPoint verticalAnchorPoint{ VerticalAnchorPoint::Middle };
 		HorizontalAnchorPoint horizontalAnchorPoint{ HorizontalAnchorPoint::Middle };
 
-	private:
-
+		// The window size the transform matrices were last calculated with
 		unsigned int previousWindowHeight{ 0 };
 		unsigned int previousWindowWidth{ 0 };
 
+	private:
+
 		float widthToHeightRatio;
 	};
 };
@@ -18,6 +18,15 @@ RootGUIComponent::Rectangle::Rectangle(
 
 void RootGUIComponent::Rectangle::updateTransformMatrices()
 {
+	// The matrices depend on the aspect ratio of the window
+	if (previousWindowWidth != RootGUIInternal::getWindowWidth()
+		|| previousWindowHeight != RootGUIInternal::getWindowHeight())
+	{
+		previousWindowWidth = RootGUIInternal::getWindowWidth();
+		previousWindowHeight = RootGUIInternal::getWindowHeight();
+		transformUpdated = true;
+	}
+
 	// Only change the matrices if the values have changed
 	if (!transformUpdated)
 		return;
@@ -56,8 +65,9 @@ void RootGUIComponent::Rectangle::updateTransformMatrices()
 	//inverseTransform = glm::scale(inverseTransform, glm::vec3(size.x, size.y, 1.0f));
 
 
-	// Resetting the inverse transform
+	// Resetting the inverse transforms
 	inverseTransform = glm::identity<glm::mat4>();
+	inverseTransformWithoutScale = glm::identity<glm::mat4>();
 
 	// Size must not be zero for this step
 	//if (size.x != 0.0f && size.y != 0.0f)
@@ -91,36 +101,47 @@ void RootGUIComponent::Rectangle::updateTransformMatrices()
 
 	inverseTransformWithoutScale
 		= glm::translate(inverseTransformWithoutScale, -screenAnchorPoint);
+
+	transformUpdated = false;
+
+	// The vertices have moved along with the transform
+	dirty = true;
 }
 
 void RootGUIComponent::Rectangle::setColor(glm::vec4 color)
 {
 	this->color = color;
+	markDirty();
 }
 
 void RootGUIComponent::Rectangle::setColor(glm::vec3 color)
 {
 	this->color = glm::vec4(color, 1.0f);
+	markDirty();
 }
 
 void RootGUIComponent::Rectangle::setColorOnHover(glm::vec4 color)
 {
 	colorDifferenceOnInteract.addValue(InteractionStatus::Hovered, color);
+	markDirty();
 }
 
 void RootGUIComponent::Rectangle::setColorOnHover(glm::vec3 color)
 {
 	colorDifferenceOnInteract.addValue(InteractionStatus::Hovered, glm::vec4(color, 1.0f));
+	markDirty();
 }
 
 void RootGUIComponent::Rectangle::setColorOnPress(glm::vec4 color)
 {
 	colorDifferenceOnInteract.addValue(InteractionStatus::Pressed, color);
+	markDirty();
 }
 
 void RootGUIComponent::Rectangle::setColorOnPress(glm::vec3 color)
 {
 	colorDifferenceOnInteract.addValue(InteractionStatus::Pressed, glm::vec4(color, 1.0f));
+	markDirty();
 }
 
 RectanglePointer RootGUIComponent::Rectangle::create(
@@ -143,44 +164,31 @@ RootGUIComponent::Rectangle::~Rectangle()
 {
 }
 
-void RootGUIComponent::Rectangle::render(unsigned int guiShader,
-	unsigned int textShader)
+bool RootGUIComponent::Rectangle::isDirty()
 {
-	Item::render(guiShader, textShader);
-
-	glm::vec2 scaleDifferenceByInteract{ scaleDifferenceOnInteract.sample() };
-
-	glUseProgram(guiShader);
-
-	glUniform2f(glGetUniformLocation(guiShader, "additionalScale"),
-		scaleDifferenceByInteract.x, scaleDifferenceByInteract.y);
-
-	// Setting the color uniform
-	glm::vec4 colorDifferenceByInteract{ colorDifferenceOnInteract.sample() };
-	glm::vec4 colorUsing{ color * colorDifferenceByInteract };
-	glUniform4f(glGetUniformLocation(guiShader, "baseColor"),
-		colorUsing.r, colorUsing.g, colorUsing.b, colorUsing.a);
-
-	glUniform2f(glGetUniformLocation(guiShader, "size"), size.x, size.y);
-	//glUniform2f(glGetUniformLocation(guiShader, "size"), 1.0f, 1.0f);
-
-	glUniform1i(glGetUniformLocation(guiShader, "useTexture"), 0); // Don't use the texture
-
-	// Setting the transform matrix
-	glUniformMatrix4fv(glGetUniformLocation(guiShader, "transform"),
-		1, GL_FALSE,
-		glm::value_ptr(getModelMatrix()));
+	// Keep making the vertices again while the interaction transitions are playing
+	return Item::isDirty()
+		|| scaleDifferenceOnInteract.isTransitioning()
+		|| colorDifferenceOnInteract.isTransitioning();
+}
 
-	glBindVertexArray(RootGUI::getQuadVAO());
+void RootGUIComponent::Rectangle::appendVertices(GUIBatch& batch)
+{
+	batch.addQuad(getQuadMatrix(), color * colorDifferenceOnInteract.sample());
+}
 
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+glm::mat4 RootGUIComponent::Rectangle::getQuadMatrix()
+{
+	glm::vec2 scaleDifferenceByInteract{ scaleDifferenceOnInteract.sample() };
 
-	glBindVertexArray(0);
+	return glm::scale(getModelMatrix(),
+		glm::vec3(size * scaleDifferenceByInteract, 1.0f));
 }
 
 void RootGUIComponent::Rectangle::setScaleReference(ScaleReference scaleReference)
 {
 	this->scaleReference = scaleReference;
+	transformUpdated = true;
 }
 
 void RootGUIComponent::Rectangle::updateInteractionFlags(glm::vec2 mousePosition, bool mouseDown)
@@ -307,12 +315,14 @@ void RootGUIComponent::Rectangle::setInteractionStatus(InteractionStatus status)
 void RootGUIComponent::Rectangle::setScaleOnHover(glm::vec2 scale)
 {
 	scaleDifferenceOnInteract.addValue(InteractionStatus::Hovered, scale);
+	markDirty();
 }
 
 
 void RootGUIComponent::Rectangle::setScaleOnPress(glm::vec2 scale)
 {
 	scaleDifferenceOnInteract.addValue(InteractionStatus::Pressed, scale);
+	markDirty();
 }
 
 void RootGUIComponent::Rectangle::setTransitionDuration(float transitionDuration)
@@ -334,6 +344,10 @@ void RootGUIComponent::Rectangle::setParent(Rectangle* parent, bool alsoAddChild
 	// Setting new derived parent
 	this->derivedParent = parent;
 
+	// The rectangle is now placed relative to the new parent, which also changes its aspect ratio
+	transformUpdated = true;
+	markDirty();
+
 	// Possibly adding child to new parent
 	if (alsoAddChild && parent != NULL)
 		parent->addChild(this, false);
@@ -364,6 +378,8 @@ bool RootGUIComponent::Rectangle::removeChild(Rectangle* childToRemove)
 		{
 			// If it does, unset its parent reference,
 			derivedChildren[i]->parent = NULL;
+			derivedChildren[i]->transformUpdated = true;
+			derivedChildren[i]->markDirty();
 
 			// remove it,
 			children.erase(children.begin() + i);
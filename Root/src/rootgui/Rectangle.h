@@ -46,8 +46,11 @@ namespace RootGUIComponent
 
 		~Rectangle();
 
-		// Render this GUI rectangle
-		void render(unsigned int guiShader, unsigned int textShader);
+		/**
+		 * Get whether this rectangle looks different than when it was last added to the GUI batch,
+		 * which is also the case while it transitions between interaction states.
+		 */
+		bool isDirty() override;
 
 		/**
 		 * Set the color of the rectangle.
@@ -214,6 +217,14 @@ namespace RootGUIComponent
 
 		void updateTransformMatrices() override;
 
+		void appendVertices(GUIBatch& batch) override;
+
+		/**
+		 * Get the transform from the unit quad to the screen,
+		 * including the size and the scale from interaction.
+		 */
+		glm::mat4 getQuadMatrix();
+
 		/*
 		// The transform matrix is for transforming a point from screen space to local space
 		glm::mat4& getTransformMatrix();
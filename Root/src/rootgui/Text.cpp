@@ -24,31 +24,37 @@ RootGUIComponent::Text::~Text()
 void RootGUIComponent::Text::setTextColor(glm::vec4 color)
 {
     this->textColor = color;
+    markDirty();
 }
 
 void RootGUIComponent::Text::setTextColor(glm::vec3 color)
 {
     this->textColor = glm::vec4(color, 1.0f);
+    markDirty();
 }
 
 void RootGUIComponent::Text::setTextColorOnHover(glm::vec4 color)
 {
     textColorDifferenceOnInteract.addValue(InteractionStatus::Hovered, color);
+    markDirty();
 }
 
 void RootGUIComponent::Text::setTextColorOnHover(glm::vec3 color)
 {
     textColorDifferenceOnInteract.addValue(InteractionStatus::Hovered, glm::vec4(color, 1.0f));
+    markDirty();
 }
 
 void RootGUIComponent::Text::setTextColorOnPress(glm::vec4 color)
 {
     textColorDifferenceOnInteract.addValue(InteractionStatus::Pressed, color);
+    markDirty();
 }
 
 void RootGUIComponent::Text::setTextColorOnPress(glm::vec3 color)
 {
     textColorDifferenceOnInteract.addValue(InteractionStatus::Pressed, glm::vec4(color, 1.0f));
+    markDirty();
 }
 
 void RootGUIComponent::Text::setTransitionDuration(float transitionDuration)
@@ -61,22 +67,18 @@ void RootGUIComponent::Text::setTransitionDuration(float transitionDuration)
 void RootGUIComponent::Text::setTextPadding(glm::vec2 padding)
 {
     this->padding = padding;
-    updateVAO(text);
+    updateGlyphVertices();
 }
 
-void RootGUIComponent::Text::render(unsigned int guiShader, unsigned int textShader)
+bool RootGUIComponent::Text::isDirty()
 {
-    RootGUIComponent::Rectangle::render(guiShader, textShader);
-
-    unsigned int shader{ RootGUIInternal::getTextShader() };
-
-    glm::vec2 scaleDifferenceByInteract{ scaleDifferenceOnInteract.sample() };
-    glm::vec4 textColorDifferenceByInteract{ textColorDifferenceOnInteract.sample() };
-
-    glUseProgram(shader);
+    return RootGUIComponent::Rectangle::isDirty()
+        || textColorDifferenceOnInteract.isTransitioning();
+}
 
-    glUniform2f(glGetUniformLocation(shader, "additionalScale"),
-        scaleDifferenceByInteract.x, scaleDifferenceByInteract.y);
+void RootGUIComponent::Text::appendVertices(GUIBatch& batch)
+{
+    RootGUIComponent::Rectangle::appendVertices(batch);
 
     Font* font{ TextEngine::getFont(fontTag) };
     if (font == nullptr)
@@ -85,62 +87,13 @@ void RootGUIComponent::Text::render(unsigned int guiShader, unsigned int textSha
         return;
     }
 
-    glm::vec4 textColorUsing{ textColor * textColorDifferenceByInteract };
-
-    glUniform1i(glGetUniformLocation(shader, "text"), 0);
-    glUniform4f(glGetUniformLocation(shader, "textColor"), 
-        textColorUsing.r, textColorUsing.g, textColorUsing.b, textColorUsing.a);
-
-    // Setting the transform matrix
-    glUniformMatrix4fv(glGetUniformLocation(shader, "transform"),
-        1, GL_FALSE,
-        glm::value_ptr(getModelMatrixWithoutScale()));
-
-    // Binding the texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, font->textureID);
-
-    // Binding the vertex data
-    glBindVertexArray(textVAO);
-
-    glDrawArrays(GL_TRIANGLES, 0, 6 * text.length());
-
-    glBindVertexArray(0);
-
-    renderDebugView();
-}
-
-void RootGUIComponent::Text::renderDebugView()
-{
-    if (!RootGUIInternal::isInDebugMode())
-        return;
-
-    // Switching to wireframe mode
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
-    unsigned int shader{ RootGUIInternal::getTextDebugShader() };
-
     glm::vec2 scaleDifferenceByInteract{ scaleDifferenceOnInteract.sample() };
+    glm::vec4 textColorDifferenceByInteract{ textColorDifferenceOnInteract.sample() };
 
-    glUseProgram(shader);
-
-    glUniform2f(glGetUniformLocation(shader, "additionalScale"),
-        scaleDifferenceByInteract.x, scaleDifferenceByInteract.y);
-
-    // Setting the transform matrix
-    glUniformMatrix4fv(glGetUniformLocation(shader, "transform"),
-        1, GL_FALSE,
-        glm::value_ptr(getModelMatrixWithoutScale()));
-
-    // Binding the vertex data
-    glBindVertexArray(textVAO);
-
-    glDrawArrays(GL_TRIANGLES, 0, 6 * text.length());
-
-    glBindVertexArray(0);
+    glm::mat4 glyphTransform{ glm::scale(getModelMatrixWithoutScale(),
+        glm::vec3(scaleDifferenceByInteract, 1.0f)) };
 
-    // Switching back to regular render mode
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    batch.addGlyphs(glyphTransform, glyphVertices, textColor * textColorDifferenceByInteract, font->textureID);
 }
 
 void RootGUIComponent::Text::setInteractionStatus(InteractionStatus status)
@@ -153,13 +106,13 @@ void RootGUIComponent::Text::setInteractionStatus(InteractionStatus status)
 void RootGUIComponent::Text::setCenterVertically(bool centerVertically)
 {
     this->centerVertically = centerVertically;
-    updateVAO(text);
+    updateGlyphVertices();
 }
 
 void RootGUIComponent::Text::setCenterHorizontally(bool centerHorizontally)
 {
     this->centerHorizontally = centerHorizontally;
-    updateVAO(text);
+    updateGlyphVertices();
 }
 
 RootGUIComponent::Text::Text(
@@ -174,7 +127,7 @@ RootGUIComponent::Text::Text(
     , fontTag(fontTag)
     , textSize(textSize)
 {
-    updateVAO(this->text);
+    updateGlyphVertices();
     textColorDifferenceOnInteract.addValue(InteractionStatus::None, glm::vec4(1.0f));
 }
 
@@ -242,7 +195,7 @@ void RootGUIComponent::Text::centerLine(
         } while (ci != firstCharacterOfCurrentLine && ci != &text[0]);
 }
 
-void RootGUIComponent::Text::updateVAO(const std::string& text)
+void RootGUIComponent::Text::updateGlyphVertices()
 {
     float wrapWidth{ size.x - padding.x * 2 };
 
@@ -253,9 +206,11 @@ void RootGUIComponent::Text::updateVAO(const std::string& text)
         return;
     }
 
-    // Buffer with space for:
+    // Space for:
     // 6 vertices per character, each with 2 floats for pos, 2 floats for uv.
-    float* vertexData = (float*)malloc(text.length() * 6 * 2 * 2 * sizeof(float));
+    // Characters that fail to load keep zeroes, so they are not drawn.
+    glyphVertices.assign(text.length() * 6 * 2 * 2, 0.0f);
+    float* vertexData = glyphVertices.data();
 
     // The number of indices to offset to the next character:
     // 6 vertices, each with 2 times 2 floats (pos, uv)
@@ -416,32 +371,6 @@ void RootGUIComponent::Text::updateVAO(const std::string& text)
         }
     }
 
-    // Putting the vertex data into a vertex buffer
-
-    unsigned int VBO;
-
-    // Generating the required objects
-    glGenVertexArrays(1, &textVAO);
-    glGenBuffers(1, &VBO);
-
-    // Making sure everything gets put on this specific VAO
-    glBindVertexArray(textVAO);
-
-    // Binding the buffers
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    // Putting the vertices into the buffer
-    glBufferData(GL_ARRAY_BUFFER, text.length() * 6 * 2 * 2 * sizeof(float), vertexData, GL_STATIC_DRAW);
-
-    // Letting OpenGL know how to interpret the data:
-    // 2 floats for position
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // 2 floats for uv
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Unbinding
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    // The GUI batch has to be made again with the new glyphs
+    markDirty();
 }
@@ -77,8 +77,7 @@ namespace RootGUIComponent
 		 */
 		void setTextColorOnPress(glm::vec3 color);
 
-		// Render this GUI text
-		void render(unsigned int guiShader, unsigned int textShader);
+		bool isDirty() override;
 
 		/**
 		 * Set whether to center this text vertically.
@@ -118,7 +117,12 @@ namespace RootGUIComponent
 			glm::vec2 size,
 			float rotation);
 
-		void updateVAO(const std::string& text);
+		void appendVertices(GUIBatch& batch) override;
+
+		/**
+		 * Lay out the glyphs of the text in the rectangle.
+		 */
+		void updateGlyphVertices();
 
 		float getWordLength(const char* c, Font* font);
 
@@ -132,8 +136,6 @@ namespace RootGUIComponent
 			unsigned int indexOffsetPerCharacter,
 			const char* begin);
 
-		void renderDebugView();
-
 		void setInteractionStatus(InteractionStatus status) override;
 
 		std::string text;
@@ -148,7 +150,8 @@ namespace RootGUIComponent
 
 		glm::vec4 textColor{ glm::vec4(1.0f) };
 
-		unsigned int textVAO;
+		// 6 vertices per character, each with 2 floats for the position and 2 for the uv
+		std::vector<float> glyphVertices;
 
 		InterpolatedValue<InteractionStatus, glm::vec4> textColorDifferenceOnInteract{ 0.2f };
 	};
@@ -0,0 +1,178 @@
+#include "GUIBatch.h"
+
+#include <cstddef>
+
+void GUIBatch::terminate()
+{
+	if (VAO != 0)
+	{
+		glDeleteVertexArrays(1, &VAO);
+		glDeleteBuffers(1, &VBO);
+	}
+
+	VAO = 0;
+	VBO = 0;
+	capacity = 0;
+	uploadedVertexCount = 0;
+}
+
+void GUIBatch::clear()
+{
+	vertices.clear();
+	drawCalls.clear();
+}
+
+void GUIBatch::addQuad(const glm::mat4& transform, glm::vec4 color)
+{
+	useTexture(0);
+	addTexturedQuad(transform, color, GUIVertexMode::Solid);
+}
+
+void GUIBatch::addImage(const glm::mat4& transform, glm::vec4 color, unsigned int textureID)
+{
+	useTexture(textureID);
+	addTexturedQuad(transform, color, GUIVertexMode::Image);
+}
+
+void GUIBatch::addGlyphs(const glm::mat4& transform,
+	const std::vector<float>& glyphVertices,
+	glm::vec4 color,
+	unsigned int textureID)
+{
+	useTexture(textureID);
+
+	// 2 floats for the position and 2 for the uv per vertex
+	for (std::size_t i{ 0 }; i + 3 < glyphVertices.size(); i += 4)
+	{
+		addVertex(transform,
+			glm::vec2(glyphVertices[i], glyphVertices[i + 1]),
+			glm::vec2(glyphVertices[i + 2], glyphVertices[i + 3]),
+			color,
+			GUIVertexMode::Glyph);
+	}
+}
+
+void GUIBatch::addVertex(const glm::mat4& transform, glm::vec2 position, glm::vec2 uv, glm::vec4 color, GUIVertexMode mode)
+{
+	glm::vec4 screenPosition{ transform * glm::vec4(position, 0.0f, 1.0f) };
+
+	vertices.push_back(GUIVertex{ glm::vec2(screenPosition), uv, color, (int)mode });
+	drawCalls.back().count++;
+}
+
+void GUIBatch::addTexturedQuad(const glm::mat4& transform, glm::vec4 color, GUIVertexMode mode)
+{
+	float s{ 0.5f };
+
+	// The same triangles as the quad VAO, with the uv following the position
+	glm::vec2 corners[] = {
+		glm::vec2(s, -s), glm::vec2(-s, -s), glm::vec2(-s, s),
+		glm::vec2(s, -s), glm::vec2(-s, s), glm::vec2(s, s)
+	};
+
+	for (const glm::vec2& corner : corners)
+	{
+		addVertex(transform, corner, corner + glm::vec2(0.5f), color, mode);
+	}
+}
+
+void GUIBatch::useTexture(unsigned int textureID)
+{
+	// Vertices without a texture fit in any draw call
+	if (!drawCalls.empty() && (textureID == 0 || drawCalls.back().textureID == textureID))
+		return;
+
+	// The first texture in a draw call can be bound for it
+	if (!drawCalls.empty() && drawCalls.back().textureID == 0)
+	{
+		drawCalls.back().textureID = textureID;
+		return;
+	}
+
+	drawCalls.push_back(DrawCall{ textureID, (unsigned int)vertices.size(), 0 });
+}
+
+void GUIBatch::upload()
+{
+	if (VAO == 0)
+	{
+		glGenVertexArrays(1, &VAO);
+		glGenBuffers(1, &VBO);
+
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+		// Letting OpenGL know how to interpret the data:
+		// 2 floats for position
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(GUIVertex), (void*)offsetof(GUIVertex, position));
+		glEnableVertexAttribArray(0);
+		// 2 floats for uv
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GUIVertex), (void*)offsetof(GUIVertex, uv));
+		glEnableVertexAttribArray(1);
+		// 4 floats for color
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(GUIVertex), (void*)offsetof(GUIVertex, color));
+		glEnableVertexAttribArray(2);
+		// 1 int for the mode
+		glVertexAttribIPointer(3, 1, GL_INT, sizeof(GUIVertex), (void*)offsetof(GUIVertex, mode));
+		glEnableVertexAttribArray(3);
+
+		glBindVertexArray(0);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+	if (vertices.size() > capacity)
+	{
+		// Growing the buffer with some room to spare, so that a growing GUI does not reallocate every time
+		capacity = (unsigned int)vertices.size() * 3 / 2;
+		glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(GUIVertex), nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	if (!vertices.empty())
+		glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(GUIVertex), vertices.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	uploadedVertexCount = (unsigned int)vertices.size();
+}
+
+void GUIBatch::draw(unsigned int shader)
+{
+	if (uploadedVertexCount == 0)
+		return;
+
+	glUseProgram(shader);
+
+	glActiveTexture(GL_TEXTURE0);
+
+	glBindVertexArray(VAO);
+
+	for (const DrawCall& drawCall : drawCalls)
+	{
+		if (drawCall.count == 0)
+			continue;
+
+		glBindTexture(GL_TEXTURE_2D, drawCall.textureID);
+		glDrawArrays(GL_TRIANGLES, drawCall.first, drawCall.count);
+	}
+
+	glBindVertexArray(0);
+}
+
+unsigned int GUIBatch::getDrawCallCount()
+{
+	unsigned int count{ 0 };
+
+	for (const DrawCall& drawCall : drawCalls)
+	{
+		if (drawCall.count > 0)
+			count++;
+	}
+
+	return count;
+}
+
+unsigned int GUIBatch::getVertexCount()
+{
+	return uploadedVertexCount;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <vector>
+
+// How the fragment shader colours a GUI vertex
+enum class GUIVertexMode : int
+{
+	Solid = 0, // Only the vertex color
+	Glyph = 1, // The vertex color, with the red channel of the texture as alpha
+	Image = 2 // The texture multiplied by the vertex color
+};
+
+struct GUIVertex
+{
+	glm::vec2 position; // Screen position
+	glm::vec2 uv;
+	glm::vec4 color;
+	int mode; // A GUIVertexMode
+};
+
+/**
+ * All of the GUI as one stream of vertices, made again only when an item changed.
+ *
+ * Solid quads need no texture, so they never split the stream.
+ * The stream is only split into separate draw calls where the texture changes,
+ * so a GUI made of rectangles and text in one font is drawn in a single call.
+ */
+class GUIBatch
+{
+public:
+
+	/**
+	 * Delete the vertex buffer. Must be called while the OpenGL context still exists.
+	 */
+	void terminate();
+
+	/**
+	 * Remove all vertices, before the items are added again.
+	 */
+	void clear();
+
+	/**
+	 * Add a quad with a single color.
+	 *
+	 * \param transform: the transform from the unit quad around the origin to the screen.
+	 * \param color: the color of the quad.
+	 */
+	void addQuad(const glm::mat4& transform, glm::vec4 color);
+
+	/**
+	 * Add a quad showing a texture.
+	 *
+	 * \param transform: the transform from the unit quad around the origin to the screen.
+	 * \param color: the color to multiply the texture with.
+	 * \param textureID: the texture to show.
+	 */
+	void addImage(const glm::mat4& transform, glm::vec4 color, unsigned int textureID);
+
+	/**
+	 * Add the glyphs of a text.
+	 *
+	 * \param transform: the transform from the glyph positions to the screen.
+	 * \param glyphVertices: 6 vertices per glyph, each with 2 floats for the position and 2 for the uv.
+	 * \param color: the text color.
+	 * \param textureID: the texture atlas of the font.
+	 */
+	void addGlyphs(const glm::mat4& transform,
+		const std::vector<float>& glyphVertices,
+		glm::vec4 color,
+		unsigned int textureID);
+
+	/**
+	 * Put the vertices into the vertex buffer.
+	 */
+	void upload();
+
+	/**
+	 * Draw the uploaded vertices, one draw call per texture change.
+	 *
+	 * \param shader: the shader to draw with.
+	 */
+	void draw(unsigned int shader);
+
+	/**
+	 * Get the number of draw calls that draw() makes.
+	 */
+	unsigned int getDrawCallCount();
+
+	unsigned int getVertexCount();
+
+private:
+
+	// A range of vertices which can be drawn with one texture bound
+	struct DrawCall
+	{
+		unsigned int textureID;
+		unsigned int first;
+		unsigned int count;
+	};
+
+	void addVertex(const glm::mat4& transform, glm::vec2 position, glm::vec2 uv, glm::vec4 color, GUIVertexMode mode);
+
+	void addTexturedQuad(const glm::mat4& transform, glm::vec4 color, GUIVertexMode mode);
+
+	/**
+	 * Make sure the next vertices end up in a draw call that can use a texture.
+	 *
+	 * \param textureID: the texture, or 0 if the vertices do not use one.
+	 */
+	void useTexture(unsigned int textureID);
+
+	std::vector<GUIVertex> vertices;
+	std::vector<DrawCall> drawCalls;
+
+	unsigned int VAO{ 0 };
+	unsigned int VBO{ 0 };
+	// The number of vertices that fit in the vertex buffer
+	unsigned int capacity{ 0 };
+	unsigned int uploadedVertexCount{ 0 };
+};
@@ -1,5 +1,8 @@
 #include "RootGUIInternal.h"
 
+#include <simpleprofiler/GPUProfileZone.h>
+#include <simpleprofiler/Profiler.h>
+
 namespace RootGUIInternal
 {
     namespace
@@ -9,9 +12,13 @@ namespace RootGUIInternal
         glm::mat4 projectionMatrix;
 
         unsigned int guiShader{ 0 };
-        unsigned int textShader{ 0 };
         unsigned int textDebugShader{ 0 };
 
+        // All items in the render queue as one stream of vertices
+        GUIBatch batch;
+        // Whether the batch has to be made again, even if no item is dirty
+        bool batchDirty{ true };
+
         unsigned int windowWidthUsing{ 0 };
         unsigned int windowHeightUsing{ 0 };
 
@@ -20,230 +27,133 @@ namespace RootGUIInternal
         unsigned int quadEBO{ 0 };
         bool inDebugMode;
 
-        void createShaderPrograms()
+        // Compile and link a shader program, printing any errors under the given name
+        unsigned int createShaderProgram(const char* name, const char* vertexShaderCode, const char* fragmentShaderCode)
         {
-            /* GUI SHADER */
-
-            const char* guiVertexShaderCode{
-                "#version 460 core\n"
-                "layout(location = 0) in vec2 vertexPos;\n"
-                "out vec2 TexCoords;\n"
-                "\n"
-                "uniform mat4 transform;\n"
-                "uniform vec2 size;\n"
-                "uniform vec2 additionalScale;\n"
-                "\n"
-                "void main()\n"
-                "{\n"
-                "    vec2 relativePos = (transform * vec4(vertexPos * size * additionalScale, 0.0f, 1.0f)).xy;\n"
-                "    gl_Position = vec4(relativePos, 0.0, 1.0);\n"
-                "    TexCoords = vertexPos + vec2(0.5);\n"
-                "}\0"
-            };
-            const char* guiFragmentShaderCode{
-                "#version 460 core\n"
-                "in vec2 TexCoords;\n"
-                "out vec4 FragColor;\n"
-                "\n"
-                "uniform sampler2D textureSampler;\n"
-                "uniform vec4 baseColor;\n"
-                "uniform bool useTexture;\n"
-                "\n"
-                "void main()\n"
-                "{\n"
-                "    if (useTexture) {\n"
-                "       // Texture to be implemented\n"
-                "       FragColor = texture(textureSampler, TexCoords);\n"
-                "    }\n"
-                "    else {\n"
-                "       FragColor = baseColor;\n"
-                "    }\n"
-                "}\0"
-            };
-
-            unsigned int guiVertex, guiFragment;
-            guiVertex = glCreateShader(GL_VERTEX_SHADER);
-            glShaderSource(guiVertex, 1, &guiVertexShaderCode, NULL);
-            glCompileShader(guiVertex);
-
             int success;
             char infoLog[512];
-            glGetShaderiv(guiVertex, GL_COMPILE_STATUS, &success);
+
+            unsigned int vertex, fragment;
+            vertex = glCreateShader(GL_VERTEX_SHADER);
+            glShaderSource(vertex, 1, &vertexShaderCode, NULL);
+            glCompileShader(vertex);
+
+            // Vertex shader compilation error check
+            glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
             if (!success)
             {
-                glGetShaderInfoLog(guiVertex, 512, NULL, infoLog);
-                std::cout << "Internal vertex shader compilation failed: " << infoLog << std::endl;
+                glGetShaderInfoLog(vertex, 512, NULL, infoLog);
+                std::cout << "Internal " << name << " vertex shader compilation failed: " << infoLog << std::endl;
             }
 
-
-            guiFragment = glCreateShader(GL_FRAGMENT_SHADER);
-            glShaderSource(guiFragment, 1, &guiFragmentShaderCode, NULL);
-            glCompileShader(guiFragment);
+            fragment = glCreateShader(GL_FRAGMENT_SHADER);
+            glShaderSource(fragment, 1, &fragmentShaderCode, NULL);
+            glCompileShader(fragment);
 
             // Fragment shader compilation error check
-            glGetShaderiv(guiFragment, GL_COMPILE_STATUS, &success);
+            glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
             if (!success)
             {
-                glGetShaderInfoLog(guiFragment, 512, NULL, infoLog);
-                std::cout << "Internal fragment shader compilation failed: " << infoLog << std::endl;
+                glGetShaderInfoLog(fragment, 512, NULL, infoLog);
+                std::cout << "Internal " << name << " fragment shader compilation failed: " << infoLog << std::endl;
             }
 
             /* Creating the shader program */
-            guiShader = glCreateProgram();
-            glAttachShader(guiShader, guiVertex);
-            glAttachShader(guiShader, guiFragment);
+            unsigned int program = glCreateProgram();
+            glAttachShader(program, vertex);
+            glAttachShader(program, fragment);
 
-            glLinkProgram(guiShader);
+            glLinkProgram(program);
 
-            glGetProgramiv(guiShader, GL_LINK_STATUS, &success);
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
             if (!success)
             {
                 // Getting the error log
-                glGetProgramInfoLog(guiShader, 512, NULL, infoLog);
+                glGetProgramInfoLog(program, 512, NULL, infoLog);
 
                 // Printing the error log
-                std::cout << "Internal shader linking failed: " << infoLog << std::endl;
-                return;
+                std::cout << "Internal " << name << " shader linking failed: " << infoLog << std::endl;
             }
 
             // Deleting the shaders as they're linked into our program now and no longer necessary
-            glDeleteShader(guiVertex);
-            glDeleteShader(guiFragment);
-
+            glDeleteShader(vertex);
+            glDeleteShader(fragment);
 
+            return program;
+        }
 
-            /* TEXT SHADER */
+        void createShaderPrograms()
+        {
+            /* GUI SHADER */
 
-            const char* textVertexShaderCode{
+            // The vertices of the GUI batch are already in screen space
+            const char* guiVertexShaderCode{
                 "#version 460 core\n"
                 "layout(location = 0) in vec2 pos;\n"
                 "layout(location = 1) in vec2 uv;\n"
+                "layout(location = 2) in vec4 color;\n"
+                "layout(location = 3) in int mode;\n"
                 "\n"
                 "out vec2 TexCoords;\n"
-                "\n"
-                "uniform mat4 transform;\n"
-                "uniform vec2 additionalScale;\n"
+                "out vec4 Color;\n"
+                "flat out int Mode;\n"
                 "\n"
                 "void main()\n"
                 "{\n"
-                "    vec2 relativePos = (transform * vec4(pos * additionalScale, 0.0f, 1.0f)).xy;\n"
-                "    gl_Position = vec4(relativePos, 0.0, 1.0);\n"
+                "    gl_Position = vec4(pos, 0.0, 1.0);\n"
                 "    TexCoords = uv;\n"
+                "    Color = color;\n"
+                "    Mode = mode;\n"
                 "}\0"
             };
-            const char* textFragmentShaderCode{
+            // Modes: 0 = solid color, 1 = glyph (red channel is the alpha), 2 = image
+            const char* guiFragmentShaderCode{
                 "#version 460 core\n"
                 "in vec2 TexCoords;\n"
-                "out vec4 color;\n"
+                "in vec4 Color;\n"
+                "flat in int Mode;\n"
+                "out vec4 FragColor;\n"
                 "\n"
-                "uniform sampler2D text;\n"
-                "uniform vec4 textColor;\n"
+                "uniform sampler2D textureSampler;\n"
                 "\n"
                 "void main()\n"
                 "{\n"
-                "    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);\n"
-                "    color = textColor * sampled;\n"
+                "    if (Mode == 1) {\n"
+                "        FragColor = Color * vec4(1.0, 1.0, 1.0, texture(textureSampler, TexCoords).r);\n"
+                "    }\n"
+                "    else if (Mode == 2) {\n"
+                "        FragColor = Color * texture(textureSampler, TexCoords);\n"
+                "    }\n"
+                "    else {\n"
+                "        FragColor = Color;\n"
+                "    }\n"
                 "}\0"
             };
 
-            unsigned int textVertex, textFragment;
-            textVertex = glCreateShader(GL_VERTEX_SHADER);
-            glShaderSource(textVertex, 1, &textVertexShaderCode, NULL);
-            glCompileShader(textVertex);
-
-            // Vertex shader compilation error check
-            glGetShaderiv(textVertex, GL_COMPILE_STATUS, &success);
-            if (!success)
-            {
-                glGetShaderInfoLog(textVertex, 512, NULL, infoLog);
-                std::cout << "Internal text vertex shader compilation failed: " << infoLog << std::endl;
-            }
-
-            textFragment = glCreateShader(GL_FRAGMENT_SHADER);
-            glShaderSource(textFragment, 1, &textFragmentShaderCode, NULL);
-            glCompileShader(textFragment);
-
-            // Fragment shader compilation error check
-            glGetShaderiv(textFragment, GL_COMPILE_STATUS, &success);
-            if (!success)
-            {
-                glGetShaderInfoLog(textFragment, 512, NULL, infoLog);
-                std::cout << "Internal text fragment shader compilation failed: " << infoLog << std::endl;
-            }
-
-            /* Creating the shader program */
-            textShader = glCreateProgram();
-            glAttachShader(textShader, textVertex);
-            glAttachShader(textShader, textFragment);
-
-            glLinkProgram(textShader);
+            guiShader = createShaderProgram("GUI", guiVertexShaderCode, guiFragmentShaderCode);
 
-            // Deleting the shaders as they're linked into our program now and no longer necessary
-            glDeleteShader(textVertex);
-            glDeleteShader(textFragment);
+            glUseProgram(guiShader);
+            glUniform1i(glGetUniformLocation(guiShader, "textureSampler"), 0);
+            glUseProgram(0);
 
 
             /* TEXT DEBUG SHADER */
 
-            const char* textDebugVertexShaderCode{
-                "#version 460 core\n"
-                "layout(location = 0) in vec2 pos;\n"
-                "layout(location = 1) in vec2 uv;\n"
-                "\n"
-                "uniform mat4 transform;\n"
-                "uniform vec2 additionalScale;\n"
-                "\n"
-                "void main()\n"
-                "{\n"
-                "    vec2 relativePos = (transform * vec4(pos * additionalScale, 0.0f, 1.0f)).xy;\n"
-                "    gl_Position = vec4(relativePos, 0.0, 1.0);\n"
-                "}\0"
-            };
+            // Draws the outlines of the glyphs in the GUI batch, and nothing else
             const char* textDebugFragmentShaderCode{
                 "#version 460 core\n"
+                "flat in int Mode;\n"
                 "out vec4 color;\n"
                 "\n"
                 "void main()\n"
                 "{\n"
+                "    if (Mode != 1)\n"
+                "        discard;\n"
                 "    color = vec4(0.0, 1.0, 0.0, 1.0);\n"
                 "}\0"
             };
 
-            unsigned int textDebugVertex, textDebugFragment;
-            textDebugVertex = glCreateShader(GL_VERTEX_SHADER);
-            glShaderSource(textDebugVertex, 1, &textDebugVertexShaderCode, NULL);
-            glCompileShader(textDebugVertex);
-
-            // Vertex shader compilation error check
-            glGetShaderiv(textDebugVertex, GL_COMPILE_STATUS, &success);
-            if (!success)
-            {
-                glGetShaderInfoLog(textDebugVertex, 512, NULL, infoLog);
-                std::cout << "Internal text debug vertex shader compilation failed: " << infoLog << std::endl;
-            }
-
-            textDebugFragment = glCreateShader(GL_FRAGMENT_SHADER);
-            glShaderSource(textDebugFragment, 1, &textDebugFragmentShaderCode, NULL);
-            glCompileShader(textDebugFragment);
-
-            // Fragment shader compilation error check
-            glGetShaderiv(textDebugFragment, GL_COMPILE_STATUS, &success);
-            if (!success)
-            {
-                glGetShaderInfoLog(textDebugFragment, 512, NULL, infoLog);
-                std::cout << "Internal text debug fragment shader compilation failed: " << infoLog << std::endl;
-            }
-
-            /* Creating the shader program */
-            textDebugShader = glCreateProgram();
-            glAttachShader(textDebugShader, textDebugVertex);
-            glAttachShader(textDebugShader, textDebugFragment);
-
-            glLinkProgram(textDebugShader);
-
-            // Deleting the shaders as they're linked into our program now and no longer necessary
-            glDeleteShader(textDebugVertex);
-            glDeleteShader(textDebugFragment);
+            textDebugShader = createShaderProgram("text debug", guiVertexShaderCode, textDebugFragmentShaderCode);
         }
     }
 
@@ -305,6 +215,8 @@ namespace RootGUIInternal
 
         renderQueue.clear();
 
+        batch.terminate();
+
         TextEngine::terminate();
 
         std::cout << "RootGUI terminated." << std::endl;
@@ -320,23 +232,46 @@ namespace RootGUIInternal
 
     void render()
     {
+        PROFILE_GPU_ZONE("GUI render");
+
         // Draw GUI on top of everything
         glDisable(GL_DEPTH_TEST);
 
-        for (std::shared_ptr<RootGUIComponent::Item>& item : renderQueue)
+        // Only making the vertices again if any item changed
+        bool rebuild{ batchDirty };
+        for (unsigned int i{ 0 }; i < renderQueue.size() && !rebuild; i++)
         {
-            item->render(guiShader, textShader);
+            rebuild = renderQueue[i]->isDirty();
         }
-    }
 
-    unsigned int getTextShader()
-    {
-        return textShader;
-    }
+        if (rebuild)
+        {
+            batch.clear();
 
-    unsigned int getTextDebugShader()
-    {
-        return textDebugShader;
+            for (std::shared_ptr<RootGUIComponent::Item>& item : renderQueue)
+            {
+                item->addToBatch(batch);
+            }
+
+            batch.upload();
+            batchDirty = false;
+        }
+
+        batch.draw(guiShader);
+
+        if (inDebugMode)
+        {
+            // Switching to wireframe mode
+            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+
+            batch.draw(textDebugShader);
+
+            // Switching back to regular render mode
+            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        }
+
+        Profiler::setCounter("GUI vertices", batch.getVertexCount());
+        Profiler::setCounter("GUI draw calls", batch.getDrawCallCount());
     }
 
     unsigned int getQuadVAO()
@@ -352,6 +287,7 @@ namespace RootGUIInternal
     void addItemToRenderQueue(std::shared_ptr<RootGUIComponent::Item> item)
     {
         renderQueue.push_back(item);
+        batchDirty = true;
     }
 
     void setWindowSize(unsigned int windowWidth, unsigned int windowHeight)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <rootgui/internal/TextEngine.h>
+#include <rootgui/internal/GUIBatch.h>
 #include "rootgui/Item.h"
 #include "rootgui/Rectangle.h"
 #include "rootgui/Image.h"
@@ -25,10 +26,6 @@ namespace RootGUIInternal
 	void render();
 
 
-	unsigned int getTextShader();
-
-	unsigned int getTextDebugShader();
-
 	/**
 	 * Get the index of a Vertex Array Object which defines a quad.
 	 *
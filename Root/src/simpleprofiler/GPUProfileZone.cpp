@@ -0,0 +1,157 @@
+#include "GPUProfileZone.h"
+
+#include "Profiler.h"
+
+#include <glad/glad.h>
+
+namespace Profiler
+{
+	namespace
+	{
+#if ROOT_PROFILING_ENABLED
+		// The number of frames a query may take before it is read back.
+		// The GPU is usually one or two frames behind, so this is enough to never wait for it.
+		const unsigned int queryFrameCount{ 4 };
+
+		struct GPUZone
+		{
+			const char* name;
+			std::uint32_t depth;
+			GLuint startQuery;
+			GLuint endQuery;
+		};
+
+		/**
+		 * The zones of one frame. The queries are kept when the frame is reused, so they are only created once.
+		 */
+		struct GPUFrame
+		{
+			std::vector<GPUZone> zones;
+			std::vector<GLuint> queries;
+			// The query that was issued last, which the GPU finishes last
+			GLuint lastQuery{ 0 };
+		};
+
+		GPUFrame frames[queryFrameCount];
+		unsigned int currentFrame{ 0 };
+
+		std::uint32_t gpuZoneDepth{ 0 };
+
+		// The profiler clock time minus the GPU clock time, so that GPU zones line up with the CPU zones
+		std::int64_t gpuClockOffset{ 0 };
+		bool gpuClockCalibrated{ false };
+
+		unsigned int droppedFrames{ 0 };
+
+		void calibrateGPUClock()
+		{
+			GLint64 gpuTime;
+			glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+			gpuClockOffset = getTime() - static_cast<std::int64_t>(gpuTime);
+			gpuClockCalibrated = true;
+		}
+
+		GLuint getQuery(GPUFrame& frame, unsigned int index)
+		{
+			if (index >= frame.queries.size())
+			{
+				GLuint query;
+				glGenQueries(1, &query);
+				frame.queries.push_back(query);
+			}
+			return frame.queries[index];
+		}
+
+		void readBackFrame(GPUFrame& frame)
+		{
+			if (frame.zones.empty())
+				return;
+
+			// The queries finish in order, so if the last one is available all of them are
+			GLint available{ GL_FALSE };
+			glGetQueryObjectiv(frame.lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+
+			if (available == GL_TRUE)
+			{
+				for (GPUZone& zone : frame.zones)
+				{
+					GLuint64 start;
+					GLuint64 end;
+					glGetQueryObjectui64v(zone.startQuery, GL_QUERY_RESULT, &start);
+					glGetQueryObjectui64v(zone.endQuery, GL_QUERY_RESULT, &end);
+
+					recordGPUZone(zone.name, zone.depth,
+						static_cast<std::int64_t>(start) + gpuClockOffset,
+						static_cast<std::int64_t>(end) + gpuClockOffset);
+				}
+			}
+			else
+			{
+				droppedFrames++;
+			}
+
+			frame.zones.clear();
+		}
+#endif
+	}
+
+#if ROOT_PROFILING_ENABLED
+	ScopedGPUZone::ScopedGPUZone(const char* name)
+		: zoneIndex(-1)
+	{
+		if (!Profiler::enabled)
+			return;
+
+		if (!gpuClockCalibrated)
+			calibrateGPUClock();
+
+		GPUFrame& frame{ frames[currentFrame] };
+		unsigned int queryIndex{ static_cast<unsigned int>(frame.zones.size()) * 2 };
+
+		zoneIndex = static_cast<int>(frame.zones.size());
+		frame.zones.push_back(GPUZone{ name, gpuZoneDepth, getQuery(frame, queryIndex), getQuery(frame, queryIndex + 1) });
+		gpuZoneDepth++;
+
+		frame.lastQuery = frame.zones.back().startQuery;
+		glQueryCounter(frame.lastQuery, GL_TIMESTAMP);
+	}
+
+	ScopedGPUZone::~ScopedGPUZone()
+	{
+		if (zoneIndex < 0)
+			return;
+
+		gpuZoneDepth--;
+
+		GPUFrame& frame{ frames[currentFrame] };
+		frame.lastQuery = frame.zones[zoneIndex].endQuery;
+		glQueryCounter(frame.lastQuery, GL_TIMESTAMP);
+	}
+#endif
+
+	void endGPUFrame()
+	{
+#if ROOT_PROFILING_ENABLED
+		currentFrame = (currentFrame + 1) % queryFrameCount;
+
+		// The next frame to record is the oldest one, which the GPU has had the most time to finish
+		readBackFrame(frames[currentFrame]);
+
+		Profiler::setCounter("GPU zone frames dropped", droppedFrames);
+#endif
+	}
+
+	void terminateGPUZones()
+	{
+#if ROOT_PROFILING_ENABLED
+		for (GPUFrame& frame : frames)
+		{
+			if (!frame.queries.empty())
+				glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+
+			frame.queries.clear();
+			frame.zones.clear();
+		}
+#endif
+	}
+};
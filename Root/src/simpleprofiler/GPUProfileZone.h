@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ProfileZone.h"
+
+namespace Profiler
+{
+#if ROOT_PROFILING_ENABLED
+	/**
+	 * Measures how long the GPU takes to execute the commands issued between its construction and destruction,
+	 * using OpenGL timestamp queries.
+	 * Use the PROFILE_GPU_ZONE() macro instead of creating these directly.
+	 */
+	class ScopedGPUZone
+	{
+	public:
+		/**
+		 * Start a GPU zone.
+		 *
+		 * \param name: the name of the zone. Must live for the whole program, since only the pointer is stored.
+		 */
+		explicit ScopedGPUZone(const char* name);
+		~ScopedGPUZone();
+
+		ScopedGPUZone(const ScopedGPUZone&) = delete;
+		ScopedGPUZone& operator=(const ScopedGPUZone&) = delete;
+
+	private:
+		// The index of the zone in the current frame, or -1 if it is not measured
+		int zoneIndex;
+	};
+#endif
+
+	/**
+	 * Finish the GPU zones of the current frame, and read back the zones of the oldest frame if the GPU finished them.
+	 * Never waits for the GPU: zones that are still not finished after several frames are dropped.
+	 * Must be called once per frame, from the thread with the OpenGL context.
+	 */
+	void endGPUFrame();
+
+	/**
+	 * Delete the OpenGL queries used for the GPU zones.
+	 * Must be called before the OpenGL context is destroyed.
+	 */
+	void terminateGPUZones();
+};
+
+#if ROOT_PROFILING_ENABLED
+#define PROFILE_GPU_ZONE(name) Profiler::ScopedGPUZone PROFILER_CONCATENATE(profilerGPUZone, __LINE__){ "" name }
+#define PROFILE_END_GPU_FRAME() Profiler::endGPUFrame()
+#else
+#define PROFILE_GPU_ZONE(name)
+#define PROFILE_END_GPU_FRAME()
+#endif
@@ -0,0 +1,307 @@
+#include "ProfileZone.h"
+
+#include "Profiler.h"
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+
+namespace Profiler
+{
+	namespace
+	{
+		std::vector<ZoneStats> zoneStats;
+
+#if ROOT_PROFILING_ENABLED
+		struct ZoneEvent
+		{
+			const char* name;
+			// Nanoseconds since the profiler started
+			std::int64_t start;
+			std::int64_t end;
+			std::uint32_t depth;
+		};
+
+		// The number of zones each thread remembers, must be a power of two
+		const std::uint64_t threadBufferCapacity{ 16384 };
+
+		/**
+		 * The most recent zones of one thread.
+		 * Only the owning thread writes to it, so recording a zone needs no lock.
+		 */
+		struct ThreadBuffer
+		{
+			unsigned int threadIndex;
+			// Whether the zones were measured on the GPU instead of this thread
+			bool gpu{ false };
+			std::vector<ZoneEvent> events;
+			// The total number of zones ever written, the next zone goes at written % capacity
+			std::atomic<std::uint64_t> written{ 0 };
+			// The number of zones already collected by endFrame(), only used by the main thread
+			std::uint64_t collected{ 0 };
+		};
+
+		// Buffers are never removed, so that zones of threads that stopped can still be exported
+		std::mutex threadBuffersMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+		thread_local ThreadBuffer* threadBuffer{ nullptr };
+		ThreadBuffer* gpuBuffer{ nullptr };
+		thread_local std::uint32_t zoneDepth{ 0 };
+
+		const std::chrono::steady_clock::time_point epoch{ std::chrono::steady_clock::now() };
+
+		ThreadBuffer* createThreadBuffer()
+		{
+			std::lock_guard<std::mutex> lock{ threadBuffersMutex };
+
+			threadBuffers.push_back(std::make_unique<ThreadBuffer>());
+			ThreadBuffer* buffer{ threadBuffers.back().get() };
+			buffer->threadIndex = static_cast<unsigned int>(threadBuffers.size() - 1);
+			buffer->events.resize(threadBufferCapacity);
+
+			return buffer;
+		}
+
+		ThreadBuffer& getThreadBuffer()
+		{
+			// Only happens once per thread, so the buffer is allocated outside of any zone
+			if (threadBuffer == nullptr)
+				threadBuffer = createThreadBuffer();
+
+			return *threadBuffer;
+		}
+
+		void writeEvent(ThreadBuffer& buffer, const ZoneEvent& event)
+		{
+			std::uint64_t index{ buffer.written.load(std::memory_order_relaxed) };
+
+			buffer.events[index & (threadBufferCapacity - 1)] = event;
+
+			// Publishing the zone to the main thread
+			buffer.written.store(index + 1, std::memory_order_release);
+		}
+
+		// The number of frames the statistics are over
+		const unsigned int statsWindowSize{ 120 };
+
+		struct ZoneHistory
+		{
+			const char* name;
+			unsigned int depth;
+			bool gpu;
+			// Ring buffer of the time spent in the zone in each frame it was recorded in, in milliseconds
+			std::vector<float> frameTimes;
+			unsigned int nextFrame{ 0 };
+			double currentFrameTime{ 0.0 };
+			bool recordedThisFrame{ false };
+		};
+
+		// Only used by the main thread
+		std::vector<ZoneHistory> zoneHistories;
+		// Kept between frames so that calculating the percentile does not allocate
+		std::vector<float> sortedFrameTimes;
+
+		ZoneHistory& getZoneHistory(const char* name, unsigned int depth, bool gpu)
+		{
+			// Zones are identified by the address of their name, which is a string literal
+			for (ZoneHistory& history : zoneHistories)
+			{
+				if (history.name == name && history.gpu == gpu)
+				{
+					history.depth = std::min(history.depth, depth);
+					return history;
+				}
+			}
+
+			zoneHistories.push_back(ZoneHistory{ name, depth, gpu });
+			zoneHistories.back().frameTimes.reserve(statsWindowSize);
+			return zoneHistories.back();
+		}
+
+		void updateZoneStats()
+		{
+			zoneStats.clear();
+
+			for (ZoneHistory& history : zoneHistories)
+			{
+				if (history.frameTimes.empty())
+					continue;
+
+				sortedFrameTimes.assign(history.frameTimes.begin(), history.frameTimes.end());
+				std::sort(sortedFrameTimes.begin(), sortedFrameTimes.end());
+
+				double total{ 0.0 };
+				for (float frameTime : sortedFrameTimes)
+				{
+					total += frameTime;
+				}
+
+				// The smallest time that at least 99% of the frames stayed under
+				std::size_t percentileIndex{ (sortedFrameTimes.size() * 99 + 99) / 100 - 1 };
+
+				zoneStats.push_back(ZoneStats{
+					history.name,
+					history.depth,
+					history.gpu,
+					static_cast<unsigned int>(sortedFrameTimes.size()),
+					sortedFrameTimes.front(),
+					static_cast<float>(total / sortedFrameTimes.size()),
+					sortedFrameTimes.back(),
+					sortedFrameTimes[percentileIndex] });
+			}
+		}
+
+		void writeEscaped(std::ofstream& file, const char* text)
+		{
+			for (const char* character{ text }; *character != '\0'; character++)
+			{
+				if (*character == '"' || *character == '\\')
+					file << '\\';
+				file << *character;
+			}
+		}
+#endif
+	}
+
+#if ROOT_PROFILING_ENABLED
+	ScopedZone::ScopedZone(const char* name)
+		: name(name)
+	{
+		zoneDepth++;
+		start = getTime();
+	}
+
+	ScopedZone::~ScopedZone()
+	{
+		std::int64_t end{ getTime() };
+		zoneDepth--;
+
+		writeEvent(getThreadBuffer(), ZoneEvent{ name, start, end, zoneDepth });
+	}
+
+	std::int64_t getTime()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+	}
+
+	void recordGPUZone(const char* name, std::uint32_t depth, std::int64_t start, std::int64_t end)
+	{
+		if (gpuBuffer == nullptr)
+		{
+			gpuBuffer = createThreadBuffer();
+			gpuBuffer->gpu = true;
+		}
+
+		writeEvent(*gpuBuffer, ZoneEvent{ name, start, end, depth });
+	}
+#endif
+
+	void endFrame()
+	{
+#if ROOT_PROFILING_ENABLED
+		{
+			std::lock_guard<std::mutex> lock{ threadBuffersMutex };
+
+			for (std::unique_ptr<ThreadBuffer>& buffer : threadBuffers)
+			{
+				std::uint64_t written{ buffer->written.load(std::memory_order_acquire) };
+
+				// Zones that were overwritten before they were collected are lost
+				std::uint64_t first{ std::max(buffer->collected,
+					written > threadBufferCapacity ? written - threadBufferCapacity : 0) };
+
+				for (std::uint64_t i{ first }; i < written; i++)
+				{
+					const ZoneEvent& event{ buffer->events[i & (threadBufferCapacity - 1)] };
+
+					ZoneHistory& history{ getZoneHistory(event.name, event.depth, buffer->gpu) };
+					history.currentFrameTime += (event.end - event.start) / 1000000.0;
+					history.recordedThisFrame = true;
+				}
+
+				buffer->collected = written;
+			}
+		}
+
+		for (ZoneHistory& history : zoneHistories)
+		{
+			// Zones that did not run this frame are left out, so they do not lower the statistics
+			if (!history.recordedThisFrame)
+				continue;
+
+			float frameTime{ static_cast<float>(history.currentFrameTime) };
+
+			if (history.frameTimes.size() < statsWindowSize)
+				history.frameTimes.push_back(frameTime);
+			else
+				history.frameTimes[history.nextFrame] = frameTime;
+
+			history.nextFrame = (history.nextFrame + 1) % statsWindowSize;
+			history.currentFrameTime = 0.0;
+			history.recordedThisFrame = false;
+		}
+
+		// Only updating what is shown as often as the rest of the profiler
+		if (Profiler::enabled && Profiler::timeSinceUpdate == 0)
+			updateZoneStats();
+#endif
+	}
+
+	const std::vector<ZoneStats>& getZoneStats()
+	{
+		return zoneStats;
+	}
+
+	bool writeChromeTrace(const std::string& path)
+	{
+#if ROOT_PROFILING_ENABLED
+		std::ofstream file{ path };
+
+		if (!file.is_open())
+		{
+			std::cerr << "Could not open file " << path << " to write the profiler trace to." << std::endl;
+			return false;
+		}
+
+		file << "{\"traceEvents\":[";
+
+		bool first{ true };
+
+		std::lock_guard<std::mutex> lock{ threadBuffersMutex };
+
+		for (std::unique_ptr<ThreadBuffer>& buffer : threadBuffers)
+		{
+			file << (first ? "\n" : ",\n")
+				<< "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->threadIndex
+				<< ",\"args\":{\"name\":\""
+				<< (buffer->gpu ? std::string{ "GPU" } : "Thread " + std::to_string(buffer->threadIndex)) << "\"}}";
+			first = false;
+
+			std::uint64_t written{ buffer->written.load(std::memory_order_acquire) };
+			std::uint64_t oldest{ written > threadBufferCapacity ? written - threadBufferCapacity : 0 };
+
+			for (std::uint64_t i{ oldest }; i < written; i++)
+			{
+				const ZoneEvent& event{ buffer->events[i & (threadBufferCapacity - 1)] };
+
+				// Complete events, with the times in microseconds
+				file << ",\n{\"name\":\"";
+				writeEscaped(file, event.name);
+				file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadIndex
+					<< ",\"ts\":" << event.start / 1000.0
+					<< ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+			}
+		}
+
+		file << "\n]}\n";
+		return true;
+#else
+		std::cerr << "Cannot write the profiler trace to " << path << "; profiling was compiled out." << std::endl;
+		return false;
+#endif
+	}
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Set to 0 (e.g. in the preprocessor definitions) to compile all profiler zones out
+#ifndef ROOT_PROFILING_ENABLED
+#define ROOT_PROFILING_ENABLED 1
+#endif
+
+namespace Profiler
+{
+	/**
+	 * The time spent in a zone per frame, over the last frames.
+	 */
+	struct ZoneStats
+	{
+		const char* name;
+		// How deep the zone is nested in other zones, 0 for outermost zones
+		unsigned int depth;
+		// Whether the zone was measured on the GPU
+		bool gpu;
+		// The number of frames the statistics are over
+		unsigned int frames;
+		// Times in milliseconds
+		float minimum;
+		float average;
+		float maximum;
+		float percentile99;
+	};
+
+#if ROOT_PROFILING_ENABLED
+	/**
+	 * Measures the time between its construction and destruction.
+	 * Use the PROFILE_ZONE() and PROFILE_FUNCTION() macros instead of creating these directly.
+	 */
+	class ScopedZone
+	{
+	public:
+		/**
+		 * Start a zone.
+		 *
+		 * \param name: the name of the zone. Must live for the whole program, since only the pointer is stored.
+		 */
+		explicit ScopedZone(const char* name);
+		~ScopedZone();
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+
+	private:
+		const char* name;
+		std::int64_t start;
+	};
+
+	/**
+	 * Get the current time of the profiler clock, which all zones are measured in.
+	 *
+	 * \returns the number of nanoseconds since the profiler started.
+	 */
+	std::int64_t getTime();
+
+	/**
+	 * Record a zone that was measured on the GPU.
+	 * Must be called from the main thread.
+	 *
+	 * \param name: the name of the zone. Must live for the whole program, since only the pointer is stored.
+	 * \param depth: how deep the zone is nested in other GPU zones.
+	 * \param start: the start of the zone, in nanoseconds on the profiler clock.
+	 * \param end: the end of the zone, in nanoseconds on the profiler clock.
+	 */
+	void recordGPUZone(const char* name, std::uint32_t depth, std::int64_t start, std::int64_t end);
+#endif
+
+	/**
+	 * Collect the zones that ended since the last call into the statistics of the frame that ended.
+	 * Must be called once per frame, from the main thread, while no other thread is recording zones.
+	 */
+	void endFrame();
+
+	/**
+	 * Get the statistics of every zone, over the last 120 frames.
+	 * Only updated once every framesBetweenUpdates frames, like the rest of the profiler.
+	 *
+	 * \returns the statistics, in the order the zones were first recorded.
+	 */
+	const std::vector<ZoneStats>& getZoneStats();
+
+	/**
+	 * Write the most recent zones of every thread to a file in the Chrome trace event format,
+	 * which can be opened in chrome://tracing or Perfetto.
+	 *
+	 * \param path: the path of the file to write.
+	 * \returns whether the file was written.
+	 */
+	bool writeChromeTrace(const std::string& path);
+};
+
+#define PROFILER_CONCATENATE_INNER(a, b) a##b
+#define PROFILER_CONCATENATE(a, b) PROFILER_CONCATENATE_INNER(a, b)
+
+#if ROOT_PROFILING_ENABLED
+// The empty string in front only compiles for string literals, which live for the whole program
+#define PROFILE_ZONE(name) Profiler::ScopedZone PROFILER_CONCATENATE(profilerZone, __LINE__){ "" name }
+#define PROFILE_FUNCTION() Profiler::ScopedZone PROFILER_CONCATENATE(profilerZone, __LINE__){ __FUNCTION__ }
+#define PROFILE_END_FRAME() Profiler::endFrame()
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_END_FRAME()
+#endif
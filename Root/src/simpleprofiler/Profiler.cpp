@@ -7,6 +7,12 @@ unsigned int Profiler::framesBetweenUpdates{ 10 };
 
 std::vector<Profiler::Checkpoint> Profiler::currentCheckpoints;
 
+std::vector<Profiler::Counter> Profiler::currentCounters;
+
+std::vector<Profiler::Timing> Profiler::currentTimings;
+
+std::vector<Profiler::Graph> Profiler::currentGraphs;
+
 void Profiler::createProfilerWindow()
 {
 	if (!Profiler::enabled)
@@ -31,6 +37,43 @@ void Profiler::createProfilerWindow()
 		ImGui::Text((currentCheckpoints[i].label + ": " + std::to_string(diff.count() * 1000.0f) + "ms").c_str());
 	}
 
+	if (currentCounters.size() >= 1)
+		ImGui::Separator();
+
+	for (Counter& counter : currentCounters)
+	{
+		ImGui::Text((counter.label + ": " + std::to_string(counter.value)).c_str());
+	}
+
+	if (currentTimings.size() >= 1)
+		ImGui::Separator();
+
+	for (Timing& timing : currentTimings)
+	{
+		ImGui::Text((timing.label + ": " + std::to_string(timing.milliseconds) + "ms").c_str());
+	}
+
+	for (Graph& graph : currentGraphs)
+	{
+		ImGui::PlotLines(graph.label.c_str(), graph.values.data(), (int)graph.values.size(),
+			0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+	}
+
+	const std::vector<ZoneStats>& zones{ getZoneStats() };
+
+	if (zones.size() >= 1)
+	{
+		ImGui::Separator();
+		ImGui::Text("Zones (avg / p99 / max)");
+	}
+
+	for (const ZoneStats& zone : zones)
+	{
+		// Indenting nested zones below the zones they run in
+		ImGui::Text("%*s%s%s: %.2f / %.2f / %.2fms", zone.depth * 2, "", zone.gpu ? "[GPU] " : "", zone.name,
+			zone.average, zone.percentile99, zone.maximum);
+	}
+
 	ImGui::End();
 
 	// Rendering
@@ -55,6 +98,69 @@ void Profiler::addCheckpoint(const std::string label)
 	currentCheckpoints.push_back(newCheckpoint);
 }
 
+void Profiler::setCounter(const std::string label, long long value)
+{
+	if (!Profiler::enabled)
+		return;
+
+	if (timeSinceUpdate != 0)
+		return;
+
+	// Overwriting the counter if it was already set this frame
+	for (Counter& counter : currentCounters)
+	{
+		if (counter.label == label)
+		{
+			counter.value = value;
+			return;
+		}
+	}
+
+	currentCounters.push_back(Counter{ label, value });
+}
+
+void Profiler::setTiming(const std::string label, double milliseconds)
+{
+	if (!Profiler::enabled)
+		return;
+
+	if (timeSinceUpdate != 0)
+		return;
+
+	// Overwriting the timing if it was already set this frame
+	for (Timing& timing : currentTimings)
+	{
+		if (timing.label == label)
+		{
+			timing.milliseconds = milliseconds;
+			return;
+		}
+	}
+
+	currentTimings.push_back(Timing{ label, milliseconds });
+}
+
+void Profiler::setGraph(const std::string label, const std::vector<float>& values)
+{
+	if (!Profiler::enabled)
+		return;
+
+	if (timeSinceUpdate != 0)
+		return;
+
+	// Overwriting the graph if it was already set this frame
+	for (Graph& graph : currentGraphs)
+	{
+		if (graph.label == label)
+		{
+			graph.values = values;
+			return;
+		}
+	}
+
+	currentGraphs.push_back(Graph{ label, values });
+}
+
 void Profiler::emptyCheckpointList()
 {
 	if (!Profiler::enabled)
@@ -67,5 +173,8 @@ void Profiler::emptyCheckpointList()
 	}
 
 	currentCheckpoints.clear();
+	currentCounters.clear();
+	currentTimings.clear();
+	currentGraphs.clear();
 	timeSinceUpdate = 0;
 }
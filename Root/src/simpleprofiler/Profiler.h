@@ -5,6 +5,9 @@
 #include <iostream>
 #include <chrono> // Time measurement
 
+#include "ProfileZone.h"
+#include "GPUProfileZone.h"
+
 // ImGui
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw.h"
@@ -31,6 +34,24 @@ namespace Profiler
 		std::string label;
 	};
 
+	struct Counter
+	{
+		std::string label;
+		long long value;
+	};
+
+	struct Timing
+	{
+		std::string label;
+		double milliseconds;
+	};
+
+	struct Graph
+	{
+		std::string label;
+		std::vector<float> values;
+	};
+
 	extern bool enabled;
 
 	extern unsigned int timeSinceUpdate;
@@ -38,6 +59,12 @@ namespace Profiler
 
 	extern std::vector<Checkpoint> currentCheckpoints;
 
+	extern std::vector<Counter> currentCounters;
+
+	extern std::vector<Timing> currentTimings;
+
+	extern std::vector<Graph> currentGraphs;
+
 	// Create w little window displaying the information with ImGui
 	void createProfilerWindow();
 
@@ -47,6 +74,15 @@ namespace Profiler
 	// Add a new checkpoint to the current list
 	void addCheckpoint(const std::string label);
 
+	// Set the value of a counter (e.g. a number of objects processed) for the current frame
+	void setCounter(const std::string label, long long value);
+
+	// Set a time measured outside of the checkpoints (e.g. by a library) for the current frame
+	void setTiming(const std::string label, double milliseconds);
+
+	// Set a history of values to draw as a graph for the current frame, oldest value first
+	void setGraph(const std::string label, const std::vector<float>& values);
+
 	// Empty the current list of checkpoints
 	void emptyCheckpointList();
 };